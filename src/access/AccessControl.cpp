@@ -70,6 +70,46 @@ bool CheckRequestPrivilegeAgainstEntryPrivilege(Privilege requestPrivilege, Priv
     return false;
 }
 
+bool IsSameSubject(const SubjectDescriptor & a, const SubjectDescriptor & b)
+{
+    return a.fabricIndex == b.fabricIndex && a.authMode == b.authMode && a.subject == b.subject && a.cats == b.cats;
+}
+
+// Whether any subject of the entry matches the subject descriptor. An entry without subjects matches any subject.
+CHIP_ERROR CheckEntrySubjects(const AccessControl::Entry & entry, AuthMode authMode, const SubjectDescriptor & subjectDescriptor,
+                              bool & matched)
+{
+    size_t subjectCount = 0;
+    ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+    matched = (subjectCount == 0);
+    for (size_t i = 0; i < subjectCount && !matched; ++i)
+    {
+        NodeId subject = kUndefinedNodeId;
+        ReturnErrorOnFailure(entry.GetSubject(i, subject));
+        if (IsOperationalNodeId(subject))
+        {
+            VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+            matched = (subject == subjectDescriptor.subject);
+        }
+        else if (IsCASEAuthTag(subject))
+        {
+            VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+            matched = subjectDescriptor.cats.CheckSubjectAgainstCATs(subject);
+        }
+        else if (IsGroupId(subject))
+        {
+            VerifyOrReturnError(authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+            matched = (subject == subjectDescriptor.subject);
+        }
+        else
+        {
+            // Operational PASE not supported for v1.0.
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
 constexpr bool IsValidCaseNodeId(NodeId aNodeId)
 {
     if (IsOperationalNodeId(aNodeId))
@@ -190,6 +230,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        InvalidateCheckCache();
     }
 
     return retval;
@@ -201,6 +242,7 @@ void AccessControl::Finish()
     ChipLogProgress(DataManagement, "AccessControl: finishing");
     mDelegate->Finish();
     mDelegate = nullptr;
+    InvalidateCheckCache();
 }
 
 CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t * index,
@@ -355,6 +397,58 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
         return CHIP_NO_ERROR;
     }
 
+    CHIP_ERROR result;
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+    if (FindCachedCheck(subjectDescriptor, requestPath, requestPrivilege, result))
+    {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+        ChipLogProgress(DataManagement, "AccessControl: %s (cached)", (result == CHIP_NO_ERROR) ? "allowed" : "denied");
+#else
+        if (result != CHIP_NO_ERROR)
+        {
+            ChipLogProgress(DataManagement, "AccessControl: denied (cached)");
+        }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+        return result;
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+
+    bool usedDeviceType = false;
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES > 0
+    if (CompileSubject(subjectDescriptor) == CHIP_NO_ERROR)
+    {
+        result = CheckCompiledSubject(requestPath, requestPrivilege, usedDeviceType);
+    }
+    else
+#endif // CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES > 0
+    {
+        result = CheckEntries(subjectDescriptor, requestPath, requestPrivilege, usedDeviceType);
+    }
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+    // Device types on an endpoint can change without the entries changing, so those decisions are not kept.
+    if (!usedDeviceType && (result == CHIP_NO_ERROR || result == CHIP_ERROR_ACCESS_DENIED))
+    {
+        CacheCheck(subjectDescriptor, requestPath, requestPrivilege, result);
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+
+    if (result == CHIP_NO_ERROR)
+    {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+        ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+    }
+    else if (result == CHIP_ERROR_ACCESS_DENIED)
+    {
+        ChipLogProgress(DataManagement, "AccessControl: denied");
+    }
+    return result;
+}
+
+CHIP_ERROR AccessControl::CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                       Privilege requestPrivilege, bool & usedDeviceType)
+{
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -377,52 +471,11 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
             continue;
         }
 
-        size_t subjectCount = 0;
-        ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
-        if (subjectCount > 0)
+        bool subjectMatched = false;
+        ReturnErrorOnFailure(CheckEntrySubjects(entry, authMode, subjectDescriptor, subjectMatched));
+        if (!subjectMatched)
         {
-            bool subjectMatched = false;
-            for (size_t i = 0; i < subjectCount; ++i)
-            {
-                NodeId subject = kUndefinedNodeId;
-                ReturnErrorOnFailure(entry.GetSubject(i, subject));
-                if (IsOperationalNodeId(subject))
-                {
-                    VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
-                    if (subject == subjectDescriptor.subject)
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
-                }
-                else if (IsCASEAuthTag(subject))
-                {
-                    VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
-                    if (subjectDescriptor.cats.CheckSubjectAgainstCATs(subject))
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
-                }
-                else if (IsGroupId(subject))
-                {
-                    VerifyOrReturnError(authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
-                    if (subject == subjectDescriptor.subject)
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
-                }
-                else
-                {
-                    // Operational PASE not supported for v1.0.
-                    return CHIP_ERROR_INCORRECT_STATE;
-                }
-            }
-            if (!subjectMatched)
-            {
-                continue;
-            }
+            continue;
         }
 
         size_t targetCount = 0;
@@ -434,41 +487,180 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
             {
                 Entry::Target target;
                 ReturnErrorOnFailure(entry.GetTarget(i, target));
-                if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
-                {
-                    continue;
-                }
-                if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
-                {
-                    continue;
-                }
-                if (target.flags & Entry::Target::kDeviceType &&
-                    !mDeviceTypeResolver->IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
+                if (TargetMatches(target, requestPath, usedDeviceType))
                 {
-                    continue;
+                    targetMatched = true;
+                    break;
                 }
-                targetMatched = true;
-                break;
             }
             if (!targetMatched)
             {
                 continue;
             }
         }
-        // Entry passed all checks: access is allowed.
-
-#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-        ChipLogProgress(DataManagement, "AccessControl: allowed");
-#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
 
+        // Entry passed all checks: access is allowed.
         return CHIP_NO_ERROR;
     }
 
     // No entry was found which passed all checks: access is denied.
-    ChipLogProgress(DataManagement, "AccessControl: denied");
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
+bool AccessControl::TargetMatches(const Entry::Target & target, const RequestPath & requestPath, bool & usedDeviceType) const
+{
+    if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
+    {
+        return false;
+    }
+    if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
+    {
+        return false;
+    }
+    if (target.flags & Entry::Target::kDeviceType)
+    {
+        usedDeviceType = true;
+        if (!mDeviceTypeResolver->IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AccessControl::InvalidateCheckCache()
+{
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES > 0
+    mCompiledSubject.valid = false;
+#endif
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+    mCheckCacheCount = 0;
+    mCheckCacheNext  = 0;
+#endif
+}
+
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES > 0
+CHIP_ERROR AccessControl::CompileSubject(const SubjectDescriptor & subjectDescriptor)
+{
+    CompiledSubject & compiled = mCompiledSubject;
+    if (compiled.valid && IsSameSubject(compiled.subjectDescriptor, subjectDescriptor))
+    {
+        return compiled.complete ? CHIP_NO_ERROR : CHIP_ERROR_NO_MEMORY;
+    }
+
+    compiled.valid             = true;
+    compiled.complete          = false;
+    compiled.subjectDescriptor = subjectDescriptor;
+    compiled.entryCount        = 0;
+    compiled.targetCount       = 0;
+
+    EntryIterator iterator;
+    ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
+
+    Entry entry;
+    while (iterator.Next(entry) == CHIP_NO_ERROR)
+    {
+        AuthMode authMode = AuthMode::kNone;
+        ReturnErrorOnFailure(entry.GetAuthMode(authMode));
+        VerifyOrReturnError(authMode == AuthMode::kCase || authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+        if (authMode != subjectDescriptor.authMode)
+        {
+            continue;
+        }
+
+        bool subjectMatched = false;
+        ReturnErrorOnFailure(CheckEntrySubjects(entry, authMode, subjectDescriptor, subjectMatched));
+        if (!subjectMatched)
+        {
+            continue;
+        }
+
+        size_t targetCount = 0;
+        ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+        VerifyOrReturnError(compiled.entryCount < ArraySize(compiled.entries), CHIP_ERROR_NO_MEMORY);
+        VerifyOrReturnError(targetCount <= ArraySize(compiled.targets) - compiled.targetCount, CHIP_ERROR_NO_MEMORY);
+
+        CompiledEntry & compiledEntry = compiled.entries[compiled.entryCount];
+        ReturnErrorOnFailure(entry.GetPrivilege(compiledEntry.privilege));
+        compiledEntry.targetIndex = compiled.targetCount;
+        compiledEntry.targetCount = targetCount;
+        for (size_t i = 0; i < targetCount; ++i)
+        {
+            ReturnErrorOnFailure(entry.GetTarget(i, compiled.targets[compiled.targetCount + i]));
+        }
+        compiled.targetCount += targetCount;
+        compiled.entryCount++;
+    }
+
+    compiled.complete = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControl::CheckCompiledSubject(const RequestPath & requestPath, Privilege requestPrivilege,
+                                               bool & usedDeviceType) const
+{
+    const CompiledSubject & compiled = mCompiledSubject;
+    for (size_t i = 0; i < compiled.entryCount; ++i)
+    {
+        const CompiledEntry & entry = compiled.entries[i];
+        if (!CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, entry.privilege))
+        {
+            continue;
+        }
+
+        bool targetMatched = (entry.targetCount == 0);
+        for (size_t j = 0; j < entry.targetCount && !targetMatched; ++j)
+        {
+            targetMatched = TargetMatches(compiled.targets[entry.targetIndex + j], requestPath, usedDeviceType);
+        }
+        if (targetMatched)
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
+    return CHIP_ERROR_ACCESS_DENIED;
+}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES > 0
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+bool AccessControl::FindCachedCheck(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                    Privilege requestPrivilege, CHIP_ERROR & result) const
+{
+    for (size_t i = 0; i < mCheckCacheCount; ++i)
+    {
+        const CachedCheck & cached = mCheckCache[i];
+        if (cached.requestPrivilege == requestPrivilege && cached.requestPath.cluster == requestPath.cluster &&
+            cached.requestPath.endpoint == requestPath.endpoint && IsSameSubject(cached.subjectDescriptor, subjectDescriptor))
+        {
+            result = cached.allowed ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AccessControl::CacheCheck(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                               Privilege requestPrivilege, CHIP_ERROR result)
+{
+    size_t index;
+    if (mCheckCacheCount < ArraySize(mCheckCache))
+    {
+        index = mCheckCacheCount++;
+    }
+    else
+    {
+        index           = mCheckCacheNext;
+        mCheckCacheNext = (mCheckCacheNext + 1) % ArraySize(mCheckCache);
+    }
+
+    CachedCheck & cached     = mCheckCache[index];
+    cached.subjectDescriptor = subjectDescriptor;
+    cached.requestPath       = requestPath;
+    cached.requestPrivilege  = requestPrivilege;
+    cached.allowed           = (result == CHIP_NO_ERROR);
+}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
 CHIP_ERROR AccessControl::Dump(const Entry & entry)
 {
@@ -626,6 +818,8 @@ exit:
 void AccessControl::NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
                                        const Entry * entry, EntryListener::ChangeType changeType)
 {
+    InvalidateCheckCache();
+
     for (EntryListener * listener = mEntryListener; listener != nullptr; listener = listener->mNext)
     {
         listener->OnEntryChanged(subjectDescriptor, fabric, index, entry, changeType);
@@ -497,6 +497,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCheckCache();
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -547,6 +548,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCheckCache();
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -568,6 +570,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCheckCache();
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -649,12 +652,81 @@ private:
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
+    /**
+     * Forget cached check decisions and compiled entries. Called whenever entries may have changed.
+     */
+    void InvalidateCheckCache();
+
+    /**
+     * Check against the entries of the subject's fabric, as provided by the delegate.
+     *
+     * @param [out] usedDeviceType Set if the result depended on which device types are on the endpoint.
+     */
+    CHIP_ERROR CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                            Privilege requestPrivilege, bool & usedDeviceType);
+
+    bool TargetMatches(const Entry::Target & target, const RequestPath & requestPath, bool & usedDeviceType) const;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES > 0
+    /**
+     * Copy the privileges and targets of the entries that apply to the subject out of the delegate. Fails if an entry is
+     * malformed or there are too many to copy, in which case checks for the subject go to the delegate.
+     */
+    CHIP_ERROR CompileSubject(const SubjectDescriptor & subjectDescriptor);
+
+    CHIP_ERROR CheckCompiledSubject(const RequestPath & requestPath, Privilege requestPrivilege, bool & usedDeviceType) const;
+#endif
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+    bool FindCachedCheck(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                         CHIP_ERROR & result) const;
+    void CacheCheck(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                    CHIP_ERROR result);
+#endif
+
 private:
     Delegate * mDelegate = nullptr;
 
     DeviceTypeResolver * mDeviceTypeResolver = nullptr;
 
     EntryListener * mEntryListener = nullptr;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES > 0
+    // The entries that apply to the most recently checked subject, in delegate order.
+    struct CompiledEntry
+    {
+        Privilege privilege;
+        size_t targetIndex;
+        size_t targetCount; // 0 matches any request path
+    };
+
+    struct CompiledSubject
+    {
+        bool valid    = false; // subjectDescriptor is set and the entries below, if complete, reflect the current entries
+        bool complete = false; // all entries that apply to the subject fit
+        SubjectDescriptor subjectDescriptor;
+        size_t entryCount  = 0;
+        size_t targetCount = 0;
+        CompiledEntry entries[CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES];
+        Entry::Target targets[CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_TARGETS];
+    };
+
+    CompiledSubject mCompiledSubject;
+#endif
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE > 0
+    struct CachedCheck
+    {
+        SubjectDescriptor subjectDescriptor;
+        RequestPath requestPath;
+        Privilege requestPrivilege;
+        bool allowed;
+    };
+
+    CachedCheck mCheckCache[CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE];
+    size_t mCheckCacheCount = 0; // number of valid entries in mCheckCache
+    size_t mCheckCacheNext  = 0; // entry to replace next once mCheckCache is full
+#endif
 };
 
 /**
@@ -1760,6 +1760,41 @@ void TestCheck(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void TestCheckAfterEntryChanges(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr SubjectDescriptor subject3 = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId3 };
+    constexpr SubjectDescriptor subject1 = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId1 };
+    constexpr RequestPath requestPath    = { .cluster = kOnOffCluster, .endpoint = 1 };
+
+    NL_TEST_ASSERT(inSuite, ClearAccessControl(accessControl) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, LoadAccessControl(accessControl, entryData1, 1) == CHIP_NO_ERROR);
+
+    // Repeated checks must give the same decision.
+    for (int i = 0; i < 2; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, accessControl.Check(subject3, requestPath, Privilege::kAdminister) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.Check(subject1, requestPath, Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+    }
+
+    // Entry changes made through the fabric-scoped API are seen by the next check.
+    {
+        Entry entry;
+        NL_TEST_ASSERT(inSuite, accessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadEntry(entry, entryData1[1]) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.UpdateEntry(nullptr, 1, 0, entry) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subject3, requestPath, Privilege::kAdminister) == CHIP_ERROR_ACCESS_DENIED);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subject1, requestPath, Privilege::kView) == CHIP_NO_ERROR);
+
+    // So are changes made through the index-based API.
+    NL_TEST_ASSERT(inSuite, accessControl.DeleteEntry(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subject1, requestPath, Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+    NL_TEST_ASSERT(inSuite, LoadAccessControl(accessControl, entryData1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subject3, requestPath, Privilege::kAdminister) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, ClearAccessControl(accessControl) == CHIP_NO_ERROR);
+}
+
 void TestCreateReadEntry(nlTestSuite * inSuite, void * inContext)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -2235,6 +2270,7 @@ int TestAccessControl()
         NL_TEST_DEF("TestFabricFilteredReadEntry", TestFabricFilteredReadEntry),
         NL_TEST_DEF("TestFabricFilteredCreateEntry", TestFabricFilteredCreateEntry),
         NL_TEST_DEF("TestCheck", TestCheck),
+        NL_TEST_DEF("TestCheckAfterEntryChanges", TestCheckAfterEntryChanges),
         NL_TEST_SENTINEL()
     };
     // clang-format on
@@ -17,8 +17,12 @@
  */
 
 #include "system/SystemPacketBuffer.h"
+#include <algorithm>
 #include <app/ClusterStateCache.h>
 #include <app/InteractionModelEngine.h>
+#include <lib/support/SafeInt.h>
+#include <memory>
+#include <string.h>
 #include <tuple>
 
 namespace chip {
@@ -47,64 +51,159 @@ size_t SizeOfStatusIB(const StatusIB & aStatus)
     return size;
 }
 
+// Compact the data buffer of a cluster once at least this fraction of it is unused.
+constexpr size_t kCompactDataRatio = 4;
+
 } // anonymous namespace
 
-CHIP_ERROR ClusterStateCache::GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize)
+CHIP_ERROR ClusterStateCache::EncodeElement(const TLV::TLVReader & aData, ByteSpan & aEncoded)
 {
-    Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
     TLV::TLVReader reader;
-    reader.Init(*apData);
+    reader.Init(aData);
+
+    // The encoded element is never larger than the rest of the data it was read from. The buffer is kept across calls, so
+    // that caching an attribute only allocates when its cluster needs more room.
     size_t totalBufSize = reader.GetTotalLength();
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
+    if (mEncodeBuffer.AllocatedSize() < totalBufSize)
+    {
+        mEncodeBuffer.Calloc(totalBufSize);
+        VerifyOrReturnError(mEncodeBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    TLV::TLVWriter writer;
+    writer.Init(mEncodeBuffer.Get(), mEncodeBuffer.AllocatedSize());
     ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
-    aSize = writer.GetLengthWritten();
-    ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+    ReturnErrorOnFailure(writer.Finalize());
+    aEncoded = ByteSpan(mEncodeBuffer.Get(), writer.GetLengthWritten());
     return CHIP_NO_ERROR;
 }
 
+ClusterStateCache::NodeState::const_iterator ClusterStateCache::FindClusterPosition(EndpointId endpointId,
+                                                                                    ClusterId clusterId) const
+{
+    return std::lower_bound(mCache.begin(), mCache.end(), std::make_tuple(endpointId, clusterId),
+                            [](const ClusterState & state, const std::tuple<EndpointId, ClusterId> & key) {
+                                return std::make_tuple(state.mEndpointId, state.mClusterId) < key;
+                            });
+}
+
+ClusterStateCache::NodeState::iterator ClusterStateCache::FindClusterPosition(EndpointId endpointId, ClusterId clusterId)
+{
+    return std::lower_bound(mCache.begin(), mCache.end(), std::make_tuple(endpointId, clusterId),
+                            [](const ClusterState & state, const std::tuple<EndpointId, ClusterId> & key) {
+                                return std::make_tuple(state.mEndpointId, state.mClusterId) < key;
+                            });
+}
+
+ClusterStateCache::ClusterState & ClusterStateCache::GetOrAddClusterState(EndpointId endpointId, ClusterId clusterId)
+{
+    auto clusterIter = FindClusterPosition(endpointId, clusterId);
+    if (clusterIter == mCache.end() || clusterIter->mEndpointId != endpointId || clusterIter->mClusterId != clusterId)
+    {
+        // Clusters are added far less often than they are looked up, so the cost of keeping the vector sorted pays off.
+        ClusterState clusterState;
+        clusterState.mEndpointId = endpointId;
+        clusterState.mClusterId  = clusterId;
+        clusterIter              = mCache.insert(clusterIter, std::move(clusterState));
+    }
+    return *clusterIter;
+}
+
+void ClusterStateCache::SetAttributeState(ClusterState & aClusterState, AttributeState & aAttributeState, const ByteSpan & aData)
+{
+    if (aAttributeState.mType == AttributeState::Type::kData)
+    {
+        // The previous value stays in the buffer until the cluster is compacted.
+        aClusterState.mUnusedDataSize += aAttributeState.mDataSize;
+    }
+
+    if (aAttributeState.mType == AttributeState::Type::kData && aAttributeState.mDataSize >= aData.size())
+    {
+        // Reuse the room of the previous value if the new value fits in it.
+        aClusterState.mUnusedDataSize -= aData.size();
+    }
+    else
+    {
+        aAttributeState.mDataOffset = static_cast<uint32_t>(aClusterState.mData.size());
+        aClusterState.mData.resize(aClusterState.mData.size() + aData.size());
+    }
+
+    memcpy(aClusterState.mData.data() + aAttributeState.mDataOffset, aData.data(), aData.size());
+    aAttributeState.mType     = AttributeState::Type::kData;
+    aAttributeState.mDataSize = static_cast<uint32_t>(aData.size());
+}
+
+void ClusterStateCache::CompactData(ClusterState & aClusterState)
+{
+    size_t wastedSize = aClusterState.mUnusedDataSize + aClusterState.mData.capacity() - aClusterState.mData.size();
+    VerifyOrReturn(wastedSize > 0 && wastedSize >= aClusterState.mData.capacity() / kCompactDataRatio);
+
+    std::vector<uint8_t> data;
+    data.reserve(aClusterState.mData.size() - aClusterState.mUnusedDataSize);
+    for (auto & attributeState : aClusterState.mAttributes)
+    {
+        if (attributeState.mType == AttributeState::Type::kData)
+        {
+            const uint8_t * attributeData = aClusterState.GetData(attributeState);
+            attributeState.mDataOffset    = static_cast<uint32_t>(data.size());
+            data.insert(data.end(), attributeData, attributeData + attributeState.mDataSize);
+        }
+    }
+    aClusterState.mData           = std::move(data);
+    aClusterState.mUnusedDataSize = 0;
+}
+
 CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
                                           const StatusIB & aStatus)
 {
-    AttributeState state;
-    bool endpointIsNew = false;
+    ByteSpan encodedData;
+    if (apData)
+    {
+        ReturnErrorOnFailure(EncodeElement(*apData, encodedData));
+        // Offsets and sizes in the data buffer of a cluster are stored on 32 bits.
+        VerifyOrReturnError(CanCastTo<uint32_t>(encodedData.size()), CHIP_ERROR_NO_MEMORY);
+    }
 
-    if (mCache.find(aPath.mEndpointId) == mCache.end())
+    //
+    // Since we might potentially be creating a new entry at (aPath.mEndpointId, aPath.mClusterId) that wasn't there before,
+    // we need to check if an entry for the endpoint didn't exist previously and remember that so that we can appropriately
+    // notify our clients of the addition of a new endpoint.
+    //
+    auto endpointIter  = FindClusterPosition(aPath.mEndpointId, 0);
+    bool endpointIsNew = (endpointIter == mCache.end() || endpointIter->mEndpointId != aPath.mEndpointId);
+
+    ClusterState & clusterState = GetOrAddClusterState(aPath.mEndpointId, aPath.mClusterId);
+
+    auto attributeIter = std::lower_bound(
+        clusterState.mAttributes.begin(), clusterState.mAttributes.end(), aPath.mAttributeId,
+        [](const AttributeState & state, AttributeId attributeId) { return state.mAttributeId < attributeId; });
+    if (attributeIter == clusterState.mAttributes.end() || attributeIter->mAttributeId != aPath.mAttributeId)
     {
-        //
-        // Since we might potentially be creating a new entry at mCache[aPath.mEndpointId][aPath.mClusterId] that
-        // wasn't there before, we need to check if an entry didn't exist there previously and remember that so that
-        // we can appropriately notify our clients of the addition of a new endpoint.
-        //
-        endpointIsNew = true;
+        AttributeState attributeState;
+        attributeState.mAttributeId = aPath.mAttributeId;
+        attributeState.mType        = AttributeState::Type::kSize;
+        attributeState.mDataOffset  = 0;
+        attributeState.mDataSize    = 0;
+        attributeIter               = clusterState.mAttributes.insert(attributeIter, attributeState);
     }
+    AttributeState & attributeState = *attributeIter;
 
     if (apData)
     {
-        size_t elementSize = 0;
-        ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
-
         if (mCacheData)
         {
-            Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
-            backingBuffer.Calloc(elementSize);
-            VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-            TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
-            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
-            ReturnErrorOnFailure(writer.Finalize(backingBuffer));
-
-            state.Set<AttributeData>(std::move(backingBuffer));
+            SetAttributeState(clusterState, attributeState, encodedData);
         }
         else
         {
-            state.Set<size_t>(elementSize);
+            attributeState.mType     = AttributeState::Type::kSize;
+            attributeState.mDataSize = static_cast<uint32_t>(encodedData.size());
         }
         //
         // Clear out the committed data version and only set it again once we have received all data for this cluster.
         // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
         //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
+        clusterState.mCommittedDataVersion.ClearValue();
 
         // This commits a pending data version if the last report path is valid and it is different from the current path.
         if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
@@ -125,20 +224,27 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
         if (foundEncompassingWildcardPath)
         {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
+            clusterState.mPendingDataVersion = aPath.mDataVersion;
         }
 
         mLastReportDataPath = aPath;
     }
     else
     {
+        if (attributeState.mType == AttributeState::Type::kData)
+        {
+            clusterState.mUnusedDataSize += attributeState.mDataSize;
+        }
+
         if (mCacheData)
         {
-            state.Set<StatusIB>(aStatus);
+            attributeState.mType   = AttributeState::Type::kStatus;
+            attributeState.mStatus = aStatus;
         }
         else
         {
-            state.Set<size_t>(SizeOfStatusIB(aStatus));
+            attributeState.mType     = AttributeState::Type::kSize;
+            attributeState.mDataSize = static_cast<uint32_t>(SizeOfStatusIB(aStatus));
         }
     }
 
@@ -151,11 +257,10 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
-    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
-
     if (mCacheData)
     {
         mChangedAttributeSet.insert(aPath);
+        MarkClusterUnpublished(aPath.mEndpointId, aPath.mClusterId);
     }
 
     return CHIP_NO_ERROR;
@@ -223,11 +328,18 @@ void ClusterStateCache::CommitPendingDataVersion()
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
-    if (lastClusterInfo.mPendingDataVersion.HasValue())
+    auto lastClusterIter = FindClusterPosition(mLastReportDataPath.mEndpointId, mLastReportDataPath.mClusterId);
+    if (lastClusterIter == mCache.end() || lastClusterIter->mEndpointId != mLastReportDataPath.mEndpointId ||
+        lastClusterIter->mClusterId != mLastReportDataPath.mClusterId)
+    {
+        return;
+    }
+
+    if (lastClusterIter->mPendingDataVersion.HasValue())
     {
-        lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
-        lastClusterInfo.mPendingDataVersion.ClearValue();
+        lastClusterIter->mCommittedDataVersion = lastClusterIter->mPendingDataVersion;
+        lastClusterIter->mPendingDataVersion.ClearValue();
+        MarkClusterUnpublished(lastClusterIter->mEndpointId, lastClusterIter->mClusterId);
     }
 }
 
@@ -243,10 +355,28 @@ void ClusterStateCache::OnReportEnd()
     //
     for (auto & path : mChangedAttributeSet)
     {
-        mCallback.OnAttributeChanged(this, path);
         changedClusters.insert(std::make_tuple(path.mEndpointId, path.mClusterId));
     }
 
+    // The data of the changed clusters does not move while the callbacks below may be reading it.
+    for (auto & item : changedClusters)
+    {
+        auto clusterIter = FindClusterPosition(std::get<0>(item), std::get<1>(item));
+        if (clusterIter != mCache.end() && clusterIter->mEndpointId == std::get<0>(item) &&
+            clusterIter->mClusterId == std::get<1>(item))
+        {
+            CompactData(*clusterIter);
+        }
+    }
+
+    // Publish before the callbacks, so that the snapshot they get from GetSnapshot() includes the changes.
+    PublishSnapshot();
+
+    for (auto & path : mChangedAttributeSet)
+    {
+        mCallback.OnAttributeChanged(this, path);
+    }
+
     for (auto & item : changedClusters)
     {
         mCallback.OnClusterChanged(this, std::get<0>(item), std::get<1>(item));
@@ -263,22 +393,42 @@ void ClusterStateCache::OnReportEnd()
 CHIP_ERROR ClusterStateCache::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
 {
     CHIP_ERROR err;
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
+    auto clusterState = GetClusterState(path.mEndpointId, path.mClusterId, err);
     ReturnErrorOnFailure(err);
-    if (attributeState->Is<StatusIB>())
+    return GetAttributeData(*clusterState, path.mAttributeId, reader);
+}
+
+CHIP_ERROR ClusterStateCache::GetAttributeData(const ClusterState & clusterState, AttributeId attributeId, TLV::TLVReader & reader)
+{
+    auto attributeState = FindAttributeState(clusterState, attributeId);
+    VerifyOrReturnError(attributeState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    if (attributeState->mType == AttributeState::Type::kStatus)
     {
         return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
     }
 
-    if (!attributeState->Is<AttributeData>())
+    if (attributeState->mType != AttributeState::Type::kData)
     {
         return CHIP_ERROR_KEY_NOT_FOUND;
     }
 
-    reader.Init(attributeState->Get<AttributeData>().Get(), attributeState->Get<AttributeData>().AllocatedSize());
+    reader.Init(clusterState.GetData(*attributeState), attributeState->mDataSize);
     return reader.Next();
 }
 
+CHIP_ERROR ClusterStateCache::GetAttributeStatus(const ClusterState & clusterState, AttributeId attributeId, StatusIB & status)
+{
+    auto attributeState = FindAttributeState(clusterState, attributeId);
+    VerifyOrReturnError(attributeState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    if (attributeState->mType != AttributeState::Type::kStatus)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = attributeState->mStatus;
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR ClusterStateCache::Get(EventNumber eventNumber, TLV::TLVReader & reader) const
 {
     CHIP_ERROR err;
@@ -295,57 +445,28 @@ CHIP_ERROR ClusterStateCache::Get(EventNumber eventNumber, TLV::TLVReader & read
     return CHIP_NO_ERROR;
 }
 
-const ClusterStateCache::EndpointState * ClusterStateCache::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
-{
-    auto endpointIter = mCache.find(endpointId);
-    if (endpointIter == mCache.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &endpointIter->second;
-}
-
 const ClusterStateCache::ClusterState * ClusterStateCache::GetClusterState(EndpointId endpointId, ClusterId clusterId,
                                                                            CHIP_ERROR & err) const
 {
-    auto endpointState = GetEndpointState(endpointId, err);
-    if (err != CHIP_NO_ERROR)
-    {
-        return nullptr;
-    }
-
-    auto clusterState = endpointState->find(clusterId);
-    if (clusterState == endpointState->end())
+    auto clusterState = FindClusterPosition(endpointId, clusterId);
+    if (clusterState == mCache.end() || clusterState->mEndpointId != endpointId || clusterState->mClusterId != clusterId)
     {
         err = CHIP_ERROR_KEY_NOT_FOUND;
         return nullptr;
     }
 
     err = CHIP_NO_ERROR;
-    return &clusterState->second;
+    return &(*clusterState);
 }
 
-const ClusterStateCache::AttributeState * ClusterStateCache::GetAttributeState(EndpointId endpointId, ClusterId clusterId,
-                                                                               AttributeId attributeId, CHIP_ERROR & err) const
+const ClusterStateCache::AttributeState * ClusterStateCache::FindAttributeState(const ClusterState & clusterState,
+                                                                                AttributeId attributeId)
 {
-    auto clusterState = GetClusterState(endpointId, clusterId, err);
-    if (err != CHIP_NO_ERROR)
-    {
-        return nullptr;
-    }
-
-    auto attributeState = clusterState->mAttributes.find(attributeId);
-    if (attributeState == clusterState->mAttributes.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &attributeState->second;
+    auto attributeIter = std::lower_bound(
+        clusterState.mAttributes.begin(), clusterState.mAttributes.end(), attributeId,
+        [](const AttributeState & state, AttributeId attributeIdToFind) { return state.mAttributeId < attributeIdToFind; });
+    VerifyOrReturnValue(attributeIter != clusterState.mAttributes.end() && attributeIter->mAttributeId == attributeId, nullptr);
+    return &(*attributeIter);
 }
 
 const ClusterStateCache::EventData * ClusterStateCache::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
@@ -421,17 +542,9 @@ void ClusterStateCache::OnEventData(const EventHeader & aEventHeader, TLV::TLVRe
 CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
 {
     CHIP_ERROR err;
-
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
+    auto clusterState = GetClusterState(path.mEndpointId, path.mClusterId, err);
     ReturnErrorOnFailure(err);
-
-    if (!attributeState->Is<StatusIB>())
-    {
-        return CHIP_ERROR_INVALID_ARGUMENT;
-    }
-
-    status = attributeState->Get<StatusIB>();
-    return CHIP_NO_ERROR;
+    return GetAttributeStatus(*clusterState, path.mAttributeId, status);
 }
 
 CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteEventPath & path, StatusIB & status) const
@@ -448,55 +561,38 @@ CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteEventPath & path, StatusIB
 
 void ClusterStateCache::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
 {
-    for (auto const & endpointIter : mCache)
+    for (auto const & clusterState : mCache)
     {
-        EndpointId endpointId = endpointIter.first;
-        for (auto const & clusterIter : endpointIter.second)
+        if (!clusterState.mCommittedDataVersion.HasValue())
         {
-            if (!clusterIter.second.mCommittedDataVersion.HasValue())
-            {
-                continue;
-            }
-            DataVersion dataVersion = clusterIter.second.mCommittedDataVersion.Value();
-            size_t clusterSize      = 0;
-            ClusterId clusterId     = clusterIter.first;
+            continue;
+        }
+        DataVersion dataVersion = clusterState.mCommittedDataVersion.Value();
+        size_t clusterSize      = 0;
 
-            for (auto const & attributeIter : clusterIter.second.mAttributes)
+        for (auto const & attributeState : clusterState.mAttributes)
+        {
+            if (attributeState.mType == AttributeState::Type::kStatus)
             {
-                if (attributeIter.second.Is<StatusIB>())
-                {
-                    clusterSize += SizeOfStatusIB(attributeIter.second.Get<StatusIB>());
-                }
-                else if (attributeIter.second.Is<size_t>())
-                {
-                    clusterSize += attributeIter.second.Get<size_t>();
-                }
-                else
-                {
-                    VerifyOrDie(attributeIter.second.Is<AttributeData>());
-                    TLV::TLVReader bufReader;
-                    bufReader.Init(attributeIter.second.Get<AttributeData>().Get(),
-                                   attributeIter.second.Get<AttributeData>().AllocatedSize());
-                    ReturnOnFailure(bufReader.Next());
-                    // Skip to the end of the element.
-                    ReturnOnFailure(bufReader.Skip());
-
-                    // Compute the amount of value data
-                    clusterSize += bufReader.GetLengthRead();
-                }
+                clusterSize += SizeOfStatusIB(attributeState.mStatus);
             }
-
-            if (clusterSize == 0)
+            else
             {
-                // No data in this cluster, so no point in sending a dataVersion
-                // along at all.
-                continue;
+                // The data is stored as a single element, so its size is the amount of value data.
+                clusterSize += attributeState.mDataSize;
             }
+        }
 
-            DataVersionFilter filter(endpointId, clusterId, dataVersion);
-
-            aVector.push_back(std::make_pair(filter, clusterSize));
+        if (clusterSize == 0)
+        {
+            // No data in this cluster, so no point in sending a dataVersion
+            // along at all.
+            continue;
         }
+
+        DataVersionFilter filter(clusterState.mEndpointId, clusterState.mClusterId, dataVersion);
+
+        aVector.push_back(std::make_pair(filter, clusterSize));
     }
 
     std::sort(aVector.begin(), aVector.end(),
@@ -587,6 +683,131 @@ exit:
     return err;
 }
 
+CHIP_ERROR ClusterStateCache::EnableSnapshots()
+{
+    VerifyOrReturnError(mCacheData, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!mSnapshotsEnabled, CHIP_NO_ERROR);
+
+    // With no previous snapshot, every cluster goes into the first one.
+    mSnapshotsEnabled = true;
+    mUnpublishedClusters.clear();
+    PublishSnapshot();
+    if (mSnapshot == nullptr)
+    {
+        mSnapshotsEnabled = false;
+        return CHIP_ERROR_NO_MEMORY;
+    }
+    return CHIP_NO_ERROR;
+}
+
+ClusterStateCache::SnapshotHandle ClusterStateCache::GetSnapshot() const
+{
+    return std::atomic_load(&mSnapshot);
+}
+
+void ClusterStateCache::MarkClusterUnpublished(EndpointId aEndpointId, ClusterId aClusterId)
+{
+    if (mSnapshotsEnabled)
+    {
+        mUnpublishedClusters.insert(std::make_tuple(aEndpointId, aClusterId));
+    }
+}
+
+void ClusterStateCache::PublishSnapshot()
+{
+    VerifyOrReturn(mSnapshotsEnabled);
+    VerifyOrReturn(mSnapshot == nullptr || !mUnpublishedClusters.empty());
+
+    auto snapshot = Platform::MakeShared<Snapshot>();
+    if (snapshot == nullptr)
+    {
+        // Readers keep the previous snapshot until a later report publishes the changes.
+        ChipLogError(DataManagement, "Failed to allocate a cache snapshot");
+        return;
+    }
+    snapshot->mGeneration = (mSnapshot != nullptr) ? mSnapshot->mGeneration + 1 : 1;
+    snapshot->mClusters.reserve(mCache.size());
+
+    // Clusters are never removed from the cache, so the clusters of the previous snapshot are a subset of those of the
+    // cache, in the same order.
+    size_t previousIndex = 0;
+    for (auto & clusterState : mCache)
+    {
+        if (mSnapshot != nullptr && previousIndex < mSnapshot->mClusters.size())
+        {
+            auto & previousCluster = mSnapshot->mClusters[previousIndex];
+            if (previousCluster->mState.mEndpointId == clusterState.mEndpointId &&
+                previousCluster->mState.mClusterId == clusterState.mClusterId)
+            {
+                previousIndex++;
+                if (mUnpublishedClusters.count(std::make_tuple(clusterState.mEndpointId, clusterState.mClusterId)) == 0)
+                {
+                    snapshot->mClusters.push_back(previousCluster);
+                    continue;
+                }
+            }
+        }
+
+        auto clusterSnapshot = Platform::MakeShared<Snapshot::ClusterSnapshot>();
+        if (clusterSnapshot == nullptr)
+        {
+            ChipLogError(DataManagement, "Failed to allocate a cache snapshot");
+            return;
+        }
+        clusterSnapshot->mState      = clusterState;
+        clusterSnapshot->mGeneration = snapshot->mGeneration;
+        snapshot->mClusters.push_back(std::move(clusterSnapshot));
+    }
+
+    std::atomic_store(&mSnapshot, SnapshotHandle(std::move(snapshot)));
+    mUnpublishedClusters.clear();
+}
+
+const ClusterStateCache::Snapshot::ClusterSnapshot * ClusterStateCache::Snapshot::GetClusterSnapshot(EndpointId endpointId,
+                                                                                                     ClusterId clusterId) const
+{
+    auto clusterIter = std::lower_bound(mClusters.begin(), mClusters.end(), std::make_tuple(endpointId, clusterId),
+                                        [](const Platform::SharedPtr<const ClusterSnapshot> & cluster,
+                                           const std::tuple<EndpointId, ClusterId> & key) {
+                                            return std::make_tuple(cluster->mState.mEndpointId, cluster->mState.mClusterId) < key;
+                                        });
+    VerifyOrReturnValue(clusterIter != mClusters.end(), nullptr);
+    VerifyOrReturnValue((*clusterIter)->mState.mEndpointId == endpointId && (*clusterIter)->mState.mClusterId == clusterId,
+                        nullptr);
+    return clusterIter->get();
+}
+
+CHIP_ERROR ClusterStateCache::Snapshot::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
+{
+    auto clusterSnapshot = GetClusterSnapshot(path.mEndpointId, path.mClusterId);
+    VerifyOrReturnError(clusterSnapshot != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    return GetAttributeData(clusterSnapshot->mState, path.mAttributeId, reader);
+}
+
+CHIP_ERROR ClusterStateCache::Snapshot::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
+{
+    auto clusterSnapshot = GetClusterSnapshot(path.mEndpointId, path.mClusterId);
+    VerifyOrReturnError(clusterSnapshot != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    return GetAttributeStatus(clusterSnapshot->mState, path.mAttributeId, status);
+}
+
+CHIP_ERROR ClusterStateCache::Snapshot::GetVersion(const ConcreteClusterPath & path, Optional<DataVersion> & aVersion) const
+{
+    VerifyOrReturnError(path.IsValidConcreteClusterPath(), CHIP_ERROR_INVALID_ARGUMENT);
+    auto clusterSnapshot = GetClusterSnapshot(path.mEndpointId, path.mClusterId);
+    VerifyOrReturnError(clusterSnapshot != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    aVersion = clusterSnapshot->mState.mCommittedDataVersion;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateCache::Snapshot::GetClusterGeneration(const ConcreteClusterPath & path, uint64_t & aGeneration) const
+{
+    auto clusterSnapshot = GetClusterSnapshot(path.mEndpointId, path.mClusterId);
+    VerifyOrReturnError(clusterSnapshot != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    aGeneration = clusterSnapshot->mGeneration;
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR ClusterStateCache::GetLastReportDataPath(ConcreteClusterPath & aPath)
 {
     if (mLastReportDataPath.IsValidConcreteClusterPath())
@@ -27,11 +27,15 @@
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/Variant.h>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -64,6 +68,8 @@ namespace app {
  * **NOTE**
  * 1. This already includes the BufferedReadCallback, so there is no need to add that to the ReadClient callback chain.
  * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
+ * 3. The cache must be accessed from the Matter thread (or with the stack lock held), except for the snapshots
+ *    published once EnableSnapshots() is called, which can be read from any thread.
  *
  */
 class ClusterStateCache : protected ReadClient::Callback
@@ -134,9 +140,9 @@ public:
      * it using DataModel::Decode into the in-out argument 'value'.
      *
      * For some types of attributes, the value for the attribute is directly backed by the underlying TLV buffer
-     * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer only remains
-     * valid until the cached value for that path is updated, so it must not be held
-     * across any async call boundaries.
+     * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer is shared by the
+     * attributes of a cluster and only remains valid until a cached value in that cluster is updated, so it must not
+     * be held across any async call boundaries.
      *
      * The template parameter AttributeObjectTypeT is generally expected to be a
      * ClusterName::Attributes::AttributeName::DecodableType, but any
@@ -207,7 +213,7 @@ public:
      *
      * For some types of attributes, the value for the attribute is directly backed by the underlying TLV buffer
      * and has pointers into that buffer. (e.g octet strings, char strings and lists).  This buffer only remains
-     * valid until the cached value for that path is updated, so it must not be held
+     * valid until a cached value in the cluster is updated, so it must not be held
      * across any async call boundaries.
      *
      * The template parameter ClusterObjectT is generally expected to be a
@@ -254,8 +260,8 @@ public:
      * Retrieve the value of an attribute by updating a in-out TLVReader to be positioned
      * right at the attribute value.
      *
-     * The underlying TLV buffer only remains valid until the cached value for that path is updated, so it must
-     * not be held across any async call boundaries.
+     * The underlying TLV buffer only remains valid until a cached value in the cluster of that path is updated, so it
+     * must not be held across any async call boundaries.
      *
      * Notable return values:
      *      - If neither data nor status for the specified path exist in the cache, CHIP_ERROR_KEY_NOT_FOUND
@@ -275,6 +281,31 @@ public:
      */
     CHIP_ERROR GetVersion(const ConcreteClusterPath & path, Optional<DataVersion> & aVersion) const;
 
+    /*
+     * An immutable view of the attribute data and statuses in the cache at the end of a report, see EnableSnapshots().
+     */
+    class Snapshot;
+    using SnapshotHandle = Platform::SharedPtr<const Snapshot>;
+
+    /*
+     * Start publishing a snapshot of the cached attributes at the end of every report that changes them, beginning with
+     * a snapshot of the current content of the cache. Snapshots let other threads read the cache without taking the
+     * stack lock.
+     *
+     * A snapshot shares the clusters that did not change with the previous one, but keeps its own copy of the clusters
+     * that did, so snapshots add up to the size of the cached attributes to the memory used by the cache.
+     *
+     * This must be called from the Matter thread, on a cache that stores data.
+     */
+    CHIP_ERROR EnableSnapshots();
+
+    /*
+     * Get the latest published snapshot, or nullptr if snapshots are not enabled. This can be called from any thread.
+     *
+     * A snapshot never changes, and the buffers read from it remain valid for as long as the handle is held.
+     */
+    SnapshotHandle GetSnapshot() const;
+
     /*
      * Get highest received event number.
      */
@@ -371,9 +402,9 @@ public:
         auto clusterState = GetClusterState(endpointId, clusterId, err);
         ReturnErrorOnFailure(err);
 
-        for (auto & attributeIter : clusterState->mAttributes)
+        for (auto & attributeState : clusterState->mAttributes)
         {
-            const ConcreteAttributePath path(endpointId, clusterId, attributeIter.first);
+            const ConcreteAttributePath path(endpointId, clusterId, attributeState.mAttributeId);
             ReturnErrorOnFailure(func(path));
         }
 
@@ -396,17 +427,14 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
-        for (auto & endpointIter : mCache)
+        for (auto & clusterState : mCache)
         {
-            for (auto & clusterIter : endpointIter.second)
+            if (clusterState.mClusterId == clusterId)
             {
-                if (clusterIter.first == clusterId)
+                for (auto & attributeState : clusterState.mAttributes)
                 {
-                    for (auto & attributeIter : clusterIter.second.mAttributes)
-                    {
-                        const ConcreteAttributePath path(endpointIter.first, clusterId, attributeIter.first);
-                        ReturnErrorOnFailure(func(path));
-                    }
+                    const ConcreteAttributePath path(clusterState.mEndpointId, clusterId, attributeState.mAttributeId);
+                    ReturnErrorOnFailure(func(path));
                 }
             }
         }
@@ -429,13 +457,11 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
-        auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        // The clusters of an endpoint are next to each other in the cache.
+        for (auto clusterIter = FindClusterPosition(endpointId, 0);
+             clusterIter != mCache.end() && clusterIter->mEndpointId == endpointId; ++clusterIter)
         {
-            for (auto & clusterIter : endpointIter->second)
-            {
-                ReturnErrorOnFailure(func(clusterIter.first));
-            }
+            ReturnErrorOnFailure(func(clusterIter->mClusterId));
         }
         return CHIP_NO_ERROR;
     }
@@ -530,12 +556,29 @@ private:
     // * If we got a path-specific error for the attribute, the corresponding
     //   status.
     // * If we got data for the attribute and we are storing data ourselves, the
-    //   data.
+    //   location of the data in the data buffer of its cluster.
     // * If we got data for the attribute and we are not storing data
     //   oureselves, the size of the data, so we can still prioritize sending
     //   DataVersions correctly.
-    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
-    using AttributeState = Variant<StatusIB, AttributeData, size_t>;
+    struct AttributeState
+    {
+        enum class Type : uint8_t
+        {
+            kStatus,
+            kData,
+            kSize,
+        };
+
+        AttributeId mAttributeId;
+        Type mType;
+        StatusIB mStatus;     // For kStatus
+        uint32_t mDataOffset; // For kData
+        uint32_t mDataSize;   // For kData and kSize
+    };
+
+    // The attributes of a cluster are kept sorted by ID, and the data of those stored as data is packed in a single
+    // buffer, instead of in a map node and a buffer per attribute.
+    //
     // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
     //
     // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
@@ -543,12 +586,20 @@ private:
     // and we must not be in the middle of receiving reports for that cluster.
     struct ClusterState
     {
-        std::map<AttributeId, AttributeState> mAttributes;
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        std::vector<AttributeState> mAttributes;
+        std::vector<uint8_t> mData;
+        size_t mUnusedDataSize = 0; // Data of attributes that were updated since, reclaimed by CompactData()
         Optional<DataVersion> mPendingDataVersion;
         Optional<DataVersion> mCommittedDataVersion;
+
+        const uint8_t * GetData(const AttributeState & attributeState) const { return mData.data() + attributeState.mDataOffset; }
     };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    // Growing the vector of clusters only moves them, instead of copying their attributes and data, if this holds.
+    static_assert(std::is_nothrow_move_constructible<ClusterState>::value, "ClusterState moves must not throw");
+    // The clusters of all endpoints, sorted by endpoint ID and then cluster ID.
+    using NodeState = std::vector<ClusterState>;
 
     struct Comparator
     {
@@ -573,21 +624,40 @@ private:
     };
 
     /*
-     * These functions provide a way to index into the cached state with different sub-sets of a path, returning
-     * appropriate slices of the data as requested.
+     * Returns the position of the given cluster in the cache, or of the cluster that would follow it.
+     */
+    NodeState::const_iterator FindClusterPosition(EndpointId endpointId, ClusterId clusterId) const;
+    NodeState::iterator FindClusterPosition(EndpointId endpointId, ClusterId clusterId);
+
+    /*
+     * Returns the state of the given cluster, adding an empty one if there is none.
+     */
+    ClusterState & GetOrAddClusterState(EndpointId endpointId, ClusterId clusterId);
+
+    /*
+     * This function provides a way to index into the cached state with a cluster path, returning the state of that
+     * cluster.
      *
-     * In all variants, the respective slice is returned if a valid path is provided. 'err' is updated to reflect
-     * the status of the operation.
+     * The cluster state is returned if a valid path is provided. 'err' is updated to reflect the status of the
+     * operation.
      *
      * Notable status values:
      *      - If a cluster instance corresponding to endpointId and clusterId doesn't exist in the cache,
      *        CHIP_ERROR_KEY_NOT_FOUND shall be returned.
      *
      */
-    const EndpointState * GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const;
     const ClusterState * GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const;
-    const AttributeState * GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
-                                             CHIP_ERROR & err) const;
+
+    /*
+     * Binary search of an attribute in the attributes of a cluster, returning nullptr if it is not cached.
+     */
+    static const AttributeState * FindAttributeState(const ClusterState & clusterState, AttributeId attributeId);
+
+    /*
+     * Get the data or the status of an attribute of the cluster, with the return values of Get() and GetStatus().
+     */
+    static CHIP_ERROR GetAttributeData(const ClusterState & clusterState, AttributeId attributeId, TLV::TLVReader & reader);
+    static CHIP_ERROR GetAttributeStatus(const ClusterState & clusterState, AttributeId attributeId, StatusIB & status);
 
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
@@ -659,10 +729,25 @@ private:
     // on the wire if not all filters can be applied.
     void GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
 
-    CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize);
+    // Copy the element the reader is on into mEncodeBuffer with an anonymous tag, as it is stored in the cache.
+    CHIP_ERROR EncodeElement(const TLV::TLVReader & aData, ByteSpan & aEncoded);
+
+    // Set the state of an attribute of the cluster, storing aData in the data buffer of the cluster for kData.
+    void SetAttributeState(ClusterState & aClusterState, AttributeState & aAttributeState, const ByteSpan & aData);
+
+    // Drop the data of updated attributes and unused capacity from the data buffer of the cluster, if that saves enough.
+    static void CompactData(ClusterState & aClusterState);
+
+    // Publish a new snapshot if snapshots are enabled, copying the clusters in mUnpublishedClusters and sharing the
+    // others with the previous snapshot. If that fails, the clusters stay in mUnpublishedClusters for the next attempt.
+    void PublishSnapshot();
+
+    // Note that the cluster changed since the last published snapshot.
+    void MarkClusterUnpublished(EndpointId aEndpointId, ClusterId aClusterId);
 
     Callback & mCallback;
     NodeState mCache;
+    Platform::ScopedMemoryBufferWithSize<uint8_t> mEncodeBuffer;
     std::set<ConcreteAttributePath> mChangedAttributeSet;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
@@ -673,6 +758,79 @@ private:
     BufferedReadCallback mBufferedReader;
     ConcreteClusterPath mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     const bool mCacheData                   = true;
+
+    // Only written from the Matter thread, and read atomically by GetSnapshot().
+    SnapshotHandle mSnapshot;
+    bool mSnapshotsEnabled = false;
+    // Clusters changed since the last published snapshot, including by reports that ended without OnReportEnd().
+    std::set<std::tuple<EndpointId, ClusterId>> mUnpublishedClusters;
+};
+
+/*
+ * A snapshot holds the attributes of the cache as they were at the end of a report. It is published by the cache and
+ * never modified afterwards, so it can be read from any thread without locking.
+ *
+ * Each snapshot has a generation, which increases with every snapshot the cache publishes. The generation of a cluster
+ * is the generation of the snapshot in which the cluster last changed, so comparing it with the one seen in an earlier
+ * snapshot is a cheap way to know whether anything in the cluster changed since.
+ */
+class ClusterStateCache::Snapshot
+{
+public:
+    /*
+     * Get the value of an attribute, see ClusterStateCache::Get().
+     */
+    template <typename AttributeObjectTypeT>
+    CHIP_ERROR Get(const ConcreteAttributePath & path, typename AttributeObjectTypeT::DecodableType & value) const
+    {
+        TLV::TLVReader reader;
+
+        if (path.mClusterId != AttributeObjectTypeT::GetClusterId() || path.mAttributeId != AttributeObjectTypeT::GetAttributeId())
+        {
+            return CHIP_ERROR_SCHEMA_MISMATCH;
+        }
+
+        ReturnErrorOnFailure(Get(path, reader));
+        return DataModel::Decode(reader, value);
+    }
+
+    template <typename AttributeObjectTypeT>
+    CHIP_ERROR Get(EndpointId endpoint, typename AttributeObjectTypeT::DecodableType & value) const
+    {
+        ConcreteAttributePath path(endpoint, AttributeObjectTypeT::GetClusterId(), AttributeObjectTypeT::GetAttributeId());
+        return Get<AttributeObjectTypeT>(path, value);
+    }
+
+    CHIP_ERROR Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const;
+    CHIP_ERROR GetStatus(const ConcreteAttributePath & path, StatusIB & status) const;
+
+    /*
+     * Get the data version of a cluster, see ClusterStateCache::GetVersion().
+     */
+    CHIP_ERROR GetVersion(const ConcreteClusterPath & path, Optional<DataVersion> & aVersion) const;
+
+    /*
+     * Get the generation of the snapshot in which the cluster last changed.  If the cluster is not in the snapshot,
+     * CHIP_ERROR_KEY_NOT_FOUND shall be returned.
+     */
+    CHIP_ERROR GetClusterGeneration(const ConcreteClusterPath & path, uint64_t & aGeneration) const;
+
+    uint64_t GetGeneration() const { return mGeneration; }
+
+private:
+    friend class ClusterStateCache;
+
+    struct ClusterSnapshot
+    {
+        ClusterState mState;
+        uint64_t mGeneration;
+    };
+
+    const ClusterSnapshot * GetClusterSnapshot(EndpointId endpointId, ClusterId clusterId) const;
+
+    // Sorted by endpoint ID and then cluster ID, like the clusters of the cache.
+    std::vector<Platform::SharedPtr<const ClusterSnapshot>> mClusters;
+    uint64_t mGeneration = 0;
 };
 
 };     // namespace app
@@ -21,9 +21,15 @@
 namespace chip {
 namespace app {
 
-CHIP_ERROR DeferredAttribute::PrepareWrite(System::Clock::Timestamp flushTime, const ByteSpan & value)
+CHIP_ERROR DeferredAttribute::PrepareWrite(System::Clock::Timestamp flushTime, const ByteSpan & value,
+                                           System::Clock::Timestamp maxFlushTime)
 {
-    mFlushTime = flushTime;
+    if (!IsArmed())
+    {
+        mMaxFlushTime = maxFlushTime;
+    }
+
+    mFlushTime = chip::min(flushTime, mMaxFlushTime);
 
     if (mValue.AllocatedSize() != value.size())
     {
@@ -35,6 +41,12 @@ CHIP_ERROR DeferredAttribute::PrepareWrite(System::Clock::Timestamp flushTime, c
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR DeferredAttribute::ReadPendingValue(MutableByteSpan & value) const
+{
+    VerifyOrReturnError(IsArmed(), CHIP_ERROR_NOT_FOUND);
+    return CopySpanToMutableSpan(ByteSpan(mValue.Get(), mValue.AllocatedSize()), value);
+}
+
 void DeferredAttribute::Flush(AttributePersistenceProvider & persister)
 {
     VerifyOrReturn(IsArmed());
@@ -48,7 +60,10 @@ CHIP_ERROR DeferredAttributePersistenceProvider::WriteValue(const ConcreteAttrib
     {
         if (da.Matches(aPath))
         {
-            ReturnErrorOnFailure(da.PrepareWrite(System::SystemClock().GetMonotonicTimestamp() + mWriteDelay, aValue));
+            const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+            const System::Clock::Timestamp maxFlushTime =
+                mMaxWriteDelay == System::Clock::kZero ? System::Clock::Timestamp::max() : now + mMaxWriteDelay;
+            ReturnErrorOnFailure(da.PrepareWrite(now + mWriteDelay, aValue, maxFlushTime));
             FlushAndScheduleNext();
             return CHIP_NO_ERROR;
         }
@@ -60,6 +75,14 @@ CHIP_ERROR DeferredAttributePersistenceProvider::WriteValue(const ConcreteAttrib
 CHIP_ERROR DeferredAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & aPath,
                                                            const EmberAfAttributeMetadata * aMetadata, MutableByteSpan & aValue)
 {
+    for (DeferredAttribute & da : mDeferredAttributes)
+    {
+        if (da.Matches(aPath) && da.IsArmed())
+        {
+            return da.ReadPendingValue(aValue);
+        }
+    }
+
     return mPersister.ReadValue(aPath, aMetadata, aValue);
 }
 
@@ -31,12 +31,19 @@ public:
     bool IsArmed() const { return static_cast<bool>(mValue); }
     System::Clock::Timestamp GetFlushTime() const { return mFlushTime; }
 
-    CHIP_ERROR PrepareWrite(System::Clock::Timestamp flushTime, const ByteSpan & value);
+    /*
+     * Store the value to be written at flushTime. If no value is pending yet, maxFlushTime is the
+     * latest time at which this value or any later one replacing it is written.
+     */
+    CHIP_ERROR PrepareWrite(System::Clock::Timestamp flushTime, const ByteSpan & value,
+                            System::Clock::Timestamp maxFlushTime = System::Clock::Timestamp::max());
+    CHIP_ERROR ReadPendingValue(MutableByteSpan & value) const;
     void Flush(AttributePersistenceProvider & persister);
 
 private:
     const ConcreteAttributePath mPath;
     System::Clock::Timestamp mFlushTime;
+    System::Clock::Timestamp mMaxFlushTime;
     Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
 };
 
@@ -53,9 +60,10 @@ class DeferredAttributePersistenceProvider : public AttributePersistenceProvider
 public:
     DeferredAttributePersistenceProvider(AttributePersistenceProvider & persister,
                                          const Span<DeferredAttribute> & deferredAttributes,
-                                         System::Clock::Milliseconds32 writeDelay) :
+                                         System::Clock::Milliseconds32 writeDelay,
+                                         System::Clock::Milliseconds32 maxWriteDelay = System::Clock::kZero) :
         mPersister(persister),
-        mDeferredAttributes(deferredAttributes), mWriteDelay(writeDelay)
+        mDeferredAttributes(deferredAttributes), mWriteDelay(writeDelay), mMaxWriteDelay(maxWriteDelay)
     {}
 
     /*
@@ -64,9 +72,18 @@ public:
      * delay period, further postpone the operation so that the actual write happens once the
      * attribute has remained constant for the write delay period.
      *
+     * If a non-zero maximum write delay is configured, an attribute that keeps changing is still
+     * written no later than the maximum write delay after its first unwritten change. Only the
+     * latest value is written in either case.
+     *
      * For other attributes, immediately pass the write operation to the decorated persister.
      */
     CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
+
+    /*
+     * If the read attribute is one of the deferred attributes and its write is still pending,
+     * return the pending value. Otherwise, pass the read operation to the decorated persister.
+     */
     CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                          MutableByteSpan & aValue) override;
 
@@ -76,6 +93,7 @@ private:
     AttributePersistenceProvider & mPersister;
     const Span<DeferredAttribute> mDeferredAttributes;
     const System::Clock::Milliseconds32 mWriteDelay;
+    const System::Clock::Milliseconds32 mMaxWriteDelay;
 };
 
 } // namespace app
@@ -975,10 +975,45 @@ void InteractionModelEngine::AddReadClient(ReadClient * apReadClient)
 }
 #endif // CHIP_CONFIG_ENABLE_READ_CLIENT
 
+bool InteractionModelEngine::AllowUnlimitedSubscriptions() const
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    return !mForceHandlerQuota;
+#else  // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+       // If the resources are allocated on the heap, we should be able to handle as many Read / Subscribe requests as possible.
+    return true;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+#else  // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
+    return false;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
+}
+
+size_t InteractionModelEngine::GetPathCapForSubscriptions() const
+{
+    if (!AllowUnlimitedSubscriptions())
+    {
+        return GetPathPoolCapacityForSubscriptions();
+    }
+
+    // Paths are not limited by pools, but may still be shared fairly between fabrics.
+    const size_t pathQuotaPerFabric = GetPathQuotaPerFabricForSubscriptions();
+    if (pathQuotaPerFabric == 0 || pathQuotaPerFabric > SIZE_MAX / GetConfigMaxFabrics())
+    {
+        return SIZE_MAX;
+    }
+    return pathQuotaPerFabric * GetConfigMaxFabrics();
+}
+
+size_t InteractionModelEngine::GetReadHandlerCapForSubscriptions() const
+{
+    return AllowUnlimitedSubscriptions() ? SIZE_MAX : GetReadHandlerPoolCapacityForSubscriptions();
+}
+
 bool InteractionModelEngine::TrimFabricForSubscriptions(FabricIndex aFabricIndex, bool aForceEvict)
 {
-    const size_t pathPoolCapacity        = GetPathPoolCapacityForSubscriptions();
-    const size_t readHandlerPoolCapacity = GetReadHandlerPoolCapacityForSubscriptions();
+    const size_t pathPoolCapacity        = GetPathCapForSubscriptions();
+    const size_t readHandlerPoolCapacity = GetReadHandlerCapForSubscriptions();
 
     uint8_t fabricCount                            = mpFabricTable->FabricCount();
     size_t attributePathsSubscribedByCurrentFabric = 0;
@@ -1054,26 +1089,11 @@ bool InteractionModelEngine::TrimFabricForSubscriptions(FabricIndex aFabricIndex
 bool InteractionModelEngine::EnsureResourceForSubscription(FabricIndex aFabricIndex, size_t aRequestedAttributePathCount,
                                                            size_t aRequestedEventPathCount)
 {
-#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
-#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
-    const bool allowUnlimited = !mForceHandlerQuota;
-#else  // CONFIG_BUILD_FOR_HOST_UNIT_TEST
-       // If the resources are allocated on the heap, we should be able to handle as many Read / Subscribe requests as possible.
-    const bool allowUnlimited = true;
-#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
-#else  // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
-    const bool allowUnlimited = false;
-#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
-
     // Don't couple with read requests, always reserve enough resource for read requests.
 
-    const size_t pathPoolCapacity        = GetPathPoolCapacityForSubscriptions();
-    const size_t readHandlerPoolCapacity = GetReadHandlerPoolCapacityForSubscriptions();
-
-    // If we return early here, the compiler will complain about the unreachable code, so we add a always-true check.
-    const size_t attributePathCap = allowUnlimited ? SIZE_MAX : pathPoolCapacity;
-    const size_t eventPathCap     = allowUnlimited ? SIZE_MAX : pathPoolCapacity;
-    const size_t readHandlerCap   = allowUnlimited ? SIZE_MAX : readHandlerPoolCapacity;
+    const size_t attributePathCap = GetPathCapForSubscriptions();
+    const size_t eventPathCap     = GetPathCapForSubscriptions();
+    const size_t readHandlerCap   = GetReadHandlerCapForSubscriptions();
 
     size_t usedAttributePaths = 0;
     size_t usedEventPaths     = 0;
@@ -1448,15 +1468,17 @@ bool InteractionModelEngine::HasConflictWriteRequests(const WriteHandler * apWri
     return false;
 }
 
-void InteractionModelEngine::ReleaseAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList)
+void InteractionModelEngine::ReleaseAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList,
+                                                      ObjectListArena<AttributePathParams> * apArena)
 {
-    ReleasePool(aAttributePathList, mAttributePathPool);
+    ReleasePool(aAttributePathList, mAttributePathPool, apArena);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList,
-                                                              AttributePathParams & aAttributePath)
+                                                              AttributePathParams & aAttributePath,
+                                                              ObjectListArena<AttributePathParams> * apArena)
 {
-    CHIP_ERROR err = PushFront(aAttributePathList, aAttributePath, mAttributePathPool);
+    CHIP_ERROR err = PushFront(aAttributePathList, aAttributePath, mAttributePathPool, apArena);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "AttributePath pool full");
@@ -1465,7 +1487,8 @@ CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(ObjectList<Attribu
     return err;
 }
 
-void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(ObjectList<AttributePathParams> *& aAttributePaths)
+void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(ObjectList<AttributePathParams> *& aAttributePaths,
+                                                                  ObjectListArena<AttributePathParams> * apArena)
 {
     ObjectList<AttributePathParams> * prev = nullptr;
     auto * path1                           = aAttributePaths;
@@ -1508,27 +1531,29 @@ void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(ObjectList<Att
         if (path1 == aAttributePaths)
         {
             aAttributePaths = path1->mpNext;
-            mAttributePathPool.ReleaseObject(path1);
+            ReleaseNode(path1, mAttributePathPool, apArena);
             path1 = aAttributePaths;
         }
         else
         {
             prev->mpNext = path1->mpNext;
-            mAttributePathPool.ReleaseObject(path1);
+            ReleaseNode(path1, mAttributePathPool, apArena);
             path1 = prev->mpNext;
         }
     }
 }
 
-void InteractionModelEngine::ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList)
+void InteractionModelEngine::ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList,
+                                                  ObjectListArena<EventPathParams> * apArena)
 {
-    ReleasePool(aEventPathList, mEventPathPool);
+    ReleasePool(aEventPathList, mEventPathPool, apArena);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(ObjectList<EventPathParams> *& aEventPathList,
-                                                                EventPathParams & aEventPath)
+                                                                EventPathParams & aEventPath,
+                                                                ObjectListArena<EventPathParams> * apArena)
 {
-    CHIP_ERROR err = PushFront(aEventPathList, aEventPath, mEventPathPool);
+    CHIP_ERROR err = PushFront(aEventPathList, aEventPath, mEventPathPool, apArena);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "EventPath pool full");
@@ -1537,15 +1562,17 @@ CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(ObjectList<Event
     return err;
 }
 
-void InteractionModelEngine::ReleaseDataVersionFilterList(ObjectList<DataVersionFilter> *& aDataVersionFilterList)
+void InteractionModelEngine::ReleaseDataVersionFilterList(ObjectList<DataVersionFilter> *& aDataVersionFilterList,
+                                                          ObjectListArena<DataVersionFilter> * apArena)
 {
-    ReleasePool(aDataVersionFilterList, mDataVersionFilterPool);
+    ReleasePool(aDataVersionFilterList, mDataVersionFilterPool, apArena);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontDataVersionFilterList(ObjectList<DataVersionFilter> *& aDataVersionFilterList,
-                                                                  DataVersionFilter & aDataVersionFilter)
+                                                                  DataVersionFilter & aDataVersionFilter,
+                                                                  ObjectListArena<DataVersionFilter> * apArena)
 {
-    CHIP_ERROR err = PushFront(aDataVersionFilterList, aDataVersionFilter, mDataVersionFilterPool);
+    CHIP_ERROR err = PushFront(aDataVersionFilterList, aDataVersionFilter, mDataVersionFilterPool, apArena);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "DataVersionFilter pool full, ignore this filter");
@@ -1555,13 +1582,14 @@ CHIP_ERROR InteractionModelEngine::PushFrontDataVersionFilterList(ObjectList<Dat
 }
 
 template <typename T, size_t N>
-void InteractionModelEngine::ReleasePool(ObjectList<T> *& aObjectList, ObjectPool<ObjectList<T>, N> & aObjectPool)
+void InteractionModelEngine::ReleasePool(ObjectList<T> *& aObjectList, ObjectPool<ObjectList<T>, N> & aObjectPool,
+                                         ObjectListArena<T> * apArena)
 {
     ObjectList<T> * current = aObjectList;
     while (current != nullptr)
     {
         ObjectList<T> * nextObject = current->mpNext;
-        aObjectPool.ReleaseObject(current);
+        ReleaseNode(current, aObjectPool, apArena);
         current = nextObject;
     }
 
@@ -1569,9 +1597,25 @@ void InteractionModelEngine::ReleasePool(ObjectList<T> *& aObjectList, ObjectPoo
 }
 
 template <typename T, size_t N>
-CHIP_ERROR InteractionModelEngine::PushFront(ObjectList<T> *& aObjectList, T & aData, ObjectPool<ObjectList<T>, N> & aObjectPool)
+void InteractionModelEngine::ReleaseNode(ObjectList<T> * aObject, ObjectPool<ObjectList<T>, N> & aObjectPool,
+                                         ObjectListArena<T> * apArena)
 {
-    ObjectList<T> * object = aObjectPool.CreateObject();
+    // Nodes from an arena are released with the whole arena.
+    if (apArena == nullptr || !apArena->Contains(aObject))
+    {
+        aObjectPool.ReleaseObject(aObject);
+    }
+}
+
+template <typename T, size_t N>
+CHIP_ERROR InteractionModelEngine::PushFront(ObjectList<T> *& aObjectList, T & aData, ObjectPool<ObjectList<T>, N> & aObjectPool,
+                                             ObjectListArena<T> * apArena)
+{
+    ObjectList<T> * object = (apArena != nullptr) ? apArena->Allocate() : nullptr;
+    if (object == nullptr)
+    {
+        object = aObjectPool.CreateObject();
+    }
     if (object == nullptr)
     {
         return CHIP_ERROR_NO_MEMORY;
@@ -51,6 +51,7 @@
 #include <app/DataVersionFilter.h>
 #include <app/EventPathParams.h>
 #include <app/ObjectList.h>
+#include <app/ObjectListArena.h>
 #include <app/ReadClient.h>
 #include <app/ReadHandler.h>
 #include <app/StatusResponse.h>
@@ -184,23 +185,32 @@ public:
 
     reporting::ReportScheduler * GetReportScheduler() { return mReportScheduler; }
 
-    void ReleaseAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList);
+    // The path and filter lists below take their nodes from apArena while it has room, and from the engine's pools
+    // otherwise. A list holding nodes from an arena must be released and trimmed with that same arena.
+
+    void ReleaseAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList,
+                                  ObjectListArena<AttributePathParams> * apArena = nullptr);
 
     CHIP_ERROR PushFrontAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList,
-                                          AttributePathParams & aAttributePath);
+                                          AttributePathParams & aAttributePath,
+                                          ObjectListArena<AttributePathParams> * apArena = nullptr);
 
     // If a concrete path indicates an attribute that is also referenced by a wildcard path in the request,
     // the path SHALL be removed from the list.
-    void RemoveDuplicateConcreteAttributePath(ObjectList<AttributePathParams> *& aAttributePaths);
+    void RemoveDuplicateConcreteAttributePath(ObjectList<AttributePathParams> *& aAttributePaths,
+                                              ObjectListArena<AttributePathParams> * apArena = nullptr);
 
-    void ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList);
+    void ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList, ObjectListArena<EventPathParams> * apArena = nullptr);
 
-    CHIP_ERROR PushFrontEventPathParamsList(ObjectList<EventPathParams> *& aEventPathList, EventPathParams & aEventPath);
+    CHIP_ERROR PushFrontEventPathParamsList(ObjectList<EventPathParams> *& aEventPathList, EventPathParams & aEventPath,
+                                            ObjectListArena<EventPathParams> * apArena = nullptr);
 
-    void ReleaseDataVersionFilterList(ObjectList<DataVersionFilter> *& aDataVersionFilterList);
+    void ReleaseDataVersionFilterList(ObjectList<DataVersionFilter> *& aDataVersionFilterList,
+                                      ObjectListArena<DataVersionFilter> * apArena = nullptr);
 
     CHIP_ERROR PushFrontDataVersionFilterList(ObjectList<DataVersionFilter> *& aDataVersionFilterList,
-                                              DataVersionFilter & aDataVersionFilter);
+                                              DataVersionFilter & aDataVersionFilter,
+                                              ObjectListArena<DataVersionFilter> * apArena = nullptr);
 
     CHIP_ERROR RegisterCommandHandler(CommandHandlerInterface * handler);
     CHIP_ERROR UnregisterCommandHandler(CommandHandlerInterface * handler);
@@ -341,6 +351,14 @@ public:
     void SetPathPoolCapacityForReads(int32_t sz) { mPathPoolCapacityForReadsOverride = sz; }
     void SetPathPoolCapacityForSubscriptions(int32_t sz) { mPathPoolCapacityForSubscriptionsOverride = sz; }
 
+    //
+    // Override CHIP_IM_SERVER_SUBSCRIPTION_PATHS_PER_FABRIC_ON_HEAP, which applies when the resources are not limited
+    // by the pools (see SetForceHandlerQuota).
+    //
+    // If -1 is passed in, no override is instituted and default behavior resumes.
+    //
+    void SetPathQuotaPerFabricForSubscriptions(int32_t sz) { mPathQuotaPerFabricForSubscriptionsOverride = sz; }
+
     //
     // We won't limit the handler used per fabric on platforms that are using heap for memory pools, so we introduces a flag to
     // enforce such check based on the configured size. This flag is used for unit tests only, there is another compare time flag
@@ -494,6 +512,17 @@ private:
 #endif
     }
 
+    inline size_t GetPathQuotaPerFabricForSubscriptions() const
+    {
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+        return (mPathQuotaPerFabricForSubscriptionsOverride == -1)
+            ? CHIP_IM_SERVER_SUBSCRIPTION_PATHS_PER_FABRIC_ON_HEAP
+            : static_cast<size_t>(mPathQuotaPerFabricForSubscriptionsOverride);
+#else
+        return CHIP_IM_SERVER_SUBSCRIPTION_PATHS_PER_FABRIC_ON_HEAP;
+#endif
+    }
+
     inline size_t GetReadHandlerPoolCapacityForSubscriptions() const
     {
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
@@ -519,6 +548,24 @@ private:
         return GetReadHandlerPoolCapacityForReads() / GetConfigMaxFabrics();
     }
 
+    /**
+     * Whether subscriptions may use as many resources as they request, which is the case when the resources are allocated on
+     * the heap, unless the quota check is forced.
+     */
+    bool AllowUnlimitedSubscriptions() const;
+
+    /**
+     * The number of attribute paths, and of event paths, all subscriptions may use before subscriptions of the fabrics using
+     * more than their share are evicted. SIZE_MAX when unlimited.
+     */
+    size_t GetPathCapForSubscriptions() const;
+
+    /**
+     * The number of subscriptions that may be established before subscriptions of the fabrics using more than their share are
+     * evicted. SIZE_MAX when unlimited.
+     */
+    size_t GetReadHandlerCapForSubscriptions() const;
+
     /**
      * Verify and ensure (by killing oldest read handlers that make the resources used by the current fabric exceed the fabric
      * quota)
@@ -567,9 +614,12 @@ private:
     static void ResumeSubscriptionsTimerCallback(System::Layer * apSystemLayer, void * apAppState);
 
     template <typename T, size_t N>
-    void ReleasePool(ObjectList<T> *& aObjectList, ObjectPool<ObjectList<T>, N> & aObjectPool);
+    void ReleasePool(ObjectList<T> *& aObjectList, ObjectPool<ObjectList<T>, N> & aObjectPool, ObjectListArena<T> * apArena);
+    template <typename T, size_t N>
+    void ReleaseNode(ObjectList<T> * aObject, ObjectPool<ObjectList<T>, N> & aObjectPool, ObjectListArena<T> * apArena);
     template <typename T, size_t N>
-    CHIP_ERROR PushFront(ObjectList<T> *& aObjectList, T & aData, ObjectPool<ObjectList<T>, N> & aObjectPool);
+    CHIP_ERROR PushFront(ObjectList<T> *& aObjectList, T & aData, ObjectPool<ObjectList<T>, N> & aObjectPool,
+                         ObjectListArena<T> * apArena);
 
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
 
@@ -618,6 +668,7 @@ private:
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     int mReadHandlerCapacityForSubscriptionsOverride = -1;
     int mPathPoolCapacityForSubscriptionsOverride    = -1;
+    int mPathQuotaPerFabricForSubscriptionsOverride  = -1;
 
     int mReadHandlerCapacityForReadsOverride = -1;
     int mPathPoolCapacityForReadsOverride    = -1;
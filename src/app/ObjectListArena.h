@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ObjectList.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemConfig.h>
+
+#include <functional>
+#include <new>
+#include <stddef.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * A single block holding the nodes of an ObjectList built in one go, such as the paths of a read or subscribe request, so
+ * that walking the list reads adjacent memory rather than nodes scattered over a pool.
+ *
+ * Nodes are handed out from the end of the block towards its start, so a list built with PushFront is laid out in list
+ * order. Nodes cannot be released one by one: the whole block is released by Release() or the destructor, after the list
+ * has been unlinked.
+ *
+ * The block is only allocated when memory pools use the heap. Otherwise Reserve() does nothing and Allocate() always returns
+ * nullptr, so that the nodes keep coming from the fixed pools.
+ */
+template <typename T>
+class ObjectListArena
+{
+public:
+    ObjectListArena() = default;
+    ~ObjectListArena() { Release(); }
+
+    ObjectListArena(const ObjectListArena &)             = delete;
+    ObjectListArena & operator=(const ObjectListArena &) = delete;
+
+    /**
+     * Release the current block, if any, and allocate one for aCount nodes.
+     */
+    CHIP_ERROR Reserve(size_t aCount)
+    {
+        Release();
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        VerifyOrReturnError(aCount > 0, CHIP_NO_ERROR);
+        VerifyOrReturnError(aCount <= SIZE_MAX / sizeof(ObjectList<T>), CHIP_ERROR_NO_MEMORY);
+        mNodes = static_cast<ObjectList<T> *>(Platform::MemoryAlloc(aCount * sizeof(ObjectList<T>)));
+        VerifyOrReturnError(mNodes != nullptr, CHIP_ERROR_NO_MEMORY);
+        mCapacity = aCount;
+        mFree     = aCount;
+#else
+        IgnoreUnusedVariable(aCount);
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Returns a new node from the block, or nullptr if the block is used up.
+     */
+    ObjectList<T> * Allocate()
+    {
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        VerifyOrReturnValue(mFree > 0, nullptr);
+        return new (&mNodes[--mFree]) ObjectList<T>();
+#else
+        return nullptr;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    }
+
+    /**
+     * Returns whether the node was allocated from this arena, rather than from a pool.
+     */
+    bool Contains(const ObjectList<T> * aNode) const
+    {
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        return mNodes != nullptr && !std::less<const ObjectList<T> *>()(aNode, mNodes) &&
+            std::less<const ObjectList<T> *>()(aNode, mNodes + mCapacity);
+#else
+        IgnoreUnusedVariable(aNode);
+        return false;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    }
+
+    void Release()
+    {
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        for (size_t i = mFree; i < mCapacity; i++)
+        {
+            mNodes[i].~ObjectList<T>();
+        }
+        Platform::MemoryFree(mNodes);
+        mNodes    = nullptr;
+        mCapacity = 0;
+        mFree     = 0;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    }
+
+private:
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    ObjectList<T> * mNodes = nullptr;
+    size_t mCapacity       = 0;
+    size_t mFree           = 0;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+};
+
+} // namespace app
+} // namespace chip
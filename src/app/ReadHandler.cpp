@@ -43,6 +43,22 @@ namespace chip {
 namespace app {
 using Status = Protocols::InteractionModel::Status;
 
+namespace {
+
+/// @brief Size an arena for the elements of the list the reader is in, so that the list is stored contiguously
+template <typename T>
+void ReserveArena(ObjectListArena<T> & aArena, const TLV::TLVReader & aReader)
+{
+    size_t count = 0;
+    // Malformed lists are rejected while parsing them, and the nodes that do not fit come from the engine's pools.
+    if (TLV::Utilities::Count(aReader, count, false) == CHIP_NO_ERROR)
+    {
+        LogErrorOnFailure(aArena.Reserve(count));
+    }
+}
+
+} // namespace
+
 uint16_t ReadHandler::GetPublisherSelectedIntervalLimit()
 {
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
@@ -103,22 +119,26 @@ void ReadHandler::ResumeSubscription(CASESessionManager & caseSessionManager,
     SetStateFlag(ReadHandlerFlags::FabricFiltered, subscriptionInfo.mFabricFiltered);
 
     // Move dynamically allocated attributes and events from the SubscriptionInfo struct into
-    // the object pool managed by the IM engine
+    // the arenas or, for the paths that do not fit, the object pool managed by the IM engine
+    LogErrorOnFailure(mAttributePathArena.Reserve(subscriptionInfo.mAttributePaths.AllocatedSize()));
+    LogErrorOnFailure(mEventPathArena.Reserve(subscriptionInfo.mEventPaths.AllocatedSize()));
     for (size_t i = 0; i < subscriptionInfo.mAttributePaths.AllocatedSize(); i++)
     {
         AttributePathParams attributePathParams = subscriptionInfo.mAttributePaths[i].GetParams();
-        CHIP_ERROR err =
-            InteractionModelEngine::GetInstance()->PushFrontAttributePathList(mpAttributePathList, attributePathParams);
+        CHIP_ERROR err = InteractionModelEngine::GetInstance()->PushFrontAttributePathList(mpAttributePathList, attributePathParams,
+                                                                                           &mAttributePathArena);
         if (err != CHIP_NO_ERROR)
         {
             Close();
             return;
         }
     }
+    InteractionModelEngine::GetInstance()->GetReportingEngine().AddAttributePathInterest(*this);
     for (size_t i = 0; i < subscriptionInfo.mEventPaths.AllocatedSize(); i++)
     {
         EventPathParams eventPathParams = subscriptionInfo.mEventPaths[i].GetParams();
-        CHIP_ERROR err = InteractionModelEngine::GetInstance()->PushFrontEventPathParamsList(mpEventPathList, eventPathParams);
+        CHIP_ERROR err =
+            InteractionModelEngine::GetInstance()->PushFrontEventPathParamsList(mpEventPathList, eventPathParams, &mEventPathArena);
         if (err != CHIP_NO_ERROR)
         {
             Close();
@@ -147,9 +167,10 @@ ReadHandler::~ReadHandler()
     {
         InteractionModelEngine::GetInstance()->GetReportingEngine().OnReportConfirm();
     }
-    InteractionModelEngine::GetInstance()->ReleaseAttributePathList(mpAttributePathList);
-    InteractionModelEngine::GetInstance()->ReleaseEventPathList(mpEventPathList);
-    InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
+    InteractionModelEngine::GetInstance()->GetReportingEngine().RemoveAttributePathInterest(*this);
+    InteractionModelEngine::GetInstance()->ReleaseAttributePathList(mpAttributePathList, &mAttributePathArena);
+    InteractionModelEngine::GetInstance()->ReleaseEventPathList(mpEventPathList, &mEventPathArena);
+    InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList, &mDataVersionFilterArena);
 }
 
 void ReadHandler::Close(CloseOptions options)
@@ -342,7 +363,8 @@ CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, b
     {
         mPreviousReportsBeginGeneration = mCurrentReportsBeginGeneration;
         ClearForceDirtyFlag();
-        InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
+        InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList, &mDataVersionFilterArena);
+        mDataVersionFilterArena.Release();
     }
 
     return err;
@@ -471,6 +493,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     CHIP_ERROR err = CHIP_NO_ERROR;
     TLV::TLVReader reader;
     aAttributePathListParser.GetReader(&reader);
+    ReserveArena(mAttributePathArena, reader);
     while (CHIP_NO_ERROR == (err = reader.Next()))
     {
         VerifyOrReturnError(TLV::AnonymousTag() == reader.GetTag(), CHIP_ERROR_INVALID_TLV_TAG);
@@ -478,12 +501,14 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
         AttributePathIB::Parser path;
         ReturnErrorOnFailure(path.Init(reader));
         ReturnErrorOnFailure(path.ParsePath(attribute));
-        ReturnErrorOnFailure(InteractionModelEngine::GetInstance()->PushFrontAttributePathList(mpAttributePathList, attribute));
+        ReturnErrorOnFailure(InteractionModelEngine::GetInstance()->PushFrontAttributePathList(mpAttributePathList, attribute,
+                                                                                               &mAttributePathArena));
     }
     // if we have exhausted this container
     if (CHIP_END_OF_TLV == err)
     {
-        InteractionModelEngine::GetInstance()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
+        InteractionModelEngine::GetInstance()->RemoveDuplicateConcreteAttributePath(mpAttributePathList, &mAttributePathArena);
+        InteractionModelEngine::GetInstance()->GetReportingEngine().AddAttributePathInterest(*this);
         mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
         err                          = CHIP_NO_ERROR;
     }
@@ -496,6 +521,7 @@ CHIP_ERROR ReadHandler::ProcessDataVersionFilterList(DataVersionFilterIBs::Parse
     TLV::TLVReader reader;
 
     aDataVersionFilterListParser.GetReader(&reader);
+    ReserveArena(mDataVersionFilterArena, reader);
     while (CHIP_NO_ERROR == (err = reader.Next()))
     {
         VerifyOrReturnError(TLV::AnonymousTag() == reader.GetTag(), CHIP_ERROR_INVALID_TLV_TAG);
@@ -510,8 +536,8 @@ CHIP_ERROR ReadHandler::ProcessDataVersionFilterList(DataVersionFilterIBs::Parse
         ReturnErrorOnFailure(path.GetEndpoint(&(versionFilter.mEndpointId)));
         ReturnErrorOnFailure(path.GetCluster(&(versionFilter.mClusterId)));
         VerifyOrReturnError(versionFilter.IsValidDataVersionFilter(), CHIP_ERROR_IM_MALFORMED_DATA_VERSION_FILTER_IB);
-        ReturnErrorOnFailure(
-            InteractionModelEngine::GetInstance()->PushFrontDataVersionFilterList(mpDataVersionFilterList, versionFilter));
+        ReturnErrorOnFailure(InteractionModelEngine::GetInstance()->PushFrontDataVersionFilterList(
+            mpDataVersionFilterList, versionFilter, &mDataVersionFilterArena));
     }
 
     if (CHIP_END_OF_TLV == err)
@@ -526,6 +552,7 @@ CHIP_ERROR ReadHandler::ProcessEventPaths(EventPathIBs::Parser & aEventPathsPars
     CHIP_ERROR err = CHIP_NO_ERROR;
     TLV::TLVReader reader;
     aEventPathsParser.GetReader(&reader);
+    ReserveArena(mEventPathArena, reader);
     while (CHIP_NO_ERROR == (err = reader.Next()))
     {
         VerifyOrReturnError(TLV::AnonymousTag() == reader.GetTag(), CHIP_ERROR_INVALID_TLV_TAG);
@@ -533,7 +560,8 @@ CHIP_ERROR ReadHandler::ProcessEventPaths(EventPathIBs::Parser & aEventPathsPars
         EventPathIB::Parser path;
         ReturnErrorOnFailure(path.Init(reader));
         ReturnErrorOnFailure(path.ParsePath(event));
-        ReturnErrorOnFailure(InteractionModelEngine::GetInstance()->PushFrontEventPathParamsList(mpEventPathList, event));
+        ReturnErrorOnFailure(
+            InteractionModelEngine::GetInstance()->PushFrontEventPathParamsList(mpEventPathList, event, &mEventPathArena));
     }
 
     // if we have exhausted this container
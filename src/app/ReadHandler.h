@@ -37,6 +37,7 @@
 #include <app/MessageDef/EventFilterIBs.h>
 #include <app/MessageDef/EventPathIBs.h>
 #include <app/ObjectList.h>
+#include <app/ObjectListArena.h>
 #include <app/OperationalSessionSetup.h>
 #include <app/SubscriptionResumptionStorage.h>
 #include <lib/core/CHIPCallback.h>
@@ -66,6 +67,7 @@ class Engine;
 class TestReportingEngine;
 class ReportScheduler;
 class TestReportScheduler;
+class ReportSchedulerBenchmark;
 } // namespace reporting
 
 class InteractionModelEngine;
@@ -289,6 +291,10 @@ private:
 
         // Don't need the response for report data if true
         SuppressResponse = (1 << 5),
+
+        // The attribute paths could not be added to the reporting engine's interest index, so the engine has to check
+        // them directly whenever an attribute is marked dirty.
+        AttributePathsUnindexed = (1 << 6),
     };
 
     /**
@@ -421,6 +427,7 @@ private:
     friend class TestReadInteraction;
     friend class chip::app::reporting::TestReportingEngine;
     friend class chip::app::reporting::TestReportScheduler;
+    friend class chip::app::reporting::ReportSchedulerBenchmark;
 
     //
     // The engine needs to be able to Abort/Close a ReadHandler instance upon completion of work for a given read/subscribe
@@ -555,6 +562,11 @@ private:
     ObjectList<EventPathParams> * mpEventPathList           = nullptr;
     ObjectList<DataVersionFilter> * mpDataVersionFilterList = nullptr;
 
+    // Contiguous storage for the nodes of the lists above, sized from the request when it is processed.
+    ObjectListArena<AttributePathParams> mAttributePathArena;
+    ObjectListArena<EventPathParams> mEventPathArena;
+    ObjectListArena<DataVersionFilter> mDataVersionFilterArena;
+
     ManagementCallback & mManagementCallback;
 
     uint32_t mLastWrittenEventsBytes = 0;
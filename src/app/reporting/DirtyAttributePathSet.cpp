@@ -0,0 +1,309 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/DirtyAttributePathSet.h>
+
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+const uint64_t * DirtyAttributePathSet::Find(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) const
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    auto it = mEntries.find(Key(aEndpointId, aClusterId, aAttributeId));
+    return (it != mEntries.end()) ? &it->second : nullptr;
+#else
+    size_t index = LowerBound(aEndpointId, aClusterId, aAttributeId);
+    if (index < mSize && mEntries[index].mEndpointId == aEndpointId && mEntries[index].mClusterId == aClusterId &&
+        mEntries[index].mAttributeId == aAttributeId)
+    {
+        return &mEntries[index].mGeneration;
+    }
+    return nullptr;
+#endif
+}
+
+uint64_t * DirtyAttributePathSet::Find(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+{
+    return const_cast<uint64_t *>(static_cast<const DirtyAttributePathSet *>(this)->Find(aEndpointId, aClusterId, aAttributeId));
+}
+
+bool DirtyAttributePathSet::IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const
+{
+    // The paths in the set that are supersets of a concrete path are filed under one of these eight keys.
+    for (uint8_t wildcards = 0; wildcards < 8; wildcards++)
+    {
+        const uint64_t * generation = Find((wildcards & 1) ? kInvalidEndpointId : aPath.mEndpointId,
+                                           (wildcards & 2) ? kInvalidClusterId : aPath.mClusterId,
+                                           (wildcards & 4) ? kInvalidAttributeId : aPath.mAttributeId);
+        if (generation != nullptr && *generation > aGeneration)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+void DirtyAttributePathSet::RemoveSubsetsOf(const AttributePathParams & aPath)
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();)
+    {
+        if (aPath.IsAttributePathSupersetOf(
+                AttributePathParams(std::get<0>(it->first), std::get<1>(it->first), std::get<2>(it->first))))
+        {
+            it = mEntries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void DirtyAttributePathSet::RemoveUpTo(uint64_t aGeneration)
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();)
+    {
+        if (it->second <= aGeneration)
+        {
+            it = mEntries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void DirtyAttributePathSet::Insert(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    uint64_t * generation = Find(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    if (generation != nullptr)
+    {
+        *generation = aGeneration;
+        return;
+    }
+
+    if (aPath.IsWildcardPath())
+    {
+        // The paths covered by the new one are older than it, so they no longer affect IsDirtySince.
+        RemoveSubsetsOf(aPath);
+    }
+
+    mEntries.emplace(Key(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId), aGeneration);
+}
+
+#else
+
+namespace {
+
+bool IsOrderedBefore(const DirtyAttributePathSet::Entry & aEntry, EndpointId aEndpointId, ClusterId aClusterId,
+                     AttributeId aAttributeId)
+{
+    if (aEntry.mEndpointId != aEndpointId)
+    {
+        return aEntry.mEndpointId < aEndpointId;
+    }
+    if (aEntry.mClusterId != aClusterId)
+    {
+        return aEntry.mClusterId < aClusterId;
+    }
+    return aEntry.mAttributeId < aAttributeId;
+}
+
+} // namespace
+
+size_t DirtyAttributePathSet::LowerBound(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) const
+{
+    size_t begin = 0;
+    size_t end   = mSize;
+    while (begin < end)
+    {
+        size_t middle = begin + (end - begin) / 2;
+        if (IsOrderedBefore(mEntries[middle], aEndpointId, aClusterId, aAttributeId))
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    return begin;
+}
+
+uint64_t * DirtyAttributePathSet::FindSuperset(const AttributePathParams & aPath)
+{
+    for (uint8_t wildcards = 0; wildcards < 8; wildcards++)
+    {
+        if (((wildcards & 1) && aPath.HasWildcardEndpointId()) || ((wildcards & 2) && aPath.HasWildcardClusterId()) ||
+            ((wildcards & 4) && aPath.HasWildcardAttributeId()))
+        {
+            // Already covered by the combination without this bit.
+            continue;
+        }
+
+        uint64_t * generation = Find((wildcards & 1) ? kInvalidEndpointId : aPath.mEndpointId,
+                                     (wildcards & 2) ? kInvalidClusterId : aPath.mClusterId,
+                                     (wildcards & 4) ? kInvalidAttributeId : aPath.mAttributeId);
+        if (generation != nullptr)
+        {
+            return generation;
+        }
+    }
+    return nullptr;
+}
+
+void DirtyAttributePathSet::RemoveSubsetsOf(const AttributePathParams & aPath)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < mSize; i++)
+    {
+        if (!aPath.IsAttributePathSupersetOf(mEntries[i].GetPath()))
+        {
+            mEntries[kept++] = mEntries[i];
+        }
+    }
+    mSize = kept;
+}
+
+void DirtyAttributePathSet::RemoveUpTo(uint64_t aGeneration)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < mSize; i++)
+    {
+        if (mEntries[i].mGeneration > aGeneration)
+        {
+            mEntries[kept++] = mEntries[i];
+        }
+    }
+    mSize = kept;
+}
+
+void DirtyAttributePathSet::Collapse(size_t aBegin, size_t aEnd, EndpointId aEndpointId, ClusterId aClusterId,
+                                     AttributeId aAttributeId)
+{
+    uint64_t generation = 0;
+    for (size_t i = aBegin; i < aEnd; i++)
+    {
+        if (mEntries[i].mGeneration > generation)
+        {
+            generation = mEntries[i].mGeneration;
+        }
+    }
+
+    mEntries[aBegin] = Entry{ aEndpointId, aClusterId, aAttributeId, generation };
+    memmove(&mEntries[aBegin + 1], &mEntries[aEnd], (mSize - aEnd) * sizeof(Entry));
+    mSize -= aEnd - aBegin - 1;
+}
+
+void DirtyAttributePathSet::MakeRoom()
+{
+    size_t bestBegin = 0;
+    size_t bestEnd   = 0;
+
+    for (size_t begin = 0, end = 0; begin < mSize; begin = end)
+    {
+        for (end = begin + 1; end < mSize && mEntries[end].mEndpointId == mEntries[begin].mEndpointId &&
+             mEntries[end].mClusterId == mEntries[begin].mClusterId;
+             end++)
+        {
+        }
+        if (mEntries[begin].mEndpointId != kInvalidEndpointId && mEntries[begin].mClusterId != kInvalidClusterId &&
+            end - begin > bestEnd - bestBegin)
+        {
+            bestBegin = begin;
+            bestEnd   = end;
+        }
+    }
+    if (bestEnd - bestBegin > 1)
+    {
+        ChipLogDetail(DataManagement, "Dirty set full, merge paths under endpoint %u cluster " ChipLogFormatMEI,
+                      mEntries[bestBegin].mEndpointId, ChipLogValueMEI(mEntries[bestBegin].mClusterId));
+        Collapse(bestBegin, bestEnd, mEntries[bestBegin].mEndpointId, mEntries[bestBegin].mClusterId, kInvalidAttributeId);
+        return;
+    }
+
+    bestBegin = bestEnd = 0;
+    for (size_t begin = 0, end = 0; begin < mSize; begin = end)
+    {
+        for (end = begin + 1; end < mSize && mEntries[end].mEndpointId == mEntries[begin].mEndpointId; end++)
+        {
+        }
+        if (mEntries[begin].mEndpointId != kInvalidEndpointId && end - begin > bestEnd - bestBegin)
+        {
+            bestBegin = begin;
+            bestEnd   = end;
+        }
+    }
+    if (bestEnd - bestBegin > 1)
+    {
+        ChipLogDetail(DataManagement, "Dirty set full, merge paths under endpoint %u", mEntries[bestBegin].mEndpointId);
+        Collapse(bestBegin, bestEnd, mEntries[bestBegin].mEndpointId, kInvalidClusterId, kInvalidAttributeId);
+        return;
+    }
+
+    ChipLogDetail(DataManagement, "Dirty set full, merge all paths.");
+    Collapse(0, mSize, kInvalidEndpointId, kInvalidClusterId, kInvalidAttributeId);
+}
+
+void DirtyAttributePathSet::Insert(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    uint64_t * generation = Find(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    if (generation != nullptr)
+    {
+        *generation = aGeneration;
+        return;
+    }
+
+    if (aPath.IsWildcardPath())
+    {
+        // The paths covered by the new one are older than it, so they no longer affect IsDirtySince.
+        RemoveSubsetsOf(aPath);
+    }
+
+    if (mSize == kCapacity)
+    {
+        MakeRoom();
+
+        // Merging may have produced a path that covers the new one, in which case there is nothing left to insert.
+        generation = FindSuperset(aPath);
+        if (generation != nullptr)
+        {
+            *generation = aGeneration;
+            return;
+        }
+    }
+
+    size_t index = LowerBound(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    memmove(&mEntries[index + 1], &mEntries[index], (mSize - index) * sizeof(Entry));
+    mEntries[index] = Entry{ aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId, aGeneration };
+    mSize++;
+}
+
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
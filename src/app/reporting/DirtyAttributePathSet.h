@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/Iterators.h>
+#include <system/SystemConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#include <map>
+#include <tuple>
+#endif
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * The set of attribute paths marked dirty for reporting, each tagged with the dirty set generation at which it was last
+ * marked dirty.
+ *
+ * Paths are kept sorted by endpoint, cluster and attribute id, with wildcard ids sorting after concrete ones, so that
+ * whether a concrete path is dirty can be answered with a binary search per matching key and paths under one cluster or
+ * endpoint are contiguous. List indices are not tracked: a path with a list index marks the whole attribute dirty, which is
+ * what gets reported anyway.
+ *
+ * Paths are stored as given, so marking one attribute dirty never makes its siblings look dirty. With heap pools, the set
+ * is an ordered map that grows as needed. Otherwise it holds up to CHIP_IM_SERVER_MAX_NUM_DIRTY_SET paths, and only when it
+ * is full are paths merged, into a wildcard attribute path for the cluster with the most dirty paths, else into a wildcard
+ * cluster path for the endpoint with the most dirty paths, else into a single wildcard path.
+ */
+class DirtyAttributePathSet
+{
+public:
+#if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    static constexpr size_t kCapacity = CHIP_IM_SERVER_MAX_NUM_DIRTY_SET;
+#endif
+
+    struct Entry
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        AttributeId mAttributeId;
+        uint64_t mGeneration;
+
+        AttributePathParams GetPath() const { return AttributePathParams(mEndpointId, mClusterId, mAttributeId); }
+    };
+
+    /**
+     * Mark the path dirty at the given generation. Paths already in the set which the new path is a superset of are
+     * dropped. If the set is full, existing paths are merged to make room, which may in turn cover the new path.
+     */
+    void Insert(const AttributePathParams & aPath, uint64_t aGeneration);
+
+    /**
+     * Returns whether any path in the set that is a superset of the given concrete path was marked dirty after the given
+     * generation.
+     */
+    bool IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const;
+
+    /**
+     * Drop the paths whose generation is not after the given one, i.e. which every reader has already reported.
+     */
+    void RemoveUpTo(uint64_t aGeneration);
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    void Clear() { mEntries.clear(); }
+    size_t Size() const { return mEntries.size(); }
+    bool Empty() const { return mEntries.empty(); }
+
+    /**
+     * Call the function on each entry, in order, until it returns Loop::Break.
+     */
+    template <typename Function>
+    Loop ForEach(Function && function) const
+    {
+        for (const auto & item : mEntries)
+        {
+            const Entry entry{ std::get<0>(item.first), std::get<1>(item.first), std::get<2>(item.first), item.second };
+            if (function(&entry) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+        }
+        return Loop::Finish;
+    }
+#else
+    void Clear() { mSize = 0; }
+    size_t Size() const { return mSize; }
+    bool Empty() const { return mSize == 0; }
+
+    /**
+     * Call the function on each entry, in order, until it returns Loop::Break.
+     */
+    template <typename Function>
+    Loop ForEach(Function && function) const
+    {
+        for (size_t i = 0; i < mSize; i++)
+        {
+            if (function(&mEntries[i]) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+        }
+        return Loop::Finish;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+private:
+    /**
+     * Returns the generation of the entry for exactly the given key, or nullptr if there is none.
+     */
+    uint64_t * Find(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId);
+    const uint64_t * Find(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) const;
+
+    void RemoveSubsetsOf(const AttributePathParams & aPath);
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    using Key = std::tuple<EndpointId, ClusterId, AttributeId>;
+
+    // The generation of each path.
+    std::map<Key, uint64_t> mEntries;
+#else
+    /**
+     * Returns the index of the first entry not ordered before the given key.
+     */
+    size_t LowerBound(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) const;
+
+    /**
+     * Returns the generation of an entry that is a superset of the given path, if any. Only looks for the keys obtained by
+     * turning concrete ids of the path into wildcards.
+     */
+    uint64_t * FindSuperset(const AttributePathParams & aPath);
+
+    /**
+     * Replace the entries [aBegin, aEnd) with a single entry for the given key, carrying the newest of their generations.
+     * The key must sort at or after the entries before aBegin and at or before the entries after aEnd.
+     */
+    void Collapse(size_t aBegin, size_t aEnd, EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId);
+
+    /**
+     * Merge entries to free at least one slot: the largest run of entries under one concrete cluster if there is one with
+     * more than one entry, else the largest such run under one concrete endpoint, else all entries.
+     */
+    void MakeRoom();
+
+    Entry mEntries[kCapacity];
+    size_t mSize = 0;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
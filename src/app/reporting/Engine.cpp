@@ -48,7 +48,18 @@ void Engine::Shutdown()
 
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
-    mGlobalDirtySet.ReleaseAll();
+    mGlobalDirtySet.Clear();
+    mDirtySetPrunedGeneration = 0;
+
+    for (auto & bucket : mAttributePathInterestIndex)
+    {
+        bucket = nullptr;
+    }
+    mAttributePathInterestPool.ReleaseAll();
+    mNumUnindexedReadHandlers = 0;
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    mReportEncodingCache.End();
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
 }
 
 bool Engine::IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
@@ -89,6 +100,50 @@ static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
     return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
 }
 
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+bool Engine::RetrieveClusterDataFromCache(ReadHandler & aReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                          const ConcreteReadAttributePath & aPath)
+{
+    VerifyOrReturnValue(mReportEncodingCache.IsActive(), false);
+
+    // Encodings are shared between read handlers that are granted access, a denied one gets its own status or nothing.
+    const SubjectDescriptor subjectDescriptor = aReadHandler.GetSubjectDescriptor();
+    Access::RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+    Access::Privilege requestPrivilege = RequiredPrivilege::ForReadAttribute(aPath);
+    VerifyOrReturnValue(GetAccessControl().Check(subjectDescriptor, requestPath, requestPrivilege) == CHIP_NO_ERROR, false);
+
+    const FabricIndex fabricIndex = subjectDescriptor.fabricIndex;
+    const bool isFabricFiltered   = aReadHandler.IsFabricFiltered();
+
+    const ReportEncodingCache::Entry * cachedReport =
+        mReportEncodingCache.Find(aPath, fabricIndex, isFabricFiltered, mDirtyGeneration);
+    if (cachedReport == nullptr)
+    {
+        cachedReport = mReportEncodingCache.Add(aPath, fabricIndex, isFabricFiltered, mDirtyGeneration,
+                                                [&](AttributeReportIBs::Builder & attributeReportIBs) {
+                                                    AttributeValueEncoder::AttributeEncodeState encodeState;
+                                                    return RetrieveClusterData(subjectDescriptor, isFabricFiltered,
+                                                                               attributeReportIBs, aPath, &encodeState);
+                                                });
+        VerifyOrReturnValue(cachedReport != nullptr, false);
+    }
+    else if (cachedReport->mDataVersion.HasValue() && !IsClusterDataVersionEqual(aPath, cachedReport->mDataVersion.Value()))
+    {
+        return false;
+    }
+
+    TLV::TLVWriter backup;
+    aAttributeReportIBs.Checkpoint(backup);
+    if (mReportEncodingCache.CopyTo(*cachedReport, aAttributeReportIBs) != CHIP_NO_ERROR)
+    {
+        // Most likely out of space, retrieving the attribute directly takes care of chunking it.
+        aAttributeReportIBs.Rollback(backup);
+        return false;
+    }
+    return true;
+}
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
 CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder,
                                                            ReadHandler * apReadHandler, bool * apHasMoreChunks,
                                                            bool * apHasEncodedData)
@@ -141,21 +196,9 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         {
             if (!apReadHandler->IsPriming())
             {
-                bool concretePathDirty = false;
-                // TODO: Optimize this implementation by making the iterator only emit intersected paths.
-                mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
-                    if (dirtyPath->IsAttributePathSupersetOf(readPath))
-                    {
-                        // We don't need to worry about paths that were already marked dirty before the last time this read handler
-                        // started a report that it completed: those paths already got reported.
-                        if (dirtyPath->mGeneration > apReadHandler->mPreviousReportsBeginGeneration)
-                        {
-                            concretePathDirty = true;
-                            return Loop::Break;
-                        }
-                    }
-                    return Loop::Continue;
-                });
+                // We don't need to worry about paths that were already marked dirty before the last time this read handler
+                // started a report that it completed: those paths already got reported.
+                bool concretePathDirty = mGlobalDirtySet.IsDirtySince(readPath, apReadHandler->mPreviousReportsBeginGeneration);
 
                 if (!concretePathDirty)
                 {
@@ -186,6 +229,15 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeValueEncoder::AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+            // Only whole attributes are shared, not the chunks of a list that did not fit in the previous report, and only
+            // if another read handler may report them as well.
+            if (!encodeState.AllowPartialData() && IsAttributeOfInterestToSeveralReadHandlers(pathForRetrieval) &&
+                RetrieveClusterDataFromCache(*apReadHandler, attributeReportIBs, pathForRetrieval))
+            {
+                continue;
+            }
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
             err = RetrieveClusterData(apReadHandler->GetSubjectDescriptor(), apReadHandler->IsFabricFiltered(), attributeReportIBs,
                                       pathForRetrieval, &encodeState);
             if (err != CHIP_NO_ERROR)
@@ -635,6 +687,15 @@ void Engine::Run()
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = imEngine->mReadHandlers.Allocated();
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    // Several read handlers may report the same attributes, so share their encodings for the duration of this run.
+    if (initialAllocated > 1)
+    {
+        mReportEncodingCache.Begin();
+    }
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
     while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < initialAllocated))
     {
         ReadHandler * readHandler = imEngine->ActiveHandlerAt(mCurReadHandlerIdx % (uint32_t) imEngine->mReadHandlers.Allocated());
@@ -647,6 +708,9 @@ void Engine::Run()
             mRunningReadHandler = nullptr;
             if (err != CHIP_NO_ERROR)
             {
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+                mReportEncodingCache.End();
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
                 return;
             }
         }
@@ -658,6 +722,10 @@ void Engine::Run()
         mCurReadHandlerIdx++;
     }
 
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    mReportEncodingCache.End();
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
     //
     // If our tracker has exceeded the bounds of the handler list, reset it back to 0.
     // This isn't strictly necessary, but does make it easier to debug issues in this code if they
@@ -684,176 +752,264 @@ void Engine::Run()
     {
         ChipLogDetail(DataManagement, "All ReadHandler-s are clean, clear GlobalDirtySet");
 
-        mGlobalDirtySet.ReleaseAll();
+        mGlobalDirtySet.Clear();
+    }
+    else
+    {
+        PruneDirtySet();
     }
 }
 
-bool Engine::MergeOverlappedAttributePath(const AttributePathParams & aAttributePath)
+void Engine::PruneDirtySet()
 {
-    return Loop::Break == mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
-        if (path->IsAttributePathSupersetOf(aAttributePath))
+    uint64_t prunableGeneration = mDirtyGeneration;
+    InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject([&prunableGeneration](ReadHandler * handler) {
+        uint64_t generation;
+        if (!handler->IsPriming())
         {
-            path->mGeneration = GetDirtySetGeneration();
-            return Loop::Break;
+            // The next report will look for paths dirtied after the beginning of the last completed one.
+            generation = handler->mPreviousReportsBeginGeneration;
         }
-        if (aAttributePath.IsAttributePathSupersetOf(*path))
+        else if (handler->IsReporting())
         {
-            // TODO: the wildcard input path may be superset of next paths in globalDirtySet, it is fine at this moment, since
-            // when building report, it would use the first path of globalDirtySet to compare against interested paths read clients
-            // want.
-            // It is better to eliminate the duplicate wildcard paths in follow-up
-            path->mGeneration  = GetDirtySetGeneration();
-            path->mEndpointId  = aAttributePath.mEndpointId;
-            path->mClusterId   = aAttributePath.mClusterId;
-            path->mListIndex   = aAttributePath.mListIndex;
-            path->mAttributeId = aAttributePath.mAttributeId;
-            return Loop::Break;
+            // Priming reports do not look at the dirty set, and once they complete the handler only looks for paths dirtied
+            // after they began.
+            generation = handler->mCurrentReportsBeginGeneration;
+        }
+        else
+        {
+            // Priming reports that have not begun yet will cover everything dirtied so far.
+            return Loop::Continue;
+        }
+
+        if (generation < prunableGeneration)
+        {
+            prunableGeneration = generation;
         }
         return Loop::Continue;
     });
+
+    if (prunableGeneration > mDirtySetPrunedGeneration)
+    {
+        mGlobalDirtySet.RemoveUpTo(prunableGeneration);
+        mDirtySetPrunedGeneration = prunableGeneration;
+    }
 }
 
-bool Engine::ClearTombPaths()
+void Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttributePath)
 {
-    bool pathReleased = false;
-    mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
-        if (path->mGeneration == 0)
+    mGlobalDirtySet.Insert(aAttributePath, GetDirtySetGeneration());
+}
+
+size_t Engine::AttributePathInterestBucket(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+{
+    uint64_t hash = (static_cast<uint64_t>(aClusterId) << 32) | aAttributeId;
+    hash ^= static_cast<uint64_t>(aEndpointId) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 31;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 29;
+    return static_cast<size_t>(hash) & (kAttributePathInterestBuckets - 1);
+}
+
+void Engine::AddAttributePathInterest(ReadHandler & aReadHandler)
+{
+    for (auto object = aReadHandler.GetAttributePathList(); object != nullptr; object = object->mpNext)
+    {
+        AttributePathInterest * interest = mAttributePathInterestPool.CreateObject(&aReadHandler, &object->mValue);
+        if (interest == nullptr)
         {
-            mGlobalDirtySet.ReleaseObject(path);
-            pathReleased = true;
+            // Undo what was indexed and have SetDirty check this handler's paths directly instead.
+            RemoveAttributePathInterest(aReadHandler);
+            aReadHandler.SetStateFlag(ReadHandler::ReadHandlerFlags::AttributePathsUnindexed);
+            mNumUnindexedReadHandlers++;
+            return;
         }
-        return Loop::Continue;
-    });
-    return pathReleased;
+
+        const AttributePathParams & path = object->mValue;
+        AttributePathInterest *& bucket =
+            mAttributePathInterestIndex[AttributePathInterestBucket(path.mEndpointId, path.mClusterId, path.mAttributeId)];
+        interest->mpNext = bucket;
+        bucket           = interest;
+    }
 }
 
-bool Engine::MergeDirtyPathsUnderSameCluster()
+void Engine::RemoveAttributePathInterest(ReadHandler & aReadHandler)
 {
-    mGlobalDirtySet.ForEachActiveObject([&](auto * outerPath) {
-        if (outerPath->HasWildcardClusterId() || outerPath->mGeneration == 0)
+    if (aReadHandler.mFlags.Has(ReadHandler::ReadHandlerFlags::AttributePathsUnindexed))
+    {
+        aReadHandler.ClearStateFlag(ReadHandler::ReadHandlerFlags::AttributePathsUnindexed);
+        if (mNumUnindexedReadHandlers > 0)
         {
-            return Loop::Continue;
+            mNumUnindexedReadHandlers--;
         }
-        mGlobalDirtySet.ForEachActiveObject([&](auto * innerPath) {
-            if (innerPath == outerPath)
+        return;
+    }
+
+    for (auto object = aReadHandler.GetAttributePathList(); object != nullptr; object = object->mpNext)
+    {
+        const AttributePathParams & path = object->mValue;
+        for (AttributePathInterest ** link =
+                 &mAttributePathInterestIndex[AttributePathInterestBucket(path.mEndpointId, path.mClusterId, path.mAttributeId)];
+             *link != nullptr; link = &(*link)->mpNext)
+        {
+            if ((*link)->mpPath == &path)
             {
-                return Loop::Continue;
+                AttributePathInterest * interest = *link;
+                *link                            = interest->mpNext;
+                mAttributePathInterestPool.ReleaseObject(interest);
+                break;
             }
-            // We don't support paths with a wildcard endpoint + a concrete cluster in global dirty set, so we do a simple == check
-            // here.
-            if (innerPath->mEndpointId != outerPath->mEndpointId || innerPath->mClusterId != outerPath->mClusterId)
+        }
+    }
+}
+
+bool Engine::NotifyInterestedReadHandler(ReadHandler & aReadHandler, const AttributePathParams & aAttributePath)
+{
+    // SetDirty bumps the generation before notifying anyone, so a handler already carrying the current generation has been
+    // notified through another of its paths.
+    if (aReadHandler.mDirtyGeneration == mDirtyGeneration)
+    {
+        return true;
+    }
+
+    // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
+    // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
+    // waiting for a response to the last message chunk for read interactions.
+    if (aReadHandler.CanStartReporting() || aReadHandler.IsAwaitingReportResponse())
+    {
+        aReadHandler.AttributePathIsDirty(aAttributePath);
+        return true;
+    }
+    return false;
+}
+
+bool Engine::NotifyReadHandlersByScan(const AttributePathParams & aAttributePath, bool aUnindexedOnly)
+{
+    bool intersectsInterestPath = false;
+    InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject(
+        [this, &aAttributePath, aUnindexedOnly, &intersectsInterestPath](ReadHandler * handler) {
+            if (aUnindexedOnly && !handler->mFlags.Has(ReadHandler::ReadHandlerFlags::AttributePathsUnindexed))
             {
                 return Loop::Continue;
             }
-            if (innerPath->mGeneration > outerPath->mGeneration)
+
+            for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
             {
-                outerPath->mGeneration = innerPath->mGeneration;
+                if (object->mValue.Intersects(aAttributePath))
+                {
+                    intersectsInterestPath |= NotifyInterestedReadHandler(*handler, aAttributePath);
+                    break;
+                }
             }
-            outerPath->SetWildcardAttributeId();
 
-            // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
-            // generation to 0 and then clear it later.
-            innerPath->mGeneration = 0;
             return Loop::Continue;
         });
-        return Loop::Continue;
-    });
-
-    return ClearTombPaths();
+    return intersectsInterestPath;
 }
 
-bool Engine::MergeDirtyPathsUnderSameEndpoint()
+template <typename Callback>
+Loop Engine::ForEachIndexedInterestedReadHandler(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId,
+                                                 Callback && aCallback)
 {
-    mGlobalDirtySet.ForEachActiveObject([&](auto * outerPath) {
-        if (outerPath->HasWildcardEndpointId() || outerPath->mGeneration == 0)
+    // A concrete path intersects exactly the interest paths whose ids each either match it or are wildcards, and those are
+    // filed under one of these eight keys.
+    for (uint8_t wildcards = 0; wildcards < 8; wildcards++)
+    {
+        const EndpointId endpointId   = (wildcards & 1) ? kInvalidEndpointId : aEndpointId;
+        const ClusterId clusterId     = (wildcards & 2) ? kInvalidClusterId : aClusterId;
+        const AttributeId attributeId = (wildcards & 4) ? kInvalidAttributeId : aAttributeId;
+
+        for (AttributePathInterest * interest =
+                 mAttributePathInterestIndex[AttributePathInterestBucket(endpointId, clusterId, attributeId)];
+             interest != nullptr; interest = interest->mpNext)
         {
-            return Loop::Continue;
-        }
-        mGlobalDirtySet.ForEachActiveObject([&](auto * innerPath) {
-            if (innerPath == outerPath)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mEndpointId != outerPath->mEndpointId)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mGeneration > outerPath->mGeneration)
+            if (interest->mpPath->mEndpointId == endpointId && interest->mpPath->mClusterId == clusterId &&
+                interest->mpPath->mAttributeId == attributeId && aCallback(*interest->mpReadHandler) == Loop::Break)
             {
-                outerPath->mGeneration = innerPath->mGeneration;
+                return Loop::Break;
             }
-            outerPath->SetWildcardClusterId();
-            outerPath->SetWildcardAttributeId();
+        }
+    }
 
-            // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
-            // generation to 0 and then clear it later.
-            innerPath->mGeneration = 0;
-            return Loop::Continue;
-        });
-        return Loop::Continue;
-    });
-    return ClearTombPaths();
+    return Loop::Finish;
 }
 
-CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttributePath)
+bool Engine::NotifyReadHandlersByIndex(const AttributePathParams & aAttributePath)
 {
-    ReturnErrorCodeIf(MergeOverlappedAttributePath(aAttributePath), CHIP_NO_ERROR);
+    bool intersectsInterestPath = false;
+    ForEachIndexedInterestedReadHandler(aAttributePath.mEndpointId, aAttributePath.mClusterId, aAttributePath.mAttributeId,
+                                        [this, &aAttributePath, &intersectsInterestPath](ReadHandler & aReadHandler) {
+                                            intersectsInterestPath |= NotifyInterestedReadHandler(aReadHandler, aAttributePath);
+                                            return Loop::Continue;
+                                        });
+    return intersectsInterestPath;
+}
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+bool Engine::IsAttributeOfInterestToSeveralReadHandlers(const ConcreteAttributePath & aPath)
+{
+    ReadHandler * firstReadHandler = nullptr;
+    auto isAnotherReadHandler      = [&firstReadHandler](ReadHandler & aReadHandler) {
+        if (firstReadHandler == nullptr)
+        {
+            firstReadHandler = &aReadHandler;
+        }
+        return firstReadHandler != &aReadHandler;
+    };
 
-    if (mGlobalDirtySet.Exhausted() && !MergeDirtyPathsUnderSameCluster() && !MergeDirtyPathsUnderSameEndpoint())
+    if (ForEachIndexedInterestedReadHandler(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId,
+                                            [&isAnotherReadHandler](ReadHandler & aReadHandler) {
+                                                return isAnotherReadHandler(aReadHandler) ? Loop::Break : Loop::Continue;
+                                            }) == Loop::Break)
     {
-        ChipLogDetail(DataManagement, "Global dirty set pool exhausted, merge all paths.");
-        mGlobalDirtySet.ReleaseAll();
-        auto object         = mGlobalDirtySet.CreateObject();
-        object->mGeneration = GetDirtySetGeneration();
+        return true;
     }
 
-    ReturnErrorCodeIf(MergeOverlappedAttributePath(aAttributePath), CHIP_NO_ERROR);
-    ChipLogDetail(DataManagement, "Cannot merge the new path into any existing path, create one.");
+    VerifyOrReturnValue(mNumUnindexedReadHandlers > 0, false);
 
-    auto object = mGlobalDirtySet.CreateObject();
-    if (object == nullptr)
-    {
-        // This should not happen, this path should be merged into the wildcard endpoint at least.
-        ChipLogError(DataManagement, "mGlobalDirtySet pool full, cannot handle more entries!");
-        return CHIP_ERROR_NO_MEMORY;
-    }
-    *object             = aAttributePath;
-    object->mGeneration = GetDirtySetGeneration();
+    const AttributePathParams attributePath(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    return InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+        if (!handler->mFlags.Has(ReadHandler::ReadHandlerFlags::AttributePathsUnindexed))
+        {
+            return Loop::Continue;
+        }
 
-    return CHIP_NO_ERROR;
+        for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+        {
+            if (object->mValue.Intersects(attributePath))
+            {
+                return isAnotherReadHandler(*handler) ? Loop::Break : Loop::Continue;
+            }
+        }
+        return Loop::Continue;
+    }) == Loop::Break;
 }
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
 
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
 
     bool intersectsInterestPath = false;
-    InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject(
-        [&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
-            // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
-            // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
-            // waiting for a response to the last message chunk for read interactions.
-            if (handler->CanStartReporting() || handler->IsAwaitingReportResponse())
-            {
-                for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
-                {
-                    if (object->mValue.Intersects(aAttributePath))
-                    {
-                        handler->AttributePathIsDirty(aAttributePath);
-                        intersectsInterestPath = true;
-                        break;
-                    }
-                }
-            }
-
-            return Loop::Continue;
-        });
+    if (aAttributePath.IsWildcardPath())
+    {
+        // A wildcard dirty path can intersect interest paths filed under any key.
+        intersectsInterestPath = NotifyReadHandlersByScan(aAttributePath, /* aUnindexedOnly = */ false);
+    }
+    else
+    {
+        intersectsInterestPath = NotifyReadHandlersByIndex(aAttributePath);
+        if (mNumUnindexedReadHandlers > 0)
+        {
+            intersectsInterestPath |= NotifyReadHandlersByScan(aAttributePath, /* aUnindexedOnly = */ true);
+        }
+    }
 
     if (!intersectsInterestPath)
     {
         return CHIP_NO_ERROR;
     }
-    ReturnErrorOnFailure(InsertPathIntoDirtySet(aAttributePath));
+    InsertPathIntoDirtySet(aAttributePath);
 
     return CHIP_NO_ERROR;
 }
@@ -27,6 +27,8 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/DirtyAttributePathSet.h>
+#include <app/reporting/ReportEncodingCache.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -122,6 +124,18 @@ public:
 
     uint64_t GetDirtySetGeneration() const { return mDirtyGeneration; }
 
+    /**
+     * Add the attribute paths of a read handler to the index consulted by SetDirty, so that dirty attributes only visit the
+     * handlers whose paths intersect them. Must be called once the handler's attribute path list is final.
+     */
+    void AddAttributePathInterest(ReadHandler & aReadHandler);
+
+    /**
+     * Remove the attribute paths of a read handler from the index consulted by SetDirty. Must be called before the handler's
+     * attribute path list is released. It is not an error for the handler not to have been added.
+     */
+    void RemoveAttributePathInterest(ReadHandler & aReadHandler);
+
     /**
      * Schedule event delivery to happen immediately and run reporting to get
      * those reports into messages and on the wire.  This can be done either for
@@ -131,7 +145,7 @@ public:
     void ScheduleUrgentEventDeliverySync(Optional<FabricIndex> fabricIndex = NullOptional);
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
-    size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
+    size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Size(); }
 #endif
 
 private:
@@ -145,13 +159,6 @@ private:
 
     bool IsRunScheduled() const { return mRunScheduled; }
 
-    struct AttributePathParamsWithGeneration : public AttributePathParams
-    {
-        AttributePathParamsWithGeneration() {}
-        AttributePathParamsWithGeneration(const AttributePathParams aPath) : AttributePathParams(aPath) {}
-        uint64_t mGeneration = 0;
-    };
-
     /**
      * Build Single Report Data including attribute changes and event data stream, and send out
      *
@@ -166,6 +173,21 @@ private:
                                    AttributeReportIBs::Builder & aAttributeReportIBs,
                                    const ConcreteReadAttributePath & aClusterInfo,
                                    AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    /**
+     * Encode the attribute for the read handler from mReportEncodingCache, encoding it into the cache first if no other read
+     * handler did so during this run. Returns false, with nothing encoded, if the attribute has to be retrieved directly,
+     * e.g. because the read handler is denied access to it or the encoding does not fit.
+     */
+    bool RetrieveClusterDataFromCache(ReadHandler & aReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                      const ConcreteReadAttributePath & aPath);
+
+    /**
+     * Whether more than one read handler has an attribute path that includes aPath, so that its encoding is worth sharing.
+     */
+    bool IsAttributeOfInterestToSeveralReadHandlers(const ConcreteAttributePath & aPath);
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
     // If version match, it means don't send, if version mismatch, it means send.
@@ -192,37 +214,64 @@ private:
     void GetMinEventLogPosition(uint32_t & aMinLogPosition);
 
     /**
-     * If the provided path is a superset of our of our existing paths, update that existing path to match the
-     * provided path.
-     *
-     * Return whether one of our paths is now a superset of the provided path.
+     * Drop the dirty paths that every read handler has already reported, or will not look at when building its next report.
      */
-    bool MergeOverlappedAttributePath(const AttributePathParams & aAttributePath);
+    void PruneDirtySet();
+
+    void InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
     /**
-     * If we are running out of ObjectPool for the global dirty set, we will try to merge the existing items by clusters.
+     * An attribute path of a ReadHandler, filed in mAttributePathInterestIndex under its endpoint, cluster and attribute id,
+     * any of which may be a wildcard.
+     */
+    struct AttributePathInterest
+    {
+        AttributePathInterest(ReadHandler * apReadHandler, const AttributePathParams * apPath) :
+            mpReadHandler(apReadHandler), mpPath(apPath)
+        {}
+        ReadHandler * mpReadHandler;
+        const AttributePathParams * mpPath;
+        AttributePathInterest * mpNext = nullptr;
+    };
+
+    static constexpr size_t kAttributePathInterestBuckets = CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS;
+    static_assert((kAttributePathInterestBuckets & (kAttributePathInterestBuckets - 1)) == 0,
+                  "CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS must be a power of two");
+
+    static size_t AttributePathInterestBucket(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId);
+
+    /**
+     * Notify the read handler that the dirty path intersects its interest path, unless it has been notified already for this
+     * generation or cannot report at the moment.
      *
-     * Returns whether we have released any paths.
+     * Returns whether the read handler was or had already been notified.
      */
-    bool MergeDirtyPathsUnderSameCluster();
+    bool NotifyInterestedReadHandler(ReadHandler & aReadHandler, const AttributePathParams & aAttributePath);
 
     /**
-     * If we are running out of ObjectPool for the global dirty set and we cannot find a slot after merging the existing items by
-     * clusters, we will try to merge the existing items by endpoints.
+     * Check the attribute path lists of all read handlers against the dirty path, or only of those that could not be indexed
+     * if aUnindexedOnly is true.
      *
-     * Returns whether we have released any paths.
+     * Returns whether any read handler was notified.
      */
-    bool MergeDirtyPathsUnderSameEndpoint();
+    bool NotifyReadHandlersByScan(const AttributePathParams & aAttributePath, bool aUnindexedOnly);
 
     /**
-     * During the iterating of the paths, releasing the object in the inner loop will cause undefined behavior of the ObjectPool, so
-     * we replace the items to be cleared by a tomb first, then clear all the tombs after the iteration.
+     * Look up a concrete dirty path in mAttributePathInterestIndex under each combination of its ids and wildcards.
      *
-     * Returns whether we have released any paths.
+     * Returns whether any read handler was notified.
      */
-    bool ClearTombPaths();
+    bool NotifyReadHandlersByIndex(const AttributePathParams & aAttributePath);
 
-    CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
+    /**
+     * Call aCallback with the read handler of each interest path in mAttributePathInterestIndex that the concrete path
+     * intersects, until it returns Loop::Break. A read handler is passed once for each of its paths that match.
+     *
+     * Returns Loop::Break if aCallback did, Loop::Finish otherwise.
+     */
+    template <typename Callback>
+    Loop ForEachIndexedInterestedReadHandler(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId,
+                                             Callback && aCallback);
 
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
@@ -251,15 +300,10 @@ private:
     ReadHandler * mRunningReadHandler = nullptr;
 
     /**
-     *  mGlobalDirtySet is used to track the set of attribute/event paths marked dirty for reporting purposes.
+     *  mGlobalDirtySet is used to track the set of attribute paths marked dirty for reporting purposes.
      *
      */
-#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
-    // For unit tests, always use inline allocation for code coverage.
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, ObjectPoolMem::kInline> mGlobalDirtySet;
-#else
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
-#endif
+    DirtyAttributePathSet mGlobalDirtySet;
 
     /**
      * A generation counter for the dirty attrbute set.
@@ -275,6 +319,32 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+    /**
+     * The generation up to which mGlobalDirtySet was last pruned, so that PruneDirtySet does not walk the set when no read
+     * handler has completed a report since.
+     */
+    uint64_t mDirtySetPrunedGeneration = 0;
+
+    /**
+     * Attribute paths of read handlers, hashed by endpoint, cluster and attribute id, with wildcard ids hashed as themselves.
+     */
+    AttributePathInterest * mAttributePathInterestIndex[kAttributePathInterestBuckets] = {};
+    ObjectPool<AttributePathInterest,
+               CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+        mAttributePathInterestPool;
+
+    /**
+     * Number of read handlers whose paths could not all be indexed; SetDirty checks those by scanning their path lists.
+     */
+    uint32_t mNumUnindexedReadHandlers = 0;
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    /**
+     * Attribute encodings shared between the read handlers reporting during a run of the engine.
+     */
+    ReportEncodingCache mReportEncodingCache;
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
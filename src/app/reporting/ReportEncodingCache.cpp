@@ -0,0 +1,108 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportEncodingCache.h>
+
+#include <app/MessageDef/AttributeReportIB.h>
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+const ReportEncodingCache::Entry * ReportEncodingCache::Find(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex,
+                                                             bool aIsFabricFiltered, uint64_t aGeneration) const
+{
+    VerifyOrReturnValue(mActive, nullptr);
+
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (entry.mPath == aPath && entry.mPath.mExpanded == aPath.mExpanded &&
+            entry.mAccessingFabricIndex == aAccessingFabricIndex && entry.mIsFabricFiltered == aIsFabricFiltered &&
+            entry.mGeneration == aGeneration)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR ReportEncodingCache::CopyTo(const Entry & aEntry, AttributeReportIBs::Builder & aAttributeReportIBs) const
+{
+    TLV::TLVWriter * writer = aAttributeReportIBs.GetWriter();
+    VerifyOrReturnError(writer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    TLV::TLVReader reader;
+    TLV::TLVType outerType;
+    reader.Init(&mBuffer[aEntry.mOffset], aEntry.mLength);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(outerType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(writer->CopyElement(TLV::AnonymousTag(), reader));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return reader.ExitContainer(outerType);
+}
+
+const ReportEncodingCache::Entry * ReportEncodingCache::AddEntry(const ConcreteAttributePath & aPath,
+                                                                 FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered,
+                                                                 uint64_t aGeneration, uint32_t aLength)
+{
+    Entry & entry               = mEntries[mNumEntries];
+    entry.mPath                 = aPath;
+    entry.mAccessingFabricIndex = aAccessingFabricIndex;
+    entry.mIsFabricFiltered     = aIsFabricFiltered;
+    entry.mGeneration           = aGeneration;
+    entry.mOffset               = static_cast<uint16_t>(mUsed);
+    entry.mLength               = static_cast<uint16_t>(aLength);
+    entry.mDataVersion.ClearValue();
+
+    // Remember the data version the attribute was encoded with, so that the encoding is not used once it changed.
+    TLV::TLVReader reader;
+    AttributeReportIBs::Parser attributeReportIBs;
+    AttributeReportIB::Parser attributeReport;
+    AttributeDataIB::Parser attributeData;
+    DataVersion dataVersion;
+    reader.Init(&mBuffer[entry.mOffset], entry.mLength);
+    if (reader.Next() == CHIP_NO_ERROR && attributeReportIBs.Init(reader) == CHIP_NO_ERROR)
+    {
+        attributeReportIBs.GetReader(&reader);
+        if (reader.Next() == CHIP_NO_ERROR && attributeReport.Init(reader) == CHIP_NO_ERROR &&
+            attributeReport.GetAttributeData(&attributeData) == CHIP_NO_ERROR &&
+            attributeData.GetDataVersion(&dataVersion) == CHIP_NO_ERROR)
+        {
+            entry.mDataVersion.SetValue(dataVersion);
+        }
+    }
+
+    mUsed += aLength;
+    mNumEntries++;
+    return &entry;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/Optional.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * Encoded AttributeReportIBs of attributes, shared between the read handlers that report the same attributes while the
+ * reporting engine runs, so that an attribute is read and encoded once per run instead of once per read handler.
+ *
+ * An encoding is only valid for read handlers that pass the access control check of the attribute, which the caller has
+ * to make for each read handler, and is keyed by the accessing fabric and whether the read is fabric filtered, as these
+ * decide which entries of fabric scoped attributes are encoded. Encodings also record the dirty set generation and the
+ * data version of the cluster at the time they were made, and are not found once either moved on.
+ *
+ * Encodings are kept in a fixed buffer of CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE bytes; attributes that do not fit
+ * are not cached. Setting CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE to 0 leaves the cache out.
+ */
+class ReportEncodingCache
+{
+public:
+    static constexpr size_t kBufferSize = CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE;
+    static constexpr size_t kMaxEntries = CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES;
+    static_assert(kBufferSize <= UINT16_MAX, "CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE is out of range");
+    static_assert(kMaxEntries > 0, "CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES must not be zero");
+
+    struct Entry
+    {
+        ConcreteAttributePath mPath; // Including whether it was expanded from a wildcard path
+        FabricIndex mAccessingFabricIndex;
+        bool mIsFabricFiltered;
+        uint64_t mGeneration;
+        Optional<DataVersion> mDataVersion; // Missing if the attribute was encoded as a status
+        uint16_t mOffset;
+        uint16_t mLength;
+    };
+
+    /**
+     * Start caching encodings, dropping any cached before.
+     */
+    void Begin()
+    {
+        Clear();
+        mActive = true;
+    }
+
+    /**
+     * Stop caching encodings and drop the ones cached.
+     */
+    void End()
+    {
+        Clear();
+        mActive = false;
+    }
+
+    bool IsActive() const { return mActive; }
+
+    /**
+     * Returns the encoding of the attribute for the given fabric made at the given dirty set generation, if any.
+     */
+    const Entry * Find(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered,
+                       uint64_t aGeneration) const;
+
+    /**
+     * Encode an attribute into the cache by calling aEncode with an AttributeReportIBs::Builder writing into it.
+     *
+     * Returns the new entry, or nullptr if the cache is not active or full, or aEncode failed, in which case nothing is
+     * cached.
+     */
+    template <typename EncodeFunction>
+    const Entry * Add(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered,
+                      uint64_t aGeneration, EncodeFunction && aEncode)
+    {
+        VerifyOrReturnValue(mActive && mNumEntries < kMaxEntries && mUsed < kBufferSize, nullptr);
+
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder attributeReportIBs;
+        writer.Init(&mBuffer[mUsed], kBufferSize - mUsed);
+        VerifyOrReturnValue(attributeReportIBs.Init(&writer) == CHIP_NO_ERROR, nullptr);
+        VerifyOrReturnValue(aEncode(attributeReportIBs) == CHIP_NO_ERROR, nullptr);
+        VerifyOrReturnValue(attributeReportIBs.EndOfAttributeReportIBs() == CHIP_NO_ERROR, nullptr);
+        VerifyOrReturnValue(writer.Finalize() == CHIP_NO_ERROR, nullptr);
+
+        return AddEntry(aPath, aAccessingFabricIndex, aIsFabricFiltered, aGeneration, writer.GetLengthWritten());
+    }
+
+    /**
+     * Append the AttributeReportIBs of the entry to the given builder. On failure, the builder may hold some of them, so
+     * the caller has to roll it back.
+     */
+    CHIP_ERROR CopyTo(const Entry & aEntry, AttributeReportIBs::Builder & aAttributeReportIBs) const;
+
+    void Clear()
+    {
+        mNumEntries = 0;
+        mUsed       = 0;
+    }
+
+    size_t NumEntries() const { return mNumEntries; }
+
+private:
+    const Entry * AddEntry(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered,
+                           uint64_t aGeneration, uint32_t aLength);
+
+    Entry mEntries[kMaxEntries];
+    uint8_t mBuffer[kBufferSize];
+    size_t mNumEntries = 0;
+    size_t mUsed       = 0;
+    bool mActive       = false;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
@@ -126,6 +126,12 @@ public:
         System::Clock::Timestamp GetMinTimestamp() const { return mMinTimestamp; }
         System::Clock::Timestamp GetMaxTimestamp() const { return mMaxTimestamp; }
 
+        /// @brief Position of the node in the report queue of schedulers that keep their nodes ordered by report time, or
+        /// kNotQueued if the node has no report scheduled there.
+        static constexpr uint16_t kNotQueued = UINT16_MAX;
+        uint16_t GetQueueIndex() const { return mQueueIndex; }
+        void SetQueueIndex(uint16_t aQueueIndex) { mQueueIndex = aQueueIndex; }
+
     private:
         ReadHandler * mReadHandler;
         ReportScheduler * mScheduler;
@@ -133,8 +139,11 @@ public:
         Timestamp mMaxTimestamp;
 
         BitFlags<ReadHandlerNodeFlags> mFlags;
+        uint16_t mQueueIndex = kNotQueued;
     };
 
+    static constexpr size_t kMaxReadHandlerNodes = CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
     ReportScheduler(TimerDelegate * aTimerDelegate) : mTimerDelegate(aTimerDelegate) {}
     /**
      *  Interface to act on changes in the ReadHandler reportability
@@ -184,7 +193,7 @@ protected:
     /// @brief Find the ReadHandlerNode for a given ReadHandler pointer
     /// @param [in] aReadHandler ReadHandler pointer to look for in the ReadHandler nodes list
     /// @return Node Address if node was found, nullptr otherwise
-    ReadHandlerNode * FindReadHandlerNode(const ReadHandler * aReadHandler)
+    virtual ReadHandlerNode * FindReadHandlerNode(const ReadHandler * aReadHandler)
     {
         ReadHandlerNode * foundNode = nullptr;
         mNodesPool.ForEachActiveObject([&foundNode, aReadHandler](ReadHandlerNode * node) {
@@ -199,7 +208,7 @@ protected:
         return foundNode;
     }
 
-    ObjectPool<ReadHandlerNode, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mNodesPool;
+    ObjectPool<ReadHandlerNode, kMaxReadHandlerNodes> mNodesPool;
     TimerDelegate * mTimerDelegate;
 };
 }; // namespace reporting
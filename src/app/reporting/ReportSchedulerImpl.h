@@ -39,7 +39,7 @@ public:
     void OnICDModeChange() override{};
 
     // ReadHandlerObserver
-    void OnSubscriptionEstablished(ReadHandler * aReadHandler) final;
+    void OnSubscriptionEstablished(ReadHandler * aReadHandler) override;
     void OnBecameReportable(ReadHandler * aReadHandler) final;
     void OnSubscriptionReportSent(ReadHandler * aReadHandler) final;
     void OnReadHandlerDestroyed(ReadHandler * aReadHandler) override;
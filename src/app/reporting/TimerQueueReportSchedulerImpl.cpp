@@ -0,0 +1,327 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/TimerQueueReportSchedulerImpl.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <functional>
+#include <string.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+using namespace System::Clock;
+using ReadHandlerNode = ReportScheduler::ReadHandlerNode;
+
+namespace {
+
+/// @brief Make room for one more entry in an array holding size entries, growing it if the node pool can grow as well
+template <typename T>
+CHIP_ERROR ReserveEntry(T *& array, size_t & capacity, size_t size)
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (size == capacity)
+    {
+        size_t newCapacity = (capacity > 0) ? capacity * 2 : ReportScheduler::kMaxReadHandlerNodes;
+        newCapacity        = chip::min<size_t>(newCapacity, ReadHandlerNode::kNotQueued);
+        VerifyOrReturnError(newCapacity > capacity, CHIP_ERROR_NO_MEMORY);
+
+        auto * newArray = static_cast<T *>(Platform::MemoryRealloc(array, newCapacity * sizeof(T)));
+        VerifyOrReturnError(newArray != nullptr, CHIP_ERROR_NO_MEMORY);
+        array    = newArray;
+        capacity = newCapacity;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    VerifyOrReturnError(size < capacity, CHIP_ERROR_NO_MEMORY);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+TimerQueueReportSchedulerImpl::~TimerQueueReportSchedulerImpl()
+{
+    // Unregistering the last handler releases the storage.
+    UnregisterAllHandlers();
+}
+
+void TimerQueueReportSchedulerImpl::OnSubscriptionEstablished(ReadHandler * aReadHandler)
+{
+    ReportSchedulerImpl::OnSubscriptionEstablished(aReadHandler);
+
+    // Look the new node up in the pool, as it is not in the index yet.
+    ReadHandlerNode * newNode = ReportScheduler::FindReadHandlerNode(aReadHandler);
+    VerifyOrReturn(nullptr != newNode);
+
+    CHIP_ERROR err = ReserveEntry(mIndex, mIndexCapacity, mIndexSize);
+    if (err != CHIP_NO_ERROR)
+    {
+        // The handler is still found in the pool, only more slowly.
+        ChipLogError(DataManagement, "Failed to index handler %p: %" CHIP_ERROR_FORMAT, aReadHandler, err.Format());
+        return;
+    }
+
+    size_t position = FindIndexPosition(aReadHandler);
+    memmove(&mIndex[position + 1], &mIndex[position], (mIndexSize - position) * sizeof(mIndex[0]));
+    mIndex[position] = newNode;
+    mIndexSize++;
+}
+
+void TimerQueueReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aReadHandler)
+{
+    ReadHandlerNode * removeNode = FindReadHandlerNode(aReadHandler);
+    // Nothing to remove if the handler is not found in the list
+    VerifyOrReturn(nullptr != removeNode);
+
+    size_t position = FindIndexPosition(aReadHandler);
+    if (position < mIndexSize && mIndex[position] == removeNode)
+    {
+        mIndexSize--;
+        memmove(&mIndex[position], &mIndex[position + 1], (mIndexSize - position) * sizeof(mIndex[0]));
+    }
+
+    Dequeue(removeNode);
+    mNodesPool.ReleaseObject(removeNode);
+    UpdateTimer(mTimerDelegate->GetCurrentMonotonicTimestamp());
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // Release the storage with the last handler, as the scheduler commonly outlives the platform memory.
+    if (!mNodesPool.Allocated())
+    {
+        Platform::MemoryFree(mQueue);
+        Platform::MemoryFree(mIndex);
+        mQueue         = nullptr;
+        mQueueCapacity = 0;
+        mIndex         = nullptr;
+        mIndexCapacity = 0;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+}
+
+ReadHandlerNode * TimerQueueReportSchedulerImpl::FindReadHandlerNode(const ReadHandler * aReadHandler)
+{
+    size_t position = FindIndexPosition(aReadHandler);
+    if (position < mIndexSize && mIndex[position]->GetReadHandler() == aReadHandler)
+    {
+        return mIndex[position];
+    }
+
+    // Nodes that could not be indexed are only found in the pool.
+    VerifyOrReturnValue(mIndexSize != mNodesPool.Allocated(), nullptr);
+    return ReportScheduler::FindReadHandlerNode(aReadHandler);
+}
+
+/// @brief Binary search of the position of a ReadHandler in the index, or of the position where it would be inserted
+size_t TimerQueueReportSchedulerImpl::FindIndexPosition(const ReadHandler * aReadHandler) const
+{
+    size_t low  = 0;
+    size_t high = mIndexSize;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (std::less<const ReadHandler *>()(mIndex[middle]->GetReadHandler(), aReadHandler))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/// @brief Checks if a report is scheduled in the queue for the ReadHandler
+bool TimerQueueReportSchedulerImpl::IsReportScheduled(ReadHandler * aReadHandler)
+{
+    ReadHandlerNode * node = FindReadHandlerNode(aReadHandler);
+    VerifyOrReturnValue(nullptr != node, false);
+    return node->GetQueueIndex() != ReadHandlerNode::kNotQueued;
+}
+
+CHIP_ERROR TimerQueueReportSchedulerImpl::ScheduleReport(Timeout timeout, ReadHandlerNode * node, const Timestamp & now)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    if (timeout == Milliseconds32(0))
+    {
+        Dequeue(node);
+        node->TimerFired();
+    }
+    else
+    {
+        err = Enqueue(node, now + timeout);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to schedule report for handler %p: %" CHIP_ERROR_FORMAT, node->GetReadHandler(),
+                         err.Format());
+        }
+    }
+
+    UpdateTimer(now);
+    return err;
+}
+
+/// @brief Callback called when the timer expires, marking the ReadHandlers whose report time has come as scheduled for an engine
+/// run and scheduling a single run for all of them
+void TimerQueueReportSchedulerImpl::TimerFired()
+{
+    Timestamp now     = mTimerDelegate->GetCurrentMonotonicTimestamp();
+    bool runScheduled = false;
+    mTimerActive      = false;
+
+    while (mQueueSize > 0 && mQueue[0].mReportTimestamp <= now)
+    {
+        ReadHandlerNode * node = mQueue[0].mNode;
+        Dequeue(node);
+        node->SetEngineRunScheduled(true);
+        runScheduled = true;
+    }
+
+    UpdateTimer(now);
+
+    if (runScheduled)
+    {
+        ReportTimerCallback();
+    }
+}
+
+CHIP_ERROR TimerQueueReportSchedulerImpl::Enqueue(ReadHandlerNode * node, const Timestamp & reportTimestamp)
+{
+    size_t index = node->GetQueueIndex();
+    if (index == ReadHandlerNode::kNotQueued)
+    {
+        ReturnErrorOnFailure(ReserveEntry(mQueue, mQueueCapacity, mQueueSize));
+        index = mQueueSize++;
+        SetQueueEntry(index, QueueEntry{ reportTimestamp, node });
+        SiftUp(index);
+        return CHIP_NO_ERROR;
+    }
+
+    Timestamp previousTimestamp    = mQueue[index].mReportTimestamp;
+    mQueue[index].mReportTimestamp = reportTimestamp;
+    if (reportTimestamp < previousTimestamp)
+    {
+        SiftUp(index);
+    }
+    else
+    {
+        SiftDown(index);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void TimerQueueReportSchedulerImpl::Dequeue(ReadHandlerNode * node)
+{
+    size_t index = node->GetQueueIndex();
+    VerifyOrReturn(index != ReadHandlerNode::kNotQueued);
+
+    node->SetQueueIndex(ReadHandlerNode::kNotQueued);
+    mQueueSize--;
+    VerifyOrReturn(index != mQueueSize);
+
+    // Move the last entry into the hole and restore the heap order around it.
+    Timestamp removedTimestamp = mQueue[index].mReportTimestamp;
+    SetQueueEntry(index, mQueue[mQueueSize]);
+    if (mQueue[index].mReportTimestamp < removedTimestamp)
+    {
+        SiftUp(index);
+    }
+    else
+    {
+        SiftDown(index);
+    }
+}
+
+void TimerQueueReportSchedulerImpl::SetQueueEntry(size_t index, const QueueEntry & entry)
+{
+    mQueue[index] = entry;
+    entry.mNode->SetQueueIndex(static_cast<uint16_t>(index));
+}
+
+void TimerQueueReportSchedulerImpl::SiftUp(size_t index)
+{
+    QueueEntry entry = mQueue[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!(entry.mReportTimestamp < mQueue[parent].mReportTimestamp))
+        {
+            break;
+        }
+        SetQueueEntry(index, mQueue[parent]);
+        index = parent;
+    }
+    SetQueueEntry(index, entry);
+}
+
+void TimerQueueReportSchedulerImpl::SiftDown(size_t index)
+{
+    QueueEntry entry = mQueue[index];
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= mQueueSize)
+        {
+            break;
+        }
+        if (child + 1 < mQueueSize && mQueue[child + 1].mReportTimestamp < mQueue[child].mReportTimestamp)
+        {
+            child++;
+        }
+        if (!(mQueue[child].mReportTimestamp < entry.mReportTimestamp))
+        {
+            break;
+        }
+        SetQueueEntry(index, mQueue[child]);
+        index = child;
+    }
+    SetQueueEntry(index, entry);
+}
+
+void TimerQueueReportSchedulerImpl::UpdateTimer(const Timestamp & now)
+{
+    if (mQueueSize == 0)
+    {
+        if (mTimerActive)
+        {
+            mTimerDelegate->CancelTimer(this);
+            mTimerActive = false;
+        }
+        return;
+    }
+
+    Timestamp nextTimestamp = mQueue[0].mReportTimestamp;
+    VerifyOrReturn(!mTimerActive || nextTimestamp != mTimerTimestamp);
+
+    mTimerDelegate->CancelTimer(this);
+    Timeout timeout = (nextTimestamp > now) ? Timeout(nextTimestamp - now) : Milliseconds32(0);
+    CHIP_ERROR err  = mTimerDelegate->StartTimer(this, timeout);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to start report timer: %" CHIP_ERROR_FORMAT, err.Format());
+        mTimerActive = false;
+        return;
+    }
+    mTimerActive    = true;
+    mTimerTimestamp = nextTimestamp;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
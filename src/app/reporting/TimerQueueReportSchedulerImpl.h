@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/reporting/ReportSchedulerImpl.h>
+#include <system/SystemConfig.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * Report scheduler that reports each ReadHandler at the same times as ReportSchedulerImpl, but keeps the scheduled reports
+ * in a min-heap ordered by report time and runs a single timer for the earliest one, instead of one timer per ReadHandler.
+ *
+ * ReadHandlers are also found through an index sorted by ReadHandler rather than by walking the node pool, so that handling
+ * a dirty or report sent event takes O(log n) in the number of subscriptions, which keeps the cost of these events low on
+ * devices with many subscriptions.
+ */
+class TimerQueueReportSchedulerImpl : public ReportSchedulerImpl, public TimerContext
+{
+public:
+    using Timeout         = System::Clock::Timeout;
+    using ReadHandlerNode = ReportScheduler::ReadHandlerNode;
+
+    TimerQueueReportSchedulerImpl(TimerDelegate * aTimerDelegate) : ReportSchedulerImpl(aTimerDelegate) {}
+    ~TimerQueueReportSchedulerImpl() override;
+
+    void OnSubscriptionEstablished(ReadHandler * aReadHandler) override;
+    void OnReadHandlerDestroyed(ReadHandler * aReadHandler) override;
+
+    bool IsReportScheduled(ReadHandler * aReadHandler) override;
+
+    void TimerFired() override;
+
+    /// @brief Number of ReadHandlers with a report scheduled in the queue
+    size_t GetNumScheduledReports() const { return mQueueSize; }
+
+protected:
+    ReadHandlerNode * FindReadHandlerNode(const ReadHandler * aReadHandler) override;
+    CHIP_ERROR ScheduleReport(Timeout timeout, ReadHandlerNode * node, const Timestamp & now) override;
+
+private:
+    friend class chip::app::reporting::TestReportScheduler;
+
+    struct QueueEntry
+    {
+        Timestamp mReportTimestamp;
+        ReadHandlerNode * mNode;
+    };
+
+    size_t FindIndexPosition(const ReadHandler * aReadHandler) const;
+
+    CHIP_ERROR Enqueue(ReadHandlerNode * node, const Timestamp & reportTimestamp);
+    void Dequeue(ReadHandlerNode * node);
+    void SetQueueEntry(size_t index, const QueueEntry & entry);
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+
+    /// @brief Start, restart or cancel the timer so that it fires at the earliest report time of the queue
+    void UpdateTimer(const Timestamp & now);
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // The node pool grows as needed, so do the queue and the index.
+    QueueEntry * mQueue       = nullptr;
+    size_t mQueueCapacity     = 0;
+    ReadHandlerNode ** mIndex = nullptr;
+    size_t mIndexCapacity     = 0;
+#else
+    static_assert(kMaxReadHandlerNodes < ReadHandlerNode::kNotQueued, "Too many ReadHandlers for the report queue");
+    QueueEntry mQueueStorage[kMaxReadHandlerNodes];
+    ReadHandlerNode * mIndexStorage[kMaxReadHandlerNodes];
+    QueueEntry * mQueue       = mQueueStorage;
+    size_t mQueueCapacity     = kMaxReadHandlerNodes;
+    ReadHandlerNode ** mIndex = mIndexStorage;
+    size_t mIndexCapacity     = kMaxReadHandlerNodes;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    size_t mIndexSize = 0;
+    size_t mQueueSize = 0;
+
+    bool mTimerActive = false;
+    Timestamp mTimerTimestamp;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -36,6 +36,11 @@
 #include <string.h>
 #include <vector>
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
+#include <thread>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 using TestContext = chip::Test::AppContext;
 using namespace chip::app;
 using namespace chip;
@@ -682,12 +687,250 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData),
                              AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
+
+    //
+    // Validate that the values of a cluster stay intact when other values of the cluster are replaced
+    // with smaller, larger or status values.
+    //
+    ChipLogProgress(DataManagement, "E0:D1 E0:A2 E0:C3 E0:B4 E0:D5s E0:A6 E0:D7 --> E0:A6 E0:B4 E0:C3 E0:D7");
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeC, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kStatus),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kData) });
+
+    ChipLogProgress(DataManagement, "E1:C1 E0:B2 E1:A3 E0:C4 E1:C5 --> E0:B2 E0:C4 E1:A3 E1:C5");
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeC, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData) });
+}
+
+class SnapshotCallback final : public ClusterStateCache::Callback
+{
+public:
+    void OnDone(ReadClient *) override {}
+
+    void OnClusterChanged(ClusterStateCache * cache, EndpointId endpointId, ClusterId clusterId) override
+    {
+        // Once snapshots are enabled, the snapshot is published before the change callbacks.
+        auto snapshot       = cache->GetSnapshot();
+        uint64_t generation = 0;
+        VerifyOrReturn(snapshot != nullptr);
+        NL_TEST_ASSERT(gSuite,
+                       snapshot->GetClusterGeneration(ConcreteClusterPath(endpointId, clusterId), generation) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, generation == snapshot->GetGeneration());
+    }
+};
+
+// Pass the given Int16u values of the UnitTesting cluster to the cache, using them as data versions as well.
+void AddInt16uData(ClusterStateCache & cache, const std::vector<std::pair<EndpointId, uint16_t>> & values)
+{
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+    for (auto & value : values)
+    {
+        uint8_t buf[16];
+        TLV::TLVWriter writer;
+        writer.Init(buf);
+        NL_TEST_ASSERT(gSuite, DataModel::Encode(writer, TLV::AnonymousTag(), value.second) == CHIP_NO_ERROR);
+
+        TLV::TLVReader reader;
+        reader.Init(buf, writer.GetLengthWritten());
+        NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+
+        ConcreteDataAttributePath path(value.first, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::Int16u::Id);
+        path.mDataVersion.SetValue(value.second);
+        callback.OnAttributeData(path, &reader, StatusIB());
+    }
+}
+
+// Send a report with the given Int16u values of the UnitTesting cluster.
+void SendInt16uReport(ClusterStateCache & cache, const std::vector<std::pair<EndpointId, uint16_t>> & values)
+{
+    cache.GetBufferedCallback().OnReportBegin();
+    AddInt16uData(cache, values);
+    cache.GetBufferedCallback().OnReportEnd();
+}
+
+void TestSnapshot(nlTestSuite * apSuite, void * apContext)
+{
+    using Int16u = Clusters::UnitTesting::Attributes::Int16u::TypeInfo;
+
+    SnapshotCallback callback;
+    ClusterStateCache cache(callback);
+    const ConcreteClusterPath cluster1(1, Clusters::UnitTesting::Id);
+    const ConcreteClusterPath cluster2(2, Clusters::UnitTesting::Id);
+    uint16_t value;
+    uint64_t generation;
+    Optional<DataVersion> version;
+
+    // Claim a wildcard path, so that the cache tracks data versions.
+    {
+        AttributePathParams wildcardPath;
+        uint8_t buf[20];
+        TLV::TLVWriter writer;
+        writer.Init(buf);
+        DataVersionFilterIBs::Builder builder;
+        NL_TEST_ASSERT(apSuite, builder.Init(&writer) == CHIP_NO_ERROR);
+        bool encodedDataVersionList = false;
+        NL_TEST_ASSERT(apSuite,
+                       cache.GetBufferedCallback().OnUpdateDataVersionFilterList(
+                           builder, Span<AttributePathParams>(&wildcardPath, 1), encodedDataVersionList) == CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(apSuite, cache.GetSnapshot() == nullptr);
+
+    // Enabling snapshots publishes the current content.
+    SendInt16uReport(cache, { { 1, 1 } });
+    NL_TEST_ASSERT(apSuite, cache.EnableSnapshots() == CHIP_NO_ERROR);
+    auto snapshot1 = cache.GetSnapshot();
+    NL_TEST_ASSERT(apSuite, snapshot1 != nullptr);
+    NL_TEST_ASSERT(apSuite, snapshot1->GetGeneration() == 1);
+    NL_TEST_ASSERT(apSuite, snapshot1->Get<Int16u>(1, value) == CHIP_NO_ERROR && value == 1);
+
+    // A new report publishes a new snapshot, and leaves the previous one unchanged.
+    SendInt16uReport(cache, { { 1, 2 }, { 2, 3 } });
+    auto snapshot2 = cache.GetSnapshot();
+    NL_TEST_ASSERT(apSuite, snapshot2 != snapshot1);
+    NL_TEST_ASSERT(apSuite, snapshot2->GetGeneration() == 2);
+    NL_TEST_ASSERT(apSuite, snapshot2->Get<Int16u>(1, value) == CHIP_NO_ERROR && value == 2);
+    NL_TEST_ASSERT(apSuite, snapshot2->Get<Int16u>(2, value) == CHIP_NO_ERROR && value == 3);
+    NL_TEST_ASSERT(apSuite, snapshot2->GetVersion(cluster1, version) == CHIP_NO_ERROR && version.ValueOr(0) == 2);
+    NL_TEST_ASSERT(apSuite, snapshot1->Get<Int16u>(1, value) == CHIP_NO_ERROR && value == 1);
+    NL_TEST_ASSERT(apSuite, snapshot1->Get<Int16u>(2, value) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite, snapshot1->GetVersion(cluster1, version) == CHIP_NO_ERROR && version.ValueOr(0) == 1);
+
+    // Clusters that did not change keep their generation.
+    SendInt16uReport(cache, { { 2, 4 } });
+    auto snapshot3 = cache.GetSnapshot();
+    NL_TEST_ASSERT(apSuite, snapshot3->GetGeneration() == 3);
+    NL_TEST_ASSERT(apSuite, snapshot3->GetClusterGeneration(cluster1, generation) == CHIP_NO_ERROR && generation == 2);
+    NL_TEST_ASSERT(apSuite, snapshot3->GetClusterGeneration(cluster2, generation) == CHIP_NO_ERROR && generation == 3);
+    NL_TEST_ASSERT(apSuite, snapshot3->Get<Int16u>(1, value) == CHIP_NO_ERROR && value == 2);
+
+    // A report without changes does not publish a new snapshot.
+    SendInt16uReport(cache, {});
+    NL_TEST_ASSERT(apSuite, cache.GetSnapshot() == snapshot3);
+
+    // The changes of a report that ends without OnReportEnd() are published with the next report.
+    cache.GetBufferedCallback().OnReportBegin();
+    AddInt16uData(cache, { { 1, 5 } });
+    NL_TEST_ASSERT(apSuite, cache.GetSnapshot() == snapshot3);
+    SendInt16uReport(cache, { { 2, 6 } });
+    auto snapshot4 = cache.GetSnapshot();
+    NL_TEST_ASSERT(apSuite, snapshot4->GetGeneration() == 4);
+    NL_TEST_ASSERT(apSuite, snapshot4->Get<Int16u>(1, value) == CHIP_NO_ERROR && value == 5);
+    NL_TEST_ASSERT(apSuite, snapshot4->Get<Int16u>(2, value) == CHIP_NO_ERROR && value == 6);
+    NL_TEST_ASSERT(apSuite, snapshot4->GetClusterGeneration(cluster1, generation) == CHIP_NO_ERROR && generation == 4);
+
+    // Statuses are part of snapshots as well.
+    {
+        StatusIB status(Protocols::InteractionModel::Status::Failure);
+        ConcreteDataAttributePath path(1, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::OctetString::Id);
+        cache.GetBufferedCallback().OnReportBegin();
+        cache.GetBufferedCallback().OnAttributeData(path, nullptr, status);
+        cache.GetBufferedCallback().OnReportEnd();
+
+        NL_TEST_ASSERT(apSuite, cache.GetSnapshot()->GetStatus(path, status) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, status.mStatus == Protocols::InteractionModel::Status::Failure);
+        NL_TEST_ASSERT(apSuite, snapshot4->GetStatus(path, status) == CHIP_ERROR_KEY_NOT_FOUND);
+    }
+
+    // Snapshots need the cache to store data.
+    ClusterStateCache noDataCache(callback, Optional<EventNumber>::Missing(), false);
+    NL_TEST_ASSERT(apSuite, noDataCache.EnableSnapshots() == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(apSuite, noDataCache.GetSnapshot() == nullptr);
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+void TestSnapshotThreads(nlTestSuite * apSuite, void * apContext)
+{
+    using Int16u = Clusters::UnitTesting::Attributes::Int16u::TypeInfo;
+
+    constexpr int kReaderCount          = 4;
+    constexpr uint16_t kReportCount     = 500;
+    constexpr EndpointId kEndpointCount = 4;
+
+    SnapshotCallback callback;
+    ClusterStateCache cache(callback);
+    std::vector<std::pair<EndpointId, uint16_t>> values;
+    for (EndpointId endpoint = 1; endpoint <= kEndpointCount; endpoint++)
+    {
+        values.emplace_back(endpoint, 0);
+    }
+    SendInt16uReport(cache, values);
+    NL_TEST_ASSERT(apSuite, cache.EnableSnapshots() == CHIP_NO_ERROR);
+
+    // Readers check that every snapshot they get holds the values of a single report, and that they never see an
+    // older report after a newer one. NL_TEST_ASSERT is not thread safe, so they only count what they find.
+    std::atomic<bool> done{ false };
+    std::atomic<uint32_t> readCount{ 0 };
+    std::atomic<uint32_t> inconsistentCount{ 0 };
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaderCount; i++)
+    {
+        readers.emplace_back([&] {
+            uint64_t lastGeneration = 0;
+            uint16_t lastValue      = 0;
+            while (!done)
+            {
+                auto snapshot = cache.GetSnapshot();
+                uint16_t firstValue;
+                if (snapshot->GetGeneration() < lastGeneration || snapshot->Get<Int16u>(1, firstValue) != CHIP_NO_ERROR ||
+                    firstValue < lastValue)
+                {
+                    inconsistentCount++;
+                    continue;
+                }
+                for (EndpointId endpoint = 2; endpoint <= kEndpointCount; endpoint++)
+                {
+                    uint16_t value;
+                    if (snapshot->Get<Int16u>(endpoint, value) != CHIP_NO_ERROR || value != firstValue)
+                    {
+                        inconsistentCount++;
+                    }
+                }
+                lastGeneration = snapshot->GetGeneration();
+                lastValue      = firstValue;
+                readCount++;
+            }
+        });
+    }
+
+    // This thread acts as the Matter thread updating the cache.
+    for (uint16_t report = 1; report <= kReportCount; report++)
+    {
+        for (auto & value : values)
+        {
+            value.second = report;
+        }
+        SendInt16uReport(cache, values);
+    }
+    done = true;
+    for (auto & reader : readers)
+    {
+        reader.join();
+    }
+
+    uint16_t value;
+    NL_TEST_ASSERT(apSuite, inconsistentCount == 0);
+    NL_TEST_ASSERT(apSuite, readCount > 0);
+    NL_TEST_ASSERT(apSuite, cache.GetSnapshot()->GetGeneration() == kReportCount + 1);
+    NL_TEST_ASSERT(apSuite, cache.GetSnapshot()->Get<Int16u>(kEndpointCount, value) == CHIP_NO_ERROR && value == kReportCount);
 }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestSnapshot", TestSnapshot),
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("TestSnapshotThreads", TestSnapshotThreads),
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     NL_TEST_SENTINEL()
 };
 
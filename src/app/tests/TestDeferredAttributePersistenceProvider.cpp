@@ -0,0 +1,176 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <app/DeferredAttributePersistenceProvider.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+const ConcreteAttributePath kDeferredPath = ConcreteAttributePath(1, 0x1234, 1);
+const ConcreteAttributePath kOtherPath    = ConcreteAttributePath(1, 0x1234, 2);
+
+class TestContext : public chip::Test::IOContext
+{
+public:
+    static int Initialize(void * context)
+    {
+        auto * ctx = static_cast<TestContext *>(context);
+        VerifyOrReturnError(ctx->Init() == CHIP_NO_ERROR, FAILURE);
+        VerifyOrReturnError(ctx->mPersister.Init(&ctx->mStorage) == CHIP_NO_ERROR, FAILURE);
+
+        DeviceLayer::SetSystemLayerForTesting(&ctx->GetSystemLayer());
+        ctx->mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&ctx->mMockClock);
+        return SUCCESS;
+    }
+
+    static int Finalize(void * context)
+    {
+        auto * ctx = static_cast<TestContext *>(context);
+        System::Clock::Internal::SetSystemClockForTesting(ctx->mRealClock);
+        DeviceLayer::SetSystemLayerForTesting(nullptr);
+        ctx->mPersister.Shutdown();
+        ctx->Shutdown();
+        return SUCCESS;
+    }
+
+    static int SetUp(void * context)
+    {
+        auto * ctx = static_cast<TestContext *>(context);
+        ctx->mStorage.ClearStorage();
+        return SUCCESS;
+    }
+
+    static int TearDown(void * context)
+    {
+        // Let any pending write happen so that the next test starts from a clean state.
+        auto * ctx = static_cast<TestContext *>(context);
+        ctx->AdvanceClockAndDriveIO(kMaxWriteDelay);
+        return SUCCESS;
+    }
+
+    void AdvanceClockAndDriveIO(System::Clock::Milliseconds64 time)
+    {
+        mMockClock.AdvanceMonotonic(time);
+        DriveIO();
+    }
+
+    bool IsPersisted(const ConcreteAttributePath & path)
+    {
+        return mStorage.SyncDoesKeyExist(
+            DefaultStorageKeyAllocator::AttributeValue(path.mEndpointId, path.mClusterId, path.mAttributeId).KeyName());
+    }
+
+    static constexpr System::Clock::Milliseconds32 kWriteDelay    = 5000_ms32;
+    static constexpr System::Clock::Milliseconds32 kMaxWriteDelay = 30000_ms32;
+
+    TestPersistentStorageDelegate mStorage;
+    DefaultAttributePersistenceProvider mPersister;
+    DeferredAttribute mDeferredAttribute{ kDeferredPath };
+    DeferredAttributePersistenceProvider mDeferredPersister{ mPersister, Span<DeferredAttribute>(&mDeferredAttribute, 1),
+                                                             kWriteDelay, kMaxWriteDelay };
+    System::Clock::Internal::MockClock mMockClock;
+
+private:
+    System::Clock::ClockBase * mRealClock = nullptr;
+};
+
+void TestPassesOnOtherAttributes(nlTestSuite * inSuite, void * inContext)
+{
+    auto * ctx    = static_cast<TestContext *>(inContext);
+    uint8_t value = 1;
+
+    NL_TEST_ASSERT(inSuite, ctx->mDeferredPersister.WriteValue(kOtherPath, ByteSpan(&value, sizeof(value))) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx->IsPersisted(kOtherPath));
+    NL_TEST_ASSERT(inSuite, ctx->mStorage.GetNumDurableWrites() == 1);
+}
+
+void TestCoalescesWrites(nlTestSuite * inSuite, void * inContext)
+{
+    auto * ctx = static_cast<TestContext *>(inContext);
+
+    for (uint8_t value = 0; value < 10; value++)
+    {
+        NL_TEST_ASSERT(inSuite, ctx->mDeferredPersister.WriteValue(kDeferredPath, ByteSpan(&value, sizeof(value))) == CHIP_NO_ERROR);
+        ctx->AdvanceClockAndDriveIO(100_ms);
+    }
+    NL_TEST_ASSERT(inSuite, !ctx->IsPersisted(kDeferredPath));
+
+    // Reads see the pending value.
+    uint8_t readValue = 0;
+    MutableByteSpan readSpan(&readValue, sizeof(readValue));
+    NL_TEST_ASSERT(inSuite, ctx->mDeferredPersister.ReadValue(kDeferredPath, nullptr, readSpan) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSpan.size() == 1 && readValue == 9);
+
+    // The value is written once it has not changed for the write delay.
+    ctx->AdvanceClockAndDriveIO(4800_ms);
+    NL_TEST_ASSERT(inSuite, !ctx->IsPersisted(kDeferredPath));
+    ctx->AdvanceClockAndDriveIO(100_ms);
+    NL_TEST_ASSERT(inSuite, ctx->IsPersisted(kDeferredPath));
+    NL_TEST_ASSERT(inSuite, ctx->mStorage.GetNumDurableWrites() == 1);
+}
+
+void TestMaxWriteDelay(nlTestSuite * inSuite, void * inContext)
+{
+    auto * ctx = static_cast<TestContext *>(inContext);
+
+    // An attribute that keeps changing is still written once the maximum write delay has passed.
+    for (uint8_t value = 0; value < 35; value++)
+    {
+        NL_TEST_ASSERT(inSuite, ctx->mDeferredPersister.WriteValue(kDeferredPath, ByteSpan(&value, sizeof(value))) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ctx->mStorage.GetNumDurableWrites() == (value < 30 ? 0u : 1u));
+        ctx->AdvanceClockAndDriveIO(1000_ms);
+    }
+
+    // The next maximum write delay starts with the first change after the write.
+    ctx->AdvanceClockAndDriveIO(TestContext::kWriteDelay);
+    NL_TEST_ASSERT(inSuite, ctx->mStorage.GetNumDurableWrites() == 2);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test passing on writes of other attributes", TestPassesOnOtherAttributes),
+    NL_TEST_DEF("Test coalescing writes", TestCoalescesWrites),
+    NL_TEST_DEF("Test maximum write delay", TestMaxWriteDelay),
+    NL_TEST_SENTINEL(),
+};
+
+} // namespace
+
+int TestDeferredAttributePersistenceProvider()
+{
+    nlTestSuite theSuite = { "DeferredAttributePersistenceProvider",
+                             &sTests[0],
+                             TestContext::Initialize,
+                             TestContext::Finalize,
+                             TestContext::SetUp,
+                             TestContext::TearDown };
+
+    return chip::ExecuteTestsWithContext<TestContext>(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDeferredAttributePersistenceProvider)
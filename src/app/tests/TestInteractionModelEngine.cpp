@@ -49,6 +49,8 @@ class TestInteractionModelEngine
 public:
     static void TestAttributePathParamsPushRelease(nlTestSuite * apSuite, void * apContext);
     static void TestRemoveDuplicateConcreteAttribute(nlTestSuite * apSuite, void * apContext);
+    static void TestAttributePathParamsArena(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscriptionPathQuota(nlTestSuite * apSuite, void * apContext);
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     static void TestSubscriptionResumptionTimer(nlTestSuite * apSuite, void * apContext);
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
@@ -229,6 +231,91 @@ void TestInteractionModelEngine::TestRemoveDuplicateConcreteAttribute(nlTestSuit
     InteractionModelEngine::GetInstance()->ReleaseAttributePathList(attributePathParamsList);
 }
 
+void TestInteractionModelEngine::TestAttributePathParamsArena(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    auto * engine     = InteractionModelEngine::GetInstance();
+    err               = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    ObjectListArena<AttributePathParams> arena;
+    ObjectList<AttributePathParams> * attributePathParamsList = nullptr;
+    AttributePathParams attributePathParams1;
+    AttributePathParams attributePathParams2;
+    AttributePathParams attributePathParams3;
+
+    // A wildcard cluster path and two concrete paths, the first of which it covers
+    attributePathParams1.mEndpointId  = Test::kMockEndpoint3;
+    attributePathParams1.mClusterId   = Test::MockClusterId(2);
+    attributePathParams1.mAttributeId = Test::MockAttributeId(1);
+
+    attributePathParams2.mEndpointId = Test::kMockEndpoint3;
+    attributePathParams2.mClusterId  = Test::MockClusterId(2);
+
+    attributePathParams3.mEndpointId  = Test::kMockEndpoint2;
+    attributePathParams3.mClusterId   = Test::MockClusterId(2);
+    attributePathParams3.mAttributeId = Test::MockAttributeId(1);
+
+    // The arena only has room for two nodes, so the third one comes from the pool.
+    NL_TEST_ASSERT(apSuite, arena.Reserve(2) == CHIP_NO_ERROR);
+    err = engine->PushFrontAttributePathList(attributePathParamsList, attributePathParams1, &arena);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = engine->PushFrontAttributePathList(attributePathParamsList, attributePathParams2, &arena);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = engine->PushFrontAttributePathList(attributePathParamsList, attributePathParams3, &arena);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, GetAttributePathListLength(attributePathParamsList) == 3);
+    NL_TEST_ASSERT(apSuite, attributePathParamsList->mValue.mEndpointId == Test::kMockEndpoint2);
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // The nodes from the arena follow each other in list order.
+    ObjectList<AttributePathParams> * arenaNode = attributePathParamsList->mpNext;
+    NL_TEST_ASSERT(apSuite, !arena.Contains(attributePathParamsList));
+    NL_TEST_ASSERT(apSuite, arena.Contains(arenaNode) && arena.Contains(arenaNode->mpNext));
+    NL_TEST_ASSERT(apSuite, arenaNode->mpNext == arenaNode + 1);
+    NL_TEST_ASSERT(apSuite, engine->mAttributePathPool.Allocated() == 1);
+#else
+    NL_TEST_ASSERT(apSuite, !arena.Contains(attributePathParamsList));
+    NL_TEST_ASSERT(apSuite, engine->mAttributePathPool.Allocated() == 3);
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    engine->RemoveDuplicateConcreteAttributePath(attributePathParamsList, &arena);
+    NL_TEST_ASSERT(apSuite, GetAttributePathListLength(attributePathParamsList) == 2);
+
+    engine->ReleaseAttributePathList(attributePathParamsList, &arena);
+    NL_TEST_ASSERT(apSuite, GetAttributePathListLength(attributePathParamsList) == 0);
+    NL_TEST_ASSERT(apSuite, engine->mAttributePathPool.Allocated() == 0);
+}
+
+void TestInteractionModelEngine::TestSubscriptionPathQuota(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    auto * engine     = InteractionModelEngine::GetInstance();
+    err               = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    engine->SetForceHandlerQuota(true);
+    engine->SetPathQuotaPerFabricForSubscriptions(4);
+    NL_TEST_ASSERT(apSuite, engine->GetPathCapForSubscriptions() == engine->GetPathPoolCapacityForSubscriptions());
+    NL_TEST_ASSERT(apSuite, engine->GetReadHandlerCapForSubscriptions() == engine->GetReadHandlerPoolCapacityForSubscriptions());
+
+    engine->SetForceHandlerQuota(false);
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
+    // Only paths are limited, and they are guaranteed per configured fabric.
+    NL_TEST_ASSERT(apSuite, engine->GetPathCapForSubscriptions() == 4u * engine->GetConfigMaxFabrics());
+    NL_TEST_ASSERT(apSuite, engine->GetReadHandlerCapForSubscriptions() == SIZE_MAX);
+
+    engine->SetPathQuotaPerFabricForSubscriptions(0);
+    NL_TEST_ASSERT(apSuite, engine->GetPathCapForSubscriptions() == SIZE_MAX);
+#else
+    NL_TEST_ASSERT(apSuite, engine->GetPathCapForSubscriptions() == engine->GetPathPoolCapacityForSubscriptions());
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && !CHIP_CONFIG_IM_FORCE_FABRIC_QUOTA_CHECK
+
+    engine->SetPathQuotaPerFabricForSubscriptions(-1);
+}
+
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
 void TestInteractionModelEngine::TestSubscriptionResumptionTimer(nlTestSuite * apSuite, void * apContext)
 {
@@ -271,6 +358,8 @@ const nlTest sTests[] =
         {
                 NL_TEST_DEF("TestAttributePathParamsPushRelease", chip::app::TestInteractionModelEngine::TestAttributePathParamsPushRelease),
                 NL_TEST_DEF("TestRemoveDuplicateConcreteAttribute", chip::app::TestInteractionModelEngine::TestRemoveDuplicateConcreteAttribute),
+                NL_TEST_DEF("TestAttributePathParamsArena", chip::app::TestInteractionModelEngine::TestAttributePathParamsArena),
+                NL_TEST_DEF("TestSubscriptionPathQuota", chip::app::TestInteractionModelEngine::TestSubscriptionPathQuota),
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
                 NL_TEST_DEF("TestSubscriptionResumptionTimer", chip::app::TestInteractionModelEngine::TestSubscriptionResumptionTimer),
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
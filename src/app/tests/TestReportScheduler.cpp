@@ -19,12 +19,16 @@
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/ReportSchedulerImpl.h>
 #include <app/reporting/SynchronizedReportSchedulerImpl.h>
+#include <app/reporting/TimerQueueReportSchedulerImpl.h>
 #include <app/tests/AppTestContext.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <nlunit-test.h>
 
+#include <random>
+#include <vector>
+
 namespace {
 
 using TestContext = chip::Test::AppContext;
@@ -49,6 +53,14 @@ using Milliseconds64      = System::Clock::Milliseconds64;
 
 static const size_t kNumMaxReadHandlers = 16;
 
+// Number of subscriptions in the scheduler simulation, limited by the scheduler node pool unless it grows on the heap. The load
+// measurement with thousands of subscriptions is in chip-app-report-scheduler-benchmark.
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+static const size_t kNumSimulatedSubscriptions = 200;
+#else
+static const size_t kNumSimulatedSubscriptions = kNumMaxReadHandlers;
+#endif
+
 class TestTimerDelegate : public ReportScheduler::TimerDelegate
 {
 public:
@@ -213,6 +225,9 @@ ReportSchedulerImpl sScheduler(&sTestTimerDelegate);
 TestTimerSynchronizedDelegate sTestTimerSynchronizedDelegate;
 SynchronizedReportSchedulerImpl syncScheduler(&sTestTimerSynchronizedDelegate);
 
+TestTimerSynchronizedDelegate sTestTimerQueueDelegate;
+TimerQueueReportSchedulerImpl queueScheduler(&sTestTimerQueueDelegate);
+
 class TestReportScheduler
 {
 public:
@@ -794,6 +809,198 @@ public:
         exchangeCtx->Close();
         NL_TEST_ASSERT(aSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
     }
+
+    static void TestTimerQueueScheduler(nlTestSuite * aSuite, void * aContext)
+    {
+        TestContext & ctx = *static_cast<TestContext *>(aContext);
+        NullReadHandlerCallback nullCallback;
+        // exchange context
+        Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+
+        // Read handler pool
+        ObjectPool<ReadHandler, kNumMaxReadHandlers> readHandlerPool;
+
+        // Initialize the mock system time
+        sTestTimerQueueDelegate.SetMockSystemTimestamp(Milliseconds64(0));
+
+        ReadHandler * readHandler1 =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &queueScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler1, &queueScheduler, 1, 2));
+        ReadHandler * readHandler2 =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &queueScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler2, &queueScheduler, 0, 3));
+        ReadHandler * readHandler3 =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &queueScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler3, &queueScheduler, 2, 5));
+
+        // Clean handlers are scheduled on their max interval, under a single timer for the earliest one
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumReadHandlers() == 3);
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumScheduledReports() == 3);
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportScheduled(readHandler1));
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportScheduled(readHandler2));
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportScheduled(readHandler3));
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerContext == &queueScheduler);
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(2000));
+
+        // Dirty handlers move up to their min interval
+        readHandler1->ForceDirtyState();
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(1000));
+        readHandler3->ForceDirtyState();
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(1000));
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumScheduledReports() == 3);
+
+        // Only readHandler1 is due when the timer fires on its min interval
+        sTestTimerQueueDelegate.IncrementMockTimestamp(Milliseconds64(1000));
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportableNow(readHandler1));
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportableNow(readHandler2));
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportableNow(readHandler3));
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportScheduled(readHandler1));
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumScheduledReports() == 2);
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(2000));
+
+        // Simulate a report emission for readHandler1, which is now clean and scheduled on its max interval
+        readHandler1->ClearForceDirtyFlag();
+        queueScheduler.OnSubscriptionReportSent(readHandler1);
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportableNow(readHandler1));
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportScheduled(readHandler1));
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumScheduledReports() == 3);
+
+        // Removing a handler removes its report
+        queueScheduler.OnReadHandlerDestroyed(readHandler2);
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumReadHandlers() == 2);
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumScheduledReports() == 2);
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(2000));
+
+        // readHandler3 is due on its min interval
+        sTestTimerQueueDelegate.IncrementMockTimestamp(Milliseconds64(1000));
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportableNow(readHandler1));
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportableNow(readHandler3));
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(3000));
+
+        readHandler3->ClearForceDirtyFlag();
+        queueScheduler.OnSubscriptionReportSent(readHandler3);
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportableNow(readHandler3));
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(3000));
+
+        // readHandler1 is due on its max interval
+        sTestTimerQueueDelegate.IncrementMockTimestamp(Milliseconds64(1000));
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportableNow(readHandler1));
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportableNow(readHandler3));
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(7000));
+
+        // Becoming dirty past the min interval reports right away
+        queueScheduler.OnSubscriptionReportSent(readHandler1);
+        sTestTimerQueueDelegate.IncrementMockTimestamp(Milliseconds64(1500));
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportableNow(readHandler3));
+        readHandler3->ForceDirtyState();
+        NL_TEST_ASSERT(aSuite, queueScheduler.IsReportableNow(readHandler3));
+        NL_TEST_ASSERT(aSuite, !queueScheduler.IsReportScheduled(readHandler3));
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumScheduledReports() == 1);
+        NL_TEST_ASSERT(aSuite, sTestTimerQueueDelegate.mTimerTimeout == Milliseconds64(5000));
+
+        // The timer is stopped once no report is scheduled
+        queueScheduler.UnregisterAllHandlers();
+        NL_TEST_ASSERT(aSuite, queueScheduler.GetNumScheduledReports() == 0);
+        NL_TEST_ASSERT(aSuite, !sTestTimerQueueDelegate.IsTimerActive(&queueScheduler));
+
+        readHandlerPool.ReleaseAll();
+        exchangeCtx->Close();
+        NL_TEST_ASSERT(aSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+    }
+
+    /// @brief Simulates numSubscriptions subscriptions with random intervals that become dirty at random, running the engine on
+    /// every 10ms tick, and checks that every report is sent between the min and max intervals.
+    template <typename Scheduler>
+    static void SimulateSubscriptions(nlTestSuite * aSuite, TestContext & ctx, Scheduler & scheduler,
+                                      TestTimerSynchronizedDelegate & timerDelegate, size_t numSubscriptions)
+    {
+        constexpr uint32_t kSimulatedSeconds = 60;
+        constexpr uint32_t kTickMs           = 10;
+        constexpr uint32_t kDirtyPerSecond   = 500;
+
+        NullReadHandlerCallback nullCallback;
+        Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+        ObjectPool<ReadHandler, kNumSimulatedSubscriptions> readHandlerPool;
+        std::vector<ReadHandler *> readHandlers;
+        std::vector<ReadHandlerNode *> nodes;
+        std::mt19937 random(0x5eed);
+        std::uniform_int_distribution<uint16_t> minInterval(0, 5);
+        std::uniform_int_distribution<uint16_t> maxInterval(10, 60);
+        std::uniform_int_distribution<size_t> handlerIndex(0, numSubscriptions - 1);
+        std::uniform_int_distribution<uint32_t> dirtyCount(0, 2 * kDirtyPerSecond * kTickMs / 1000);
+
+        timerDelegate.SetMockSystemTimestamp(Milliseconds64(0));
+
+        for (size_t i = 0; i < numSubscriptions; i++)
+        {
+            ReadHandler * readHandler =
+                readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &scheduler);
+            NL_TEST_ASSERT(aSuite, nullptr != readHandler);
+            VerifyOrReturn(nullptr != readHandler);
+            uint16_t min = minInterval(random);
+            uint16_t max = maxInterval(random);
+            NL_TEST_ASSERT(aSuite,
+                           CHIP_NO_ERROR ==
+                               MockReadHandlerSubscriptionTransaction(readHandler, &scheduler, static_cast<uint8_t>(min),
+                                                                      static_cast<uint8_t>(max)));
+            readHandlers.push_back(readHandler);
+            nodes.push_back(scheduler.FindReadHandlerNode(readHandler));
+        }
+        NL_TEST_ASSERT(aSuite, scheduler.GetNumReadHandlers() == numSubscriptions);
+
+        uint32_t numReports = 0;
+        uint32_t numEarly   = 0;
+        uint32_t numLate    = 0;
+
+        for (uint32_t tick = 0; tick < kSimulatedSeconds * 1000 / kTickMs; tick++)
+        {
+            // Attributes change
+            for (uint32_t i = dirtyCount(random); i > 0; i--)
+            {
+                ReadHandler * readHandler = readHandlers[handlerIndex(random)];
+                readHandler->ForceDirtyState();
+            }
+
+            // Time passes, firing the timers that expire
+            timerDelegate.IncrementMockTimestamp(Milliseconds64(kTickMs));
+
+            // The engine runs, sending the reports of the handlers that are reportable
+            Timestamp now = timerDelegate.GetCurrentMonotonicTimestamp();
+            for (size_t i = 0; i < numSubscriptions; i++)
+            {
+                ReadHandler * readHandler = readHandlers[i];
+                ReadHandlerNode * node    = nodes[i];
+                if (!node->IsReportableNow(now))
+                {
+                    continue;
+                }
+
+                numEarly += (now < node->GetMinTimestamp()) ? 1 : 0;
+                numLate  += (now > node->GetMaxTimestamp() + Milliseconds64(kTickMs)) ? 1 : 0;
+                numReports++;
+
+                readHandler->ClearForceDirtyFlag();
+                scheduler.OnSubscriptionReportSent(readHandler);
+            }
+        }
+
+        // No report is sent before the min interval, or more than a tick after the max interval
+        NL_TEST_ASSERT(aSuite, numEarly == 0);
+        NL_TEST_ASSERT(aSuite, numLate == 0);
+        NL_TEST_ASSERT(aSuite, numReports >= numSubscriptions);
+
+        scheduler.UnregisterAllHandlers();
+        readHandlerPool.ReleaseAll();
+        exchangeCtx->Close();
+        NL_TEST_ASSERT(aSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+    }
+
+    static void TestTimerQueueSchedulerManySubscriptions(nlTestSuite * aSuite, void * aContext)
+    {
+        TestContext & ctx = *static_cast<TestContext *>(aContext);
+        SimulateSubscriptions(aSuite, ctx, queueScheduler, sTestTimerQueueDelegate, kNumSimulatedSubscriptions);
+        SimulateSubscriptions(aSuite, ctx, syncScheduler, sTestTimerSynchronizedDelegate, kNumSimulatedSubscriptions);
+    }
 };
 
 } // namespace reporting
@@ -811,6 +1018,9 @@ static nlTest sTests[] = {
     NL_TEST_DEF("TestReportTiming", chip::app::reporting::TestReportScheduler::TestReportTiming),
     NL_TEST_DEF("TestObserverCallbacks", chip::app::reporting::TestReportScheduler::TestObserverCallbacks),
     NL_TEST_DEF("TestSynchronizedScheduler", chip::app::reporting::TestReportScheduler::TestSynchronizedScheduler),
+    NL_TEST_DEF("TestTimerQueueScheduler", chip::app::reporting::TestReportScheduler::TestTimerQueueScheduler),
+    NL_TEST_DEF("TestTimerQueueSchedulerManySubscriptions",
+                chip::app::reporting::TestReportScheduler::TestTimerQueueSchedulerManySubscriptions),
     NL_TEST_SENTINEL(),
 };
 
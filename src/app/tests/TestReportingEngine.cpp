@@ -22,6 +22,7 @@
  *
  */
 
+#include <access/AccessControl.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/Engine.h>
@@ -55,11 +56,22 @@ class TestReportingEngine
 {
 public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
-    static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
+    static void TestDirtySetSupersetLookup(nlTestSuite * apSuite, void * apContext);
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    static void TestDirtySetGrowsWithHeapPools(nlTestSuite * apSuite, void * apContext);
+#else
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+#endif
+    static void TestSetDirtyNotifiesInterestedReadHandlers(nlTestSuite * apSuite, void * apContext);
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    static void TestReportEncodingCache(nlTestSuite * apSuite, void * apContext);
+    static void TestReportEncodingCacheAccessAndFabrics(nlTestSuite * apSuite, void * apContext);
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
 
 private:
+#if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
     static bool InsertToDirtySet(const AttributePathParams & aPath);
+#endif
 
     struct ExpectedDirtySetContent : public AttributePathParams
     {
@@ -73,10 +85,10 @@ private:
         const int size                        = sizeof...(args);
         ExpectedDirtySetContent content[size] = { ExpectedDirtySetContent(args)... };
 
-        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
+        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEach([&](auto * path) {
                 for (int i = 0; i < size; i++)
                 {
-                    if (static_cast<AttributePathParams>(content[i]) == static_cast<AttributePathParams>(*path))
+                    if (static_cast<AttributePathParams>(content[i]) == path->GetPath())
                     {
                         content[i].verified = true;
                         return Loop::Continue;
@@ -168,75 +180,100 @@ void TestReportingEngine::TestBuildAndSendSingleReportData(nlTestSuite * apSuite
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 }
 
-void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext)
+void TestReportingEngine::TestDirtySetSupersetLookup(nlTestSuite * apSuite, void * apContext)
+{
+    DirtyAttributePathSet dirtySet;
+
+    dirtySet.Insert(AttributePathParams(1, 1, 1), 2);
+    NL_TEST_ASSERT(apSuite, dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 1), 1));
+    NL_TEST_ASSERT(apSuite, !dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 1), 2));
+    NL_TEST_ASSERT(apSuite, !dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 3), 1));
+
+    // A path with a list index marks the whole attribute dirty.
+    dirtySet.Insert(AttributePathParams(1, 1, 1, 2), 3);
+    NL_TEST_ASSERT(apSuite, dirtySet.Size() == 1);
+    NL_TEST_ASSERT(apSuite, dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 1), 2));
+
+    // Sibling attributes keep their own generations.
+    dirtySet.Insert(AttributePathParams(1, 1, 3), 4);
+    NL_TEST_ASSERT(apSuite, dirtySet.Size() == 2);
+    NL_TEST_ASSERT(apSuite, !dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 1), 3));
+    NL_TEST_ASSERT(apSuite, dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 3), 3));
+
+    // Wildcard paths are found for any concrete path under them, and replace the paths they cover.
+    dirtySet.Insert(AttributePathParams(kInvalidEndpointId, 2, 1), 5);
+    NL_TEST_ASSERT(apSuite, dirtySet.IsDirtySince(ConcreteAttributePath(7, 2, 1), 4));
+    NL_TEST_ASSERT(apSuite, !dirtySet.IsDirtySince(ConcreteAttributePath(7, 2, 2), 4));
+
+    dirtySet.Insert(AttributePathParams(EndpointId(1), ClusterId(1)), 6);
+    NL_TEST_ASSERT(apSuite, dirtySet.Size() == 2);
+    NL_TEST_ASSERT(apSuite, dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 5), 5));
+    NL_TEST_ASSERT(apSuite, !dirtySet.IsDirtySince(ConcreteAttributePath(1, 2, 5), 5));
+
+    dirtySet.Insert(AttributePathParams(), 7);
+    NL_TEST_ASSERT(apSuite, dirtySet.Size() == 1);
+    NL_TEST_ASSERT(apSuite, dirtySet.IsDirtySince(ConcreteAttributePath(9, 9, 9), 6));
+
+    // Pruning drops the paths that are not newer than the given generation.
+    dirtySet.Insert(AttributePathParams(1, 1, 1), 8);
+    dirtySet.RemoveUpTo(7);
+    NL_TEST_ASSERT(apSuite, dirtySet.Size() == 1);
+    NL_TEST_ASSERT(apSuite, !dirtySet.IsDirtySince(ConcreteAttributePath(9, 9, 9), 0));
+    NL_TEST_ASSERT(apSuite, dirtySet.IsDirtySince(ConcreteAttributePath(1, 1, 1), 7));
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+void TestReportingEngine::TestDirtySetGrowsWithHeapPools(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(apContext);
-    CHIP_ERROR err    = CHIP_NO_ERROR;
-    err               = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+    CHIP_ERROR err    = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
                                                                     app::reporting::GetDefaultReportScheduler());
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 
-    AttributePathParams * clusterInfo = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    clusterInfo->mEndpointId          = 1;
-    clusterInfo->mClusterId           = 1;
-    clusterInfo->mAttributeId         = 1;
-
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.mGlobalDirtySet.Clear();
+    engine.BumpDirtySetGeneration();
+    uint64_t generationBefore = engine.GetDirtySetGeneration();
+    engine.BumpDirtySetGeneration();
+
+    // Far more paths than CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, over several clusters and endpoints, are all kept as given
+    // instead of being merged into wildcard paths.
+    constexpr uint32_t kPathCount = CHIP_IM_SERVER_MAX_NUM_DIRTY_SET * 10;
+    size_t endpoint0PathCount     = 0;
+    for (uint32_t i = 0; i < kPathCount; i++)
     {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = 1;
-        testClusterInfo.mClusterId   = 1;
-        testClusterInfo.mAttributeId = 3;
-        NL_TEST_ASSERT(apSuite,
-                       !InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-    }
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = 1;
-        testClusterInfo.mClusterId   = 1;
-        testClusterInfo.mAttributeId = 1;
-        testClusterInfo.mListIndex   = 2;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        // Insert out of order.
+        uint32_t n = (i * 7) % kPathCount;
+        engine.InsertPathIntoDirtySet(AttributePathParams(EndpointId(n % 3), ClusterId(n % 5), AttributeId(n)));
+        endpoint0PathCount += (n % 3 == 0);
     }
+    NL_TEST_ASSERT(apSuite, engine.GetGlobalDirtySetSize() == kPathCount);
 
+    for (uint32_t n = 0; n < kPathCount; n++)
     {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = 1;
-        testClusterInfo.mClusterId   = 1;
-        testClusterInfo.mAttributeId = kInvalidAttributeId;
         NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-    }
-
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mClusterId   = kInvalidClusterId;
-        testClusterInfo.mAttributeId = kInvalidAttributeId;
+                       engine.mGlobalDirtySet.IsDirtySince(ConcreteAttributePath(EndpointId(n % 3), ClusterId(n % 5), n),
+                                                           generationBefore));
         NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        NL_TEST_ASSERT(apSuite, clusterInfo->mClusterId == kInvalidClusterId && clusterInfo->mAttributeId == kInvalidAttributeId);
+                       !engine.mGlobalDirtySet.IsDirtySince(ConcreteAttributePath(EndpointId(n % 3), ClusterId(n % 5), n + 1),
+                                                            generationBefore));
     }
 
-    {
-        AttributePathParams testClusterInfo;
-        testClusterInfo.mEndpointId  = kInvalidEndpointId;
-        testClusterInfo.mClusterId   = kInvalidClusterId;
-        testClusterInfo.mAttributeId = kInvalidAttributeId;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        NL_TEST_ASSERT(apSuite,
-                       clusterInfo->mEndpointId == kInvalidEndpointId && clusterInfo->mClusterId == kInvalidClusterId &&
-                           clusterInfo->mAttributeId == kInvalidAttributeId);
-    }
-    InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
-}
+    // A wildcard path still replaces the paths it covers.
+    engine.InsertPathIntoDirtySet(AttributePathParams(EndpointId(0), kInvalidClusterId));
+    NL_TEST_ASSERT(apSuite, engine.GetGlobalDirtySetSize() == kPathCount - endpoint0PathCount + 1);
+
+    engine.mGlobalDirtySet.RemoveUpTo(engine.GetDirtySetGeneration());
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.Empty());
 
+    engine.Shutdown();
+}
+#else
 bool TestReportingEngine::InsertToDirtySet(const AttributePathParams & aPath)
 {
-    auto path = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    VerifyOrReturnError(path != nullptr, false);
-    *path             = aPath;
-    path->mGeneration = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    VerifyOrReturnError(engine.mGlobalDirtySet.Size() < DirtyAttributePathSet::kCapacity, false);
+    engine.mGlobalDirtySet.Insert(aPath, engine.GetDirtySetGeneration());
     return true;
 }
 
@@ -248,7 +285,7 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
                                                                     app::reporting::GetDefaultReportScheduler());
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
     InteractionModelEngine::GetInstance()->GetReportingEngine().BumpDirtySetGeneration();
 
     // Case 1: All dirty paths including the new one are under the same cluster.
@@ -257,13 +294,11 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     {
         NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, i)));
     }
-    NL_TEST_ASSERT(apSuite,
-                   CHIP_NO_ERROR ==
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
-                           AttributePathParams(kTestEndpointId, kTestClusterId, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1)));
+    InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
+        AttributePathParams(kTestEndpointId, kTestClusterId, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1));
     NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 2: All dirty paths including the new one are under the same endpoint.
     // -> Expected behavior: The dirty set is replaced by a wildcard cluster path under the same endpoint.
@@ -271,13 +306,11 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     {
         NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(kTestEndpointId, i, 1)));
     }
-    NL_TEST_ASSERT(apSuite,
-                   CHIP_NO_ERROR ==
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
-                           AttributePathParams(kTestEndpointId, ClusterId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1)));
+    InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
+        AttributePathParams(kTestEndpointId, ClusterId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1));
     NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 3: All dirty paths including the new one are under the different endpoints.
     // -> Expected behavior: The dirty set is replaced by a wildcard endpoint.
@@ -285,13 +318,11 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     {
         NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(EndpointId(i), i, i)));
     }
-    NL_TEST_ASSERT(apSuite,
-                   CHIP_NO_ERROR ==
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
-                           AttributePathParams(EndpointId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1, 1)));
+    InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
+        AttributePathParams(EndpointId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1, 1));
     NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams()));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 4: All existing dirty paths are under the same cluster, the new path comes from another cluster.
     // -> Expected behavior: The existing paths are merged into one single wildcard attribute path. New path is inserted as-is.
@@ -299,15 +330,13 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     {
         NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, i)));
     }
-    NL_TEST_ASSERT(apSuite,
-                   CHIP_NO_ERROR ==
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
-                           AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
+    InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
+        AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1));
     NL_TEST_ASSERT(apSuite,
                    VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId),
                                          AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 5: All existing dirty paths are under the same endpoint, the new path comes from another endpoint.
     // -> Expected behavior: The existing paths are merged into one single wildcard cluster path. New path is inserted as-is.
@@ -315,16 +344,282 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     {
         NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(kTestEndpointId, i, 1)));
     }
-    NL_TEST_ASSERT(apSuite,
-                   CHIP_NO_ERROR ==
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
-                           AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
+    InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
+        AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1));
     NL_TEST_ASSERT(apSuite,
                    VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId),
                                          AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+void TestReportingEngine::TestSetDirtyNotifiesInterestedReadHandlers(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+                                                                    app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+
+    const AttributePathParams interestPaths[] = {
+        AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1),
+        AttributePathParams(kTestEndpointId, kTestClusterId),
+        AttributePathParams(kTestClusterId, kTestFieldId2),
+        AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, kTestFieldId1),
+    };
+    ReadHandler * readHandlers[ArraySize(interestPaths)];
+    for (size_t i = 0; i < ArraySize(interestPaths); i++)
+    {
+        readHandlers[i] = InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+            dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+            app::reporting::GetDefaultReportScheduler());
+        NL_TEST_ASSERT(apSuite, readHandlers[i] != nullptr);
+
+        AttributePathParams path = interestPaths[i];
+        err = InteractionModelEngine::GetInstance()->PushFrontAttributePathList(readHandlers[i]->mpAttributePathList, path);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        engine.AddAttributePathInterest(*readHandlers[i]);
+        readHandlers[i]->mState = ReadHandler::HandlerState::CanStartReporting;
+    }
+
+    auto notified = [&](size_t i) { return readHandlers[i]->mDirtyGeneration == engine.GetDirtySetGeneration(); };
+
+    // A concrete path reaches the handlers interested in it, exactly or through wildcards, and no others.
+    AttributePathParams dirtyPath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, notified(0) && notified(1) && !notified(2) && !notified(3));
+
+    dirtyPath = AttributePathParams(kTestEndpointId + 5, kTestClusterId, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !notified(0) && !notified(1) && notified(2) && !notified(3));
+
+    // A path nobody is interested in is not added to the dirty set.
+    size_t dirtySetSize = engine.GetGlobalDirtySetSize();
+    dirtyPath           = AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !notified(0) && !notified(1) && !notified(2) && !notified(3));
+    NL_TEST_ASSERT(apSuite, engine.GetGlobalDirtySetSize() == dirtySetSize);
+
+    // A wildcard path is checked against every handler.
+    dirtyPath = AttributePathParams(kTestEndpointId, kTestClusterId);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, notified(0) && notified(1) && notified(2) && !notified(3));
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    // Only attributes that several handlers are interested in have their encodings shared.
+    NL_TEST_ASSERT(apSuite,
+                   engine.IsAttributeOfInterestToSeveralReadHandlers(
+                       ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId1)));
+    NL_TEST_ASSERT(apSuite,
+                   engine.IsAttributeOfInterestToSeveralReadHandlers(
+                       ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId2)));
+    NL_TEST_ASSERT(apSuite,
+                   !engine.IsAttributeOfInterestToSeveralReadHandlers(
+                       ConcreteAttributePath(kTestEndpointId + 1, kTestClusterId + 1, kTestFieldId1)));
+    NL_TEST_ASSERT(apSuite,
+                   !engine.IsAttributeOfInterestToSeveralReadHandlers(
+                       ConcreteAttributePath(kTestEndpointId + 1, kTestClusterId + 1, kTestFieldId2)));
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+    // Destroyed handlers leave the index.
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(readHandlers[1]);
+    dirtyPath = AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, notified(0) && !notified(2) && !notified(3));
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    NL_TEST_ASSERT(apSuite,
+                   !engine.IsAttributeOfInterestToSeveralReadHandlers(
+                       ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId1)));
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+    for (size_t i : { 0, 2, 3 })
+    {
+        InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(readHandlers[i]);
+    }
+    NL_TEST_ASSERT(apSuite, engine.mAttributePathInterestPool.Allocated() == 0);
+
+    engine.Shutdown();
+    ctx.DrainAndServiceIO();
+}
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+namespace {
+
+CHIP_ERROR EncodeTestAttribute(AttributeReportIBs::Builder & aAttributeReportIBs, const ConcreteAttributePath & aPath)
+{
+    AttributeValueEncoder encoder(aAttributeReportIBs, kUndefinedFabricIndex, aPath, 5 /* data version */);
+    return encoder.Encode(static_cast<uint32_t>(0x12345678));
+}
+
+// Encode into an anonymous AttributeReportIBs array the same way ReportEncodingCache does.
+template <typename EncodeFunction>
+CHIP_ERROR EncodeReportIBs(uint8_t * aBuffer, size_t aBufferSize, uint32_t & aLength, EncodeFunction && aEncode)
+{
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder attributeReportIBs;
+    writer.Init(aBuffer, aBufferSize);
+    ReturnErrorOnFailure(attributeReportIBs.Init(&writer));
+    ReturnErrorOnFailure(aEncode(attributeReportIBs));
+    ReturnErrorOnFailure(attributeReportIBs.EndOfAttributeReportIBs());
+    ReturnErrorOnFailure(writer.Finalize());
+    aLength = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+void TestReportingEngine::TestReportEncodingCache(nlTestSuite * apSuite, void * apContext)
+{
+    ReportEncodingCache cache;
+    const ConcreteAttributePath path(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    ConcreteAttributePath expandedPath = path;
+    expandedPath.mExpanded             = true;
+    auto encode = [&](AttributeReportIBs::Builder & attributeReportIBs) { return EncodeTestAttribute(attributeReportIBs, path); };
+
+    // Nothing is cached while the engine is not running.
+    NL_TEST_ASSERT(apSuite, cache.Add(path, 1, true, 1, encode) == nullptr);
+
+    cache.Begin();
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 1, true, 1) == nullptr);
+    const ReportEncodingCache::Entry * entry = cache.Add(path, 1, true, 1, encode);
+    NL_TEST_ASSERT(apSuite, entry != nullptr);
+    NL_TEST_ASSERT(apSuite, entry->mDataVersion.HasValue() && entry->mDataVersion.Value() == 5);
+
+    // Encodings are only found for the same fabric, fabric filtering, expansion and dirty set generation.
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 1, true, 1) == entry);
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 2, true, 1) == nullptr);
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 1, false, 1) == nullptr);
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 1, true, 2) == nullptr);
+    NL_TEST_ASSERT(apSuite, cache.Find(expandedPath, 1, true, 1) == nullptr);
+
+    // Failed encodings are not cached.
+    auto fail = [](AttributeReportIBs::Builder &) { return CHIP_ERROR_NO_MEMORY; };
+    NL_TEST_ASSERT(apSuite, cache.Add(expandedPath, 1, true, 1, fail) == nullptr);
+    NL_TEST_ASSERT(apSuite, cache.NumEntries() == 1);
+
+    // Copying the encoding gives the same bytes as encoding the attribute directly.
+    uint8_t expected[128];
+    uint8_t copied[128];
+    uint32_t expectedLength = 0;
+    uint32_t copiedLength   = 0;
+    NL_TEST_ASSERT(apSuite, EncodeReportIBs(expected, sizeof(expected), expectedLength, encode) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   EncodeReportIBs(copied, sizeof(copied), copiedLength, [&](AttributeReportIBs::Builder & attributeReportIBs) {
+                       return cache.CopyTo(*entry, attributeReportIBs);
+                   }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, copiedLength == expectedLength && memcmp(copied, expected, expectedLength) == 0);
+
+    // Copying fails if the encoding does not fit.
+    NL_TEST_ASSERT(apSuite,
+                   EncodeReportIBs(copied, expectedLength - 2, copiedLength, [&](AttributeReportIBs::Builder & attributeReportIBs) {
+                       return cache.CopyTo(*entry, attributeReportIBs);
+                   }) != CHIP_NO_ERROR);
+
+    cache.End();
+    NL_TEST_ASSERT(apSuite, cache.Find(path, 1, true, 1) == nullptr);
+    NL_TEST_ASSERT(apSuite, cache.NumEntries() == 0);
+}
+
+namespace {
+
+// Denies every request from one fabric and grants all others.
+class DenyFabricAccessControlDelegate : public Access::AccessControl::Delegate
+{
+public:
+    CHIP_ERROR Check(const Access::SubjectDescriptor & subjectDescriptor, const Access::RequestPath & requestPath,
+                     Access::Privilege requestPrivilege) override
+    {
+        return (subjectDescriptor.fabricIndex == mDeniedFabricIndex) ? CHIP_ERROR_ACCESS_DENIED : CHIP_NO_ERROR;
+    }
+
+    FabricIndex mDeniedFabricIndex = kUndefinedFabricIndex;
+};
+
+class TestDeviceTypeResolver : public Access::AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+};
+
+} // namespace
+
+void TestReportingEngine::TestReportEncodingCacheAccessAndFabrics(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    Engine & engine   = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    DenyFabricAccessControlDelegate accessControlDelegate;
+    TestDeviceTypeResolver deviceTypeResolver;
+
+    Access::GetAccessControl().Finish();
+    NL_TEST_ASSERT(apSuite, Access::GetAccessControl().Init(&accessControlDelegate, deviceTypeResolver) == CHIP_NO_ERROR);
+
+    // Two subscribers on Bob's fabric, one of them fabric filtered, and one on Alice's fabric.
+    ReadHandler bobHandler(dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+                           app::reporting::GetDefaultReportScheduler());
+    ReadHandler bobFilteredHandler(dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+                                   app::reporting::GetDefaultReportScheduler());
+    ReadHandler aliceHandler(dummy, ctx.NewExchangeToBob(&delegate), ReadHandler::InteractionType::Read,
+                             app::reporting::GetDefaultReportScheduler());
+    bobFilteredHandler.SetStateFlag(ReadHandler::ReadHandlerFlags::FabricFiltered);
+    NL_TEST_ASSERT(apSuite, bobHandler.GetSubjectDescriptor().fabricIndex == ctx.GetBobFabricIndex());
+    NL_TEST_ASSERT(apSuite, aliceHandler.GetSubjectDescriptor().fabricIndex == ctx.GetAliceFabricIndex());
+
+    // Outside of the test cluster, so that it is encoded without a data version the cached encoding would be checked against.
+    const ConcreteReadAttributePath path(kTestEndpointId, kTestClusterId + 1, kTestFieldId1);
+    uint8_t buffer[256];
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder attributeReportIBs;
+    writer.Init(buffer, sizeof(buffer));
+    NL_TEST_ASSERT(apSuite, attributeReportIBs.Init(&writer) == CHIP_NO_ERROR);
+
+    // Every fabric and fabric filtering gets its own encoding, made with its own subject descriptor.
+    engine.mReportEncodingCache.Begin();
+    NL_TEST_ASSERT(apSuite, engine.RetrieveClusterDataFromCache(bobHandler, attributeReportIBs, path));
+    NL_TEST_ASSERT(apSuite, engine.mReportEncodingCache.NumEntries() == 1);
+    NL_TEST_ASSERT(apSuite, engine.RetrieveClusterDataFromCache(bobHandler, attributeReportIBs, path));
+    NL_TEST_ASSERT(apSuite, engine.mReportEncodingCache.NumEntries() == 1);
+    NL_TEST_ASSERT(apSuite, engine.RetrieveClusterDataFromCache(bobFilteredHandler, attributeReportIBs, path));
+    NL_TEST_ASSERT(apSuite, engine.mReportEncodingCache.NumEntries() == 2);
+    NL_TEST_ASSERT(apSuite, engine.RetrieveClusterDataFromCache(aliceHandler, attributeReportIBs, path));
+    NL_TEST_ASSERT(apSuite, engine.mReportEncodingCache.NumEntries() == 3);
+
+    const uint64_t generation = engine.mDirtyGeneration;
+    const ReportEncodingCache::Entry * bobEntry =
+        engine.mReportEncodingCache.Find(path, ctx.GetBobFabricIndex(), false, generation);
+    const ReportEncodingCache::Entry * aliceEntry =
+        engine.mReportEncodingCache.Find(path, ctx.GetAliceFabricIndex(), false, generation);
+    NL_TEST_ASSERT(apSuite, bobEntry != nullptr && aliceEntry != nullptr && bobEntry != aliceEntry);
+    NL_TEST_ASSERT(apSuite, engine.mReportEncodingCache.Find(path, ctx.GetBobFabricIndex(), true, generation) != nullptr);
+
+    // A subscriber denied access gets nothing from the cache, even though another fabric's encoding is there, and
+    // none is made for it.
+    Access::GetAccessControl().Finish();
+    accessControlDelegate.mDeniedFabricIndex = ctx.GetAliceFabricIndex();
+    NL_TEST_ASSERT(apSuite, Access::GetAccessControl().Init(&accessControlDelegate, deviceTypeResolver) == CHIP_NO_ERROR);
+    engine.mReportEncodingCache.Begin();
+    NL_TEST_ASSERT(apSuite, engine.RetrieveClusterDataFromCache(bobHandler, attributeReportIBs, path));
+    const uint32_t lengthWritten = writer.GetLengthWritten();
+    NL_TEST_ASSERT(apSuite, !engine.RetrieveClusterDataFromCache(aliceHandler, attributeReportIBs, path));
+    NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == lengthWritten);
+    NL_TEST_ASSERT(apSuite, engine.mReportEncodingCache.NumEntries() == 1);
+
+    // Nothing is taken from the cache outside of a run of the engine.
+    engine.mReportEncodingCache.End();
+    NL_TEST_ASSERT(apSuite, !engine.RetrieveClusterDataFromCache(bobHandler, attributeReportIBs, path));
+    NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == lengthWritten);
+
+    Access::GetAccessControl().Finish();
+    ctx.DrainAndServiceIO();
+}
+
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
 
 } // namespace reporting
 } // namespace app
@@ -335,8 +630,17 @@ namespace {
 const nlTest sTests[] =
 {
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
-    NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
+    NL_TEST_DEF("TestDirtySetSupersetLookup", chip::app::reporting::TestReportingEngine::TestDirtySetSupersetLookup),
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    NL_TEST_DEF("TestDirtySetGrowsWithHeapPools", chip::app::reporting::TestReportingEngine::TestDirtySetGrowsWithHeapPools),
+#else
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+#endif
+    NL_TEST_DEF("TestSetDirtyNotifiesInterestedReadHandlers", chip::app::reporting::TestReportingEngine::TestSetDirtyNotifiesInterestedReadHandlers),
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    NL_TEST_DEF("TestReportEncodingCache", chip::app::reporting::TestReportingEngine::TestReportEncodingCache),
+    NL_TEST_DEF("TestReportEncodingCacheAccessAndFabrics", chip::app::reporting::TestReportingEngine::TestReportEncodingCacheAccessAndFabrics),
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
     NL_TEST_SENTINEL()
 };
 // clang-format on
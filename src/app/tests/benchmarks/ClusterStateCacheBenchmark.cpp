@@ -0,0 +1,286 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Microbenchmark measuring the heap used by ClusterStateCache for wildcard reports of increasing numbers of
+ *      endpoints, and how many attribute lookups per second it serves. Compares the cache with a model of its former
+ *      layout, which kept nested maps of endpoints, clusters and attributes with a buffer allocated per attribute value.
+ *
+ *      Usage: chip-app-cluster-state-cache-benchmark [endpoint-count ...]
+ */
+
+#include <app/ClusterStateCache.h>
+
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Variant.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <chrono>
+#include <malloc.h>
+#include <map>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr ClusterId kClustersPerEndpoint    = 10;
+constexpr AttributeId kAttributesPerCluster = 16;
+constexpr size_t kUpdateReportCount         = 8;
+constexpr size_t kLookupCount               = 1000000;
+constexpr size_t kMaxEncodedAttributeSize   = 64;
+constexpr const char kStringValue[]         = "attribute value";
+
+void Check(bool ok, const char * what)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "%s failed\n", what);
+        exit(EXIT_FAILURE);
+    }
+}
+
+size_t HeapInUse()
+{
+    return mallinfo2().uordblks;
+}
+
+// Every other attribute is an integer, the others a short string, so that updates change the size of the values.
+void EncodeAttribute(const ConcreteAttributePath & path, uint32_t generation, uint8_t * buffer, size_t & size)
+{
+    TLV::TLVWriter writer;
+    writer.Init(buffer, kMaxEncodedAttributeSize);
+    if ((path.mAttributeId % 2) == 0)
+    {
+        Check(writer.Put(TLV::AnonymousTag(), generation + path.mAttributeId) == CHIP_NO_ERROR, "TLVWriter::Put");
+    }
+    else
+    {
+        Check(writer.PutString(TLV::AnonymousTag(), kStringValue, static_cast<uint32_t>(generation % sizeof(kStringValue))) ==
+                  CHIP_NO_ERROR,
+              "TLVWriter::PutString");
+    }
+    Check(writer.Finalize() == CHIP_NO_ERROR, "TLVWriter::Finalize");
+    size = writer.GetLengthWritten();
+}
+
+std::vector<ConcreteAttributePath> MakePaths(size_t endpointCount)
+{
+    std::vector<ConcreteAttributePath> paths;
+    for (size_t endpoint = 0; endpoint < endpointCount; endpoint++)
+    {
+        for (ClusterId cluster = 0; cluster < kClustersPerEndpoint; cluster++)
+        {
+            for (AttributeId attribute = 0; attribute < kAttributesPerCluster; attribute++)
+            {
+                paths.emplace_back(static_cast<EndpointId>(endpoint), cluster, attribute);
+            }
+        }
+    }
+    return paths;
+}
+
+// Model of the layout the cache had before storing the attributes of a cluster contiguously: it follows the same
+// steps to store and look up a value, and tracks changed paths the same way, so that both use the same heap outside of
+// the attribute storage.
+class MapCache
+{
+public:
+    void OnReportBegin() { mChangedAttributeSet.clear(); }
+    void OnAttributeData(const ConcreteDataAttributePath & path, TLV::TLVReader & data)
+    {
+        // Sizing pass, as the cache used to do to allocate the buffer of an attribute.
+        Platform::ScopedMemoryBufferWithSize<uint8_t> sizingBuffer;
+        TLV::TLVReader reader;
+        reader.Init(data);
+        size_t totalBufSize = reader.GetTotalLength();
+        sizingBuffer.Calloc(totalBufSize);
+        Check(sizingBuffer.Get() != nullptr, "Calloc");
+        TLV::ScopedBufferTLVWriter sizingWriter(std::move(sizingBuffer), totalBufSize);
+        Check(sizingWriter.CopyElement(TLV::AnonymousTag(), reader) == CHIP_NO_ERROR, "CopyElement");
+        size_t elementSize = sizingWriter.GetLengthWritten();
+
+        Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
+        backingBuffer.Calloc(elementSize);
+        Check(backingBuffer.Get() != nullptr, "Calloc");
+        TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
+        Check(writer.CopyElement(TLV::AnonymousTag(), data) == CHIP_NO_ERROR, "CopyElement");
+        Check(writer.Finalize(backingBuffer) == CHIP_NO_ERROR, "Finalize");
+
+        AttributeState state;
+        state.Set<AttributeData>(std::move(backingBuffer));
+        mCache[path.mEndpointId][path.mClusterId].mAttributes[path.mAttributeId] = std::move(state);
+        mChangedAttributeSet.insert(path);
+    }
+    void OnReportEnd() {}
+
+    CHIP_ERROR Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
+    {
+        auto endpointIter = mCache.find(path.mEndpointId);
+        VerifyOrReturnError(endpointIter != mCache.end(), CHIP_ERROR_KEY_NOT_FOUND);
+        auto clusterIter = endpointIter->second.find(path.mClusterId);
+        VerifyOrReturnError(clusterIter != endpointIter->second.end(), CHIP_ERROR_KEY_NOT_FOUND);
+        auto attributeIter = clusterIter->second.mAttributes.find(path.mAttributeId);
+        VerifyOrReturnError(attributeIter != clusterIter->second.mAttributes.end(), CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(attributeIter->second.Is<AttributeData>(), CHIP_ERROR_KEY_NOT_FOUND);
+
+        const auto & attributeData = attributeIter->second.Get<AttributeData>();
+        reader.Init(attributeData.Get(), attributeData.AllocatedSize());
+        return reader.Next();
+    }
+
+private:
+    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
+    using AttributeState = Variant<StatusIB, AttributeData, size_t>;
+    struct ClusterState
+    {
+        std::map<AttributeId, AttributeState> mAttributes;
+        Optional<DataVersion> mPendingDataVersion;
+        Optional<DataVersion> mCommittedDataVersion;
+    };
+    std::map<EndpointId, std::map<ClusterId, ClusterState>> mCache;
+    std::set<ConcreteAttributePath> mChangedAttributeSet;
+};
+
+class CacheAdapter
+{
+public:
+    CacheAdapter() : mCache(mCallback) {}
+
+    void OnReportBegin() { mCache.GetBufferedCallback().OnReportBegin(); }
+    void OnAttributeData(const ConcreteDataAttributePath & path, TLV::TLVReader & data)
+    {
+        mCache.GetBufferedCallback().OnAttributeData(path, &data, StatusIB());
+    }
+    void OnReportEnd() { mCache.GetBufferedCallback().OnReportEnd(); }
+    CHIP_ERROR Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const { return mCache.Get(path, reader); }
+
+private:
+    class NullCallback : public ClusterStateCache::Callback
+    {
+        void OnDone(ReadClient *) override {}
+    };
+
+    NullCallback mCallback;
+    ClusterStateCache mCache;
+};
+
+template <typename Cache>
+void Report(Cache & cache, const std::vector<ConcreteAttributePath> & paths, uint32_t generation)
+{
+    uint8_t buffer[kMaxEncodedAttributeSize];
+    cache.OnReportBegin();
+    for (auto & path : paths)
+    {
+        size_t size;
+        EncodeAttribute(path, generation, buffer, size);
+
+        TLV::TLVReader reader;
+        reader.Init(buffer, size);
+        Check(reader.Next() == CHIP_NO_ERROR, "TLVReader::Next");
+
+        ConcreteDataAttributePath dataPath(path.mEndpointId, path.mClusterId, path.mAttributeId);
+        dataPath.mDataVersion.SetValue(generation);
+        cache.OnAttributeData(dataPath, reader);
+    }
+    cache.OnReportEnd();
+}
+
+struct Result
+{
+    size_t mInitialBytes;
+    size_t mUpdatedBytes;
+    double mLookupsPerSecond;
+};
+
+template <typename Adapter>
+Result Run(const std::vector<ConcreteAttributePath> & paths)
+{
+    Result result;
+    size_t heapBefore = HeapInUse();
+    auto * cache      = new Adapter();
+
+    Report(*cache, paths, 0);
+    result.mInitialBytes = HeapInUse() - heapBefore;
+
+    for (uint32_t generation = 1; generation <= kUpdateReportCount; generation++)
+    {
+        Report(*cache, paths, generation);
+    }
+    result.mUpdatedBytes = HeapInUse() - heapBefore;
+
+    // Visit the paths with a stride coprime with their count, so that successive lookups hit different clusters.
+    size_t stride = kAttributesPerCluster + 1;
+    size_t index  = 0;
+    auto start    = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        TLV::TLVReader reader;
+        Check(cache->Get(paths[index], reader) == CHIP_NO_ERROR, "Get");
+        index = (index + stride) % paths.size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.mLookupsPerSecond              = static_cast<double>(kLookupCount) / elapsed.count();
+
+    delete cache;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 0)));
+    }
+    if (counts.empty())
+    {
+        counts = { 1, 16, 128 };
+    }
+
+    Check(Platform::MemoryInit() == CHIP_NO_ERROR, "MemoryInit");
+    Logging::SetLogFilter(Logging::kLogCategory_Error);
+
+    printf("%9s  %10s  %12s  %12s  %12s  %12s  %12s  %12s\n", "endpoints", "attributes", "map bytes", "flat bytes",
+           "map updated", "flat updated", "map gets/s", "flat gets/s");
+    for (size_t count : counts)
+    {
+        if (count == 0 || count > kInvalidEndpointId)
+        {
+            fprintf(stderr, "endpoint count must be between 1 and %u\n", kInvalidEndpointId);
+            return EXIT_FAILURE;
+        }
+
+        std::vector<ConcreteAttributePath> paths = MakePaths(count);
+        Result map                               = Run<MapCache>(paths);
+        Result flat                              = Run<CacheAdapter>(paths);
+        printf("%9zu  %10zu  %12zu  %12zu  %12zu  %12zu  %12.0f  %12.0f\n", count, paths.size(), map.mInitialBytes,
+               flat.mInitialBytes, map.mUpdatedBytes, flat.mUpdatedBytes, map.mLookupsPerSecond, flat.mLookupsPerSecond);
+    }
+
+    Platform::MemoryShutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Microbenchmark simulating a minute of subscriptions with random intervals that become dirty at random, running the
+ *      engine on every 10ms tick, and measuring the time spent in TimerQueueReportSchedulerImpl and
+ *      SynchronizedReportSchedulerImpl per simulated second. The synchronized scheduler goes through all handlers on each
+ *      event, so it is only run on a fraction of the subscriptions.
+ *
+ *      Usage: chip-app-report-scheduler-benchmark [subscription-count ...]
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/reporting/SynchronizedReportSchedulerImpl.h>
+#include <app/reporting/TimerQueueReportSchedulerImpl.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace chip {
+namespace app {
+namespace reporting {
+namespace {
+
+using Milliseconds64 = System::Clock::Milliseconds64;
+using SteadyClock    = std::chrono::steady_clock;
+
+constexpr uint32_t kSimulatedSeconds                 = 60;
+constexpr uint32_t kTickMs                           = 10;
+constexpr uint32_t kDirtyPerSecond                   = 500;
+constexpr size_t kMaxSynchronizedSubscriptions       = 200;
+constexpr System::Clock::Timestamp kNoTimerTimestamp = Milliseconds64(UINT64_MAX);
+
+void Check(bool ok, const char * what)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "%s failed\n", what);
+        exit(EXIT_FAILURE);
+    }
+}
+
+class NullReadHandlerCallback : public ReadHandler::ManagementCallback
+{
+public:
+    void OnDone(ReadHandler & apReadHandlerObj) override {}
+    ReadHandler::ApplicationCallback * GetAppCallback() override { return nullptr; }
+};
+
+/// Mock of a single timer whose time only advances when the simulation increments it.
+class MockTimerDelegate : public ReportScheduler::TimerDelegate
+{
+public:
+    CHIP_ERROR StartTimer(TimerContext * context, System::Clock::Timeout aTimeout) override
+    {
+        VerifyOrReturnError(context != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        mTimerContext = context;
+        mTimerTimeout = mNow + aTimeout;
+        return CHIP_NO_ERROR;
+    }
+    void CancelTimer(TimerContext * context) override
+    {
+        mTimerContext = nullptr;
+        mTimerTimeout = kNoTimerTimestamp;
+    }
+    bool IsTimerActive(TimerContext * context) override { return mTimerContext != nullptr && mTimerTimeout > mNow; }
+    System::Clock::Timestamp GetCurrentMonotonicTimestamp() override { return mNow; }
+
+    void Reset()
+    {
+        mTimerContext = nullptr;
+        mTimerTimeout = kNoTimerTimestamp;
+        mNow          = Milliseconds64(0);
+    }
+
+    // Increment the time one millisecond at a time, firing the timer when it expires.
+    void Increment(Milliseconds64 aTime)
+    {
+        for (Milliseconds64 i = Milliseconds64(0); i < aTime; i++)
+        {
+            mNow++;
+            if (mTimerContext != nullptr && mNow == mTimerTimeout)
+            {
+                mTimerContext->TimerFired();
+            }
+        }
+    }
+
+private:
+    TimerContext * mTimerContext           = nullptr;
+    System::Clock::Timestamp mTimerTimeout = kNoTimerTimestamp;
+    System::Clock::Timestamp mNow          = Milliseconds64(0);
+};
+
+struct Result
+{
+    uint32_t mReports;
+    uint32_t mDirtyEvents;
+    double mMicrosecondsPerSecond;
+};
+
+} // namespace
+
+class ReportSchedulerBenchmark
+{
+public:
+    template <typename Scheduler>
+    static Result Run(Test::AppContext & ctx, MockTimerDelegate & timerDelegate, size_t numSubscriptions)
+    {
+        Scheduler scheduler(&timerDelegate);
+        NullReadHandlerCallback nullCallback;
+        Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+        std::vector<std::unique_ptr<ReadHandler>> readHandlers;
+        std::vector<ReportScheduler::ReadHandlerNode *> nodes;
+        std::mt19937 random(0x5eed);
+        std::uniform_int_distribution<uint16_t> minInterval(0, 5);
+        std::uniform_int_distribution<uint16_t> maxInterval(10, 60);
+        std::uniform_int_distribution<size_t> handlerIndex(0, numSubscriptions - 1);
+        std::uniform_int_distribution<uint32_t> dirtyCount(0, 2 * kDirtyPerSecond * kTickMs / 1000);
+
+        timerDelegate.Reset();
+        for (size_t i = 0; i < numSubscriptions; i++)
+        {
+            readHandlers.push_back(
+                std::make_unique<ReadHandler>(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &scheduler));
+            ReadHandler * readHandler = readHandlers.back().get();
+            Check(readHandler->SetMaxReportingInterval(maxInterval(random)) == CHIP_NO_ERROR, "SetMaxReportingInterval");
+            Check(readHandler->SetMinReportingIntervalForTests(minInterval(random)) == CHIP_NO_ERROR,
+                  "SetMinReportingIntervalForTests");
+            readHandler->ClearStateFlag(ReadHandler::ReadHandlerFlags::PrimingReports);
+            readHandler->SetStateFlag(ReadHandler::ReadHandlerFlags::ActiveSubscription);
+            scheduler.OnSubscriptionEstablished(readHandler);
+            readHandler->MoveToState(ReadHandler::HandlerState::CanStartReporting);
+            nodes.push_back(scheduler.GetReadHandlerNode(readHandler));
+            Check(nodes.back() != nullptr, "OnSubscriptionEstablished");
+        }
+
+        Result result                       = {};
+        SteadyClock::duration schedulerTime = SteadyClock::duration::zero();
+        auto timed                          = [&schedulerTime](auto && action) {
+            SteadyClock::time_point start = SteadyClock::now();
+            action();
+            schedulerTime += SteadyClock::now() - start;
+        };
+
+        for (uint32_t tick = 0; tick < kSimulatedSeconds * 1000 / kTickMs; tick++)
+        {
+            // Attributes change
+            for (uint32_t i = dirtyCount(random); i > 0; i--)
+            {
+                ReadHandler * readHandler = readHandlers[handlerIndex(random)].get();
+                timed([&] { readHandler->ForceDirtyState(); });
+                result.mDirtyEvents++;
+            }
+
+            // Time passes, firing the timer if it expires
+            timed([&] { timerDelegate.Increment(Milliseconds64(kTickMs)); });
+
+            // The engine runs, sending the reports of the handlers that are reportable
+            System::Clock::Timestamp now = timerDelegate.GetCurrentMonotonicTimestamp();
+            for (size_t i = 0; i < numSubscriptions; i++)
+            {
+                if (!nodes[i]->IsReportableNow(now))
+                {
+                    continue;
+                }
+
+                ReadHandler * readHandler = readHandlers[i].get();
+                readHandler->ClearForceDirtyFlag();
+                timed([&] { scheduler.OnSubscriptionReportSent(readHandler); });
+                result.mReports++;
+            }
+        }
+
+        result.mMicrosecondsPerSecond =
+            std::chrono::duration<double, std::micro>(schedulerTime).count() / static_cast<double>(kSimulatedSeconds);
+
+        readHandlers.clear();
+        exchangeCtx->Close();
+        return result;
+    }
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+using namespace chip;
+using namespace chip::app::reporting;
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 0)));
+    }
+    if (counts.empty())
+    {
+        counts = { 500, 5000 };
+    }
+
+    Test::AppContext ctx;
+    Check(ctx.SetUpTestSuite() == CHIP_NO_ERROR, "SetUpTestSuite");
+    Check(ctx.SetUp() == CHIP_NO_ERROR, "SetUp");
+    Logging::SetLogFilter(Logging::kLogCategory_Error);
+
+    MockTimerDelegate timerDelegate;
+
+    printf("%-32s  %13s  %8s  %12s  %16s\n", "scheduler", "subscriptions", "reports", "dirty events", "us per second");
+    for (size_t count : counts)
+    {
+        if (count == 0)
+        {
+            fprintf(stderr, "subscription count must be at least 1\n");
+            return EXIT_FAILURE;
+        }
+
+        Result queue = ReportSchedulerBenchmark::Run<TimerQueueReportSchedulerImpl>(ctx, timerDelegate, count);
+        printf("%-32s  %13zu  %8u  %12u  %16.1f\n", "TimerQueueReportSchedulerImpl", count, queue.mReports, queue.mDirtyEvents,
+               queue.mMicrosecondsPerSecond);
+
+        size_t synchronizedCount = std::min(count, kMaxSynchronizedSubscriptions);
+        Result synchronized = ReportSchedulerBenchmark::Run<SynchronizedReportSchedulerImpl>(ctx, timerDelegate, synchronizedCount);
+        printf("%-32s  %13zu  %8u  %12u  %16.1f\n", "SynchronizedReportSchedulerImpl", synchronizedCount, synchronized.mReports,
+               synchronized.mDirtyEvents, synchronized.mMicrosecondsPerSecond);
+    }
+
+    ctx.TearDown();
+    ctx.TearDownTestSuite();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,251 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Tests for the lookup of endpoint indices by endpoint id in attribute-storage, as dynamic endpoints with
+ *      ids in no particular order are set and cleared.
+ */
+
+#include "app-common/zap-generated/ids/Attributes.h"
+#include "app-common/zap-generated/ids/Clusters.h"
+#include <app/tests/AppTestContext.h>
+#include <app/util/DataModelHandler.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <string.h>
+
+using TestContext = chip::Test::AppContext;
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+namespace {
+
+constexpr AttributeId kTestAttribute = UnitTesting::Attributes::Int32u::Id;
+
+// Endpoint 1 is the one fixed endpoint of the controller app, so these are all free. They are assigned out of
+// order on purpose.
+constexpr EndpointId kEndpointA       = 9;
+constexpr EndpointId kEndpointB       = 4;
+constexpr EndpointId kEndpointC       = 7;
+constexpr EndpointId kEndpointD       = 3;
+constexpr EndpointId kUnusedEndpoint  = 5;
+constexpr EndpointId kMaxTestEndpoint = 9;
+
+// Two endpoint types listing the same clusters in opposite orders, so that the cluster index tells which
+// endpoint type, and thus which endpoint, a lookup resolved to.
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(testClusterAttrsOnTypeA)
+DECLARE_DYNAMIC_ATTRIBUTE(kTestAttribute, INT32U, 4, ATTRIBUTE_MASK_WRITABLE), DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(testClusterAttrsOnTypeB)
+DECLARE_DYNAMIC_ATTRIBUTE(kTestAttribute, INT32U, 4, ATTRIBUTE_MASK_WRITABLE), DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(descriptorAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(testEndpointClustersA)
+DECLARE_DYNAMIC_CLUSTER(UnitTesting::Id, testClusterAttrsOnTypeA, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(testEndpointTypeA, testEndpointClustersA);
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(testEndpointClustersB)
+DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(UnitTesting::Id, testClusterAttrsOnTypeB, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(testEndpointTypeB, testEndpointClustersB);
+
+// External storage of kTestAttribute, by endpoint id, and the metadata of the last access.
+uint32_t gAttributeValues[kMaxTestEndpoint + 1];
+const EmberAfAttributeMetadata * gLastMetadata = nullptr;
+
+class TestEndpointIndex
+{
+public:
+    static void TestSetAndClearDynamicEndpoints(nlTestSuite * apSuite, void * apContext);
+};
+
+// Checks that endpoint is found at the given dynamic index, with the layout of the given endpoint type, and that
+// its attribute is read and written through that index.
+void CheckDynamicEndpoint(nlTestSuite * apSuite, EndpointId endpoint, uint16_t dynamicIndex, const EmberAfEndpointType * type)
+{
+    const bool isTypeA = (type == &testEndpointTypeA);
+
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(endpoint) == emberAfFixedEndpointCount() + dynamicIndex);
+    NL_TEST_ASSERT(apSuite,
+                   emberAfIndexFromEndpointIncludingDisabledEndpoints(endpoint) == emberAfFixedEndpointCount() + dynamicIndex);
+    NL_TEST_ASSERT(apSuite, emberAfClusterIndex(endpoint, UnitTesting::Id, CLUSTER_MASK_SERVER) == (isTypeA ? 0 : 1));
+    NL_TEST_ASSERT(apSuite, emberAfClusterIndex(endpoint, Descriptor::Id, CLUSTER_MASK_SERVER) == (isTypeA ? 1 : 0));
+
+    uint32_t value = 0x10000u + endpoint;
+    NL_TEST_ASSERT(apSuite,
+                   emberAfWriteAttribute(endpoint, UnitTesting::Id, kTestAttribute, reinterpret_cast<uint8_t *>(&value),
+                                         ZCL_INT32U_ATTRIBUTE_TYPE) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(apSuite, gAttributeValues[endpoint] == value);
+
+    value         = 0;
+    gLastMetadata = nullptr;
+    NL_TEST_ASSERT(apSuite,
+                   emberAfReadAttribute(endpoint, UnitTesting::Id, kTestAttribute, reinterpret_cast<uint8_t *>(&value),
+                                        sizeof(value)) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(apSuite, value == 0x10000u + endpoint);
+    NL_TEST_ASSERT(apSuite, gLastMetadata == (isTypeA ? &testClusterAttrsOnTypeA[0] : &testClusterAttrsOnTypeB[0]));
+}
+
+void CheckMissingEndpoint(nlTestSuite * apSuite, EndpointId endpoint)
+{
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(endpoint) == kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpointIncludingDisabledEndpoints(endpoint) == kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfClusterIndex(endpoint, UnitTesting::Id, CLUSTER_MASK_SERVER) == 0xFF);
+
+    uint32_t value = 0;
+    NL_TEST_ASSERT(apSuite,
+                   emberAfReadAttribute(endpoint, UnitTesting::Id, kTestAttribute, reinterpret_cast<uint8_t *>(&value),
+                                        sizeof(value)) == EMBER_ZCL_STATUS_UNSUPPORTED_ENDPOINT);
+}
+
+// Checks that every defined endpoint, fixed ones included, is found at its own index.
+void CheckAllEndpoints(nlTestSuite * apSuite)
+{
+    for (uint16_t index = 0; index < emberAfEndpointCount(); index++)
+    {
+        EndpointId endpoint = emberAfEndpointFromIndex(index);
+        if (endpoint != kInvalidEndpointId)
+        {
+            NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(endpoint) == index);
+        }
+    }
+}
+
+void TestEndpointIndex::TestSetAndClearDynamicEndpoints(nlTestSuite * apSuite, void * apContext)
+{
+    // Initialize the ember side server logic
+    InitDataModelHandler();
+
+    DataVersion dataVersionStorageA[ArraySize(testEndpointClustersA)];
+    DataVersion dataVersionStorageB[ArraySize(testEndpointClustersB)];
+    DataVersion dataVersionStorageC[ArraySize(testEndpointClustersA)];
+    DataVersion dataVersionStorageD[ArraySize(testEndpointClustersB)];
+    memset(gAttributeValues, 0, sizeof(gAttributeValues));
+
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(0, kEndpointA, &testEndpointTypeA, Span<DataVersion>(dataVersionStorageA)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(1, kEndpointB, &testEndpointTypeB, Span<DataVersion>(dataVersionStorageB)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(2, kEndpointC, &testEndpointTypeA, Span<DataVersion>(dataVersionStorageC)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+
+    CheckDynamicEndpoint(apSuite, kEndpointA, 0, &testEndpointTypeA);
+    CheckDynamicEndpoint(apSuite, kEndpointB, 1, &testEndpointTypeB);
+    CheckDynamicEndpoint(apSuite, kEndpointC, 2, &testEndpointTypeA);
+    CheckMissingEndpoint(apSuite, kEndpointD);
+    CheckMissingEndpoint(apSuite, kUnusedEndpoint);
+    CheckAllEndpoints(apSuite);
+
+    // An id that is already in use is rejected and leaves the index alone.
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(3, kEndpointB, &testEndpointTypeA, Span<DataVersion>(dataVersionStorageD)) ==
+                       EMBER_ZCL_STATUS_DUPLICATE_EXISTS);
+    CheckDynamicEndpoint(apSuite, kEndpointB, 1, &testEndpointTypeB);
+
+    // Clearing the endpoint in the middle of the id range removes it only.
+    NL_TEST_ASSERT(apSuite, emberAfClearDynamicEndpoint(1) == kEndpointB);
+    CheckMissingEndpoint(apSuite, kEndpointB);
+    CheckDynamicEndpoint(apSuite, kEndpointA, 0, &testEndpointTypeA);
+    CheckDynamicEndpoint(apSuite, kEndpointC, 2, &testEndpointTypeA);
+    CheckAllEndpoints(apSuite);
+
+    // Reusing the cleared slot for an id lower than all the others.
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(1, kEndpointD, &testEndpointTypeB, Span<DataVersion>(dataVersionStorageD)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    CheckDynamicEndpoint(apSuite, kEndpointD, 1, &testEndpointTypeB);
+    CheckDynamicEndpoint(apSuite, kEndpointA, 0, &testEndpointTypeA);
+    CheckDynamicEndpoint(apSuite, kEndpointC, 2, &testEndpointTypeA);
+    CheckMissingEndpoint(apSuite, kEndpointB);
+    CheckAllEndpoints(apSuite);
+
+    // A disabled endpoint is only found when disabled endpoints are included.
+    NL_TEST_ASSERT(apSuite, emberAfEndpointEnableDisable(kEndpointC, false));
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(kEndpointC) == kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpointIncludingDisabledEndpoints(kEndpointC) == emberAfFixedEndpointCount() + 2);
+    NL_TEST_ASSERT(apSuite, emberAfEndpointEnableDisable(kEndpointC, true));
+    CheckDynamicEndpoint(apSuite, kEndpointC, 2, &testEndpointTypeA);
+
+    NL_TEST_ASSERT(apSuite, emberAfClearDynamicEndpoint(2) == kEndpointC);
+    NL_TEST_ASSERT(apSuite, emberAfClearDynamicEndpoint(1) == kEndpointD);
+    NL_TEST_ASSERT(apSuite, emberAfClearDynamicEndpoint(0) == kEndpointA);
+    CheckMissingEndpoint(apSuite, kEndpointA);
+    CheckMissingEndpoint(apSuite, kEndpointC);
+    CheckMissingEndpoint(apSuite, kEndpointD);
+    CheckAllEndpoints(apSuite);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestSetAndClearDynamicEndpoints", TestEndpointIndex::TestSetAndClearDynamicEndpoints),
+    NL_TEST_SENTINEL(),
+};
+
+nlTestSuite sSuite = {
+    "TestEndpointIndex",
+    &sTests[0],
+    TestContext::nlTestSetUpTestSuite,
+    TestContext::nlTestTearDownTestSuite,
+    TestContext::nlTestSetUp,
+    TestContext::nlTestTearDown,
+};
+
+} // namespace
+
+EmberAfStatus emberAfExternalAttributeReadCallback(EndpointId endpoint, ClusterId clusterId,
+                                                   const EmberAfAttributeMetadata * attributeMetadata, uint8_t * buffer,
+                                                   uint16_t maxReadLength)
+{
+    VerifyOrReturnError(endpoint <= kMaxTestEndpoint && clusterId == UnitTesting::Id, EMBER_ZCL_STATUS_FAILURE);
+    VerifyOrReturnError(maxReadLength >= sizeof(uint32_t), EMBER_ZCL_STATUS_RESOURCE_EXHAUSTED);
+    gLastMetadata = attributeMetadata;
+    memcpy(buffer, &gAttributeValues[endpoint], sizeof(uint32_t));
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+EmberAfStatus emberAfExternalAttributeWriteCallback(EndpointId endpoint, ClusterId clusterId,
+                                                    const EmberAfAttributeMetadata * attributeMetadata, uint8_t * buffer)
+{
+    VerifyOrReturnError(endpoint <= kMaxTestEndpoint && clusterId == UnitTesting::Id, EMBER_ZCL_STATUS_FAILURE);
+    gLastMetadata = attributeMetadata;
+    memcpy(&gAttributeValues[endpoint], buffer, sizeof(uint32_t));
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+int TestEndpointIndexTests()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestEndpointIndexTests)
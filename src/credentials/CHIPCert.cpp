@@ -33,6 +33,7 @@
 
 #include <credentials/CHIPCert_Internal.h>
 #include <credentials/CHIPCertificateSet.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <lib/asn1/ASN1.h>
 #include <lib/asn1/ASN1Macros.h>
 #include <lib/core/CHIPCore.h>
@@ -415,9 +416,23 @@ CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, Va
 
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
     // succeeds, the current certificate is valid.
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+    if (context.mVerifiedCertCache != nullptr && context.mVerifiedCertCache->Contains(*cert, *caCert))
+    {
+        ExitNow(err = CHIP_NO_ERROR);
+    }
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+
     err = VerifyCertSignature(*cert, *caCert);
     SuccessOrExit(err);
 
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+    if (context.mVerifiedCertCache != nullptr)
+    {
+        context.mVerifiedCertCache->Add(*cert, *caCert);
+    }
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+
 exit:
     return err;
 }
@@ -503,9 +518,10 @@ bool ChipCertificateData::IsEqual(const ChipCertificateData & other) const
 
 void ValidationContext::Reset()
 {
-    mEffectiveTime  = EffectiveTime{};
-    mTrustAnchor    = nullptr;
-    mValidityPolicy = nullptr;
+    mEffectiveTime     = EffectiveTime{};
+    mTrustAnchor       = nullptr;
+    mValidityPolicy    = nullptr;
+    mVerifiedCertCache = nullptr;
     mRequiredKeyUsages.ClearAll();
     mRequiredKeyPurposes.ClearAll();
     mRequiredCertType = CertType::kNotSpecified;
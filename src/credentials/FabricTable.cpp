@@ -745,8 +745,17 @@ public:
     System::Clock::Seconds32 mLatestNotBefore;
 };
 
+void FabricTable::InvalidateVerifiedCertificateCache()
+{
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+    mVerifiedCertCache.Clear();
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+}
+
 CHIP_ERROR FabricTable::NotifyFabricUpdated(FabricIndex fabricIndex)
 {
+    InvalidateVerifiedCertificateCache();
+
     FabricTable::Delegate * delegate = mDelegateListRoot;
     while (delegate)
     {
@@ -761,6 +770,8 @@ CHIP_ERROR FabricTable::NotifyFabricUpdated(FabricIndex fabricIndex)
 
 CHIP_ERROR FabricTable::NotifyFabricCommitted(FabricIndex fabricIndex)
 {
+    InvalidateVerifiedCertificateCache();
+
     FabricTable::Delegate * delegate = mDelegateListRoot;
     while (delegate)
     {
@@ -1005,6 +1016,8 @@ CHIP_ERROR FabricTable::Delete(FabricIndex fabricIndex)
         ChipLogProgress(FabricProvisioning, "Fabric (0x%x) deleted.", static_cast<unsigned>(fabricIndex));
     }
 
+    InvalidateVerifiedCertificateCache();
+
     if (mDelegateListRoot != nullptr)
     {
         FabricTable::Delegate * delegate = mDelegateListRoot;
@@ -1875,6 +1888,11 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
     }
 
     // ==== Start of actual commit transaction after pre-flight checks ====
+
+    // Storage that supports batches writes the whole transaction at once, so it is either fully there or
+    // not at all after a reboot. Elsewhere, the commit marker allows cleaning up after an interrupted commit.
+    PersistentStorageBatch storageBatch(*mStorage);
+
     CHIP_ERROR stickyError  = StoreCommitMarker(CommitMarker{ fabricIndexBeingCommitted, isAdding });
     bool failedCommitMarker = (stickyError != CHIP_NO_ERROR);
     if (failedCommitMarker)
@@ -1940,6 +1958,9 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
                 mFabricIndexWithPendingState = kUndefinedFabricIndex;
                 mPendingFabric.Reset();
 
+                // Leave the partial transaction in storage, as a reboot at this point would have.
+                storageBatch.Commit();
+
                 ChipLogError(FabricProvisioning, "Aborting commit in middle of transaction for testing.");
                 return CHIP_ERROR_INTERNAL;
             }
@@ -1989,26 +2010,45 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
 
     if (stickyError != CHIP_NO_ERROR)
     {
+        // Drop what the transaction wrote before cleaning up, so that the clean-up reaches storage on its
+        // own: a failed nested batch (e.g. when committing op certs) makes the whole batch fail to commit.
+        storageBatch.Abort();
+
         // Blow-away everything if we got past any storage, even on Update: system state is broken
         // TODO: Develop a way to properly revert in the future, but this is very difficult
         Delete(fabricIndexBeingCommitted);
 
         RevertPendingFabricData();
     }
-    else
-    {
-        NotifyFabricCommitted(fabricIndexBeingCommitted);
-    }
 
     // Clear commit marker no matter what: if we got here, there was no reboot and previous clean-ups
     // did their job.
     ClearCommitMarker();
 
+    // Nothing left to commit if the batch was aborted above.
+    CHIP_ERROR batchErr = storageBatch.Commit();
+    if (batchErr != CHIP_NO_ERROR)
+    {
+        ChipLogError(FabricProvisioning, "Failed to write committed fabric data: %" CHIP_ERROR_FORMAT, batchErr.Format());
+        stickyError = batchErr;
+
+        // Nothing of the transaction reached storage, clean up as any other failure does, now outside of the batch.
+        Delete(fabricIndexBeingCommitted);
+        RevertPendingFabricData();
+    }
+
+    if (stickyError == CHIP_NO_ERROR)
+    {
+        NotifyFabricCommitted(fabricIndexBeingCommitted);
+    }
+
     return stickyError;
 }
 
 void FabricTable::RevertPendingFabricData()
 {
+    InvalidateVerifiedCertificateCache();
+
     // Will clear pending UpdateNoc/AddNOC
     RevertPendingOpCertsExceptRoot();
 
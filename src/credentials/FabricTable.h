@@ -29,6 +29,7 @@
 #include <credentials/CertificateValidityPolicy.h>
 #include <credentials/LastKnownGoodTime.h>
 #include <credentials/OperationalCertificateStore.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <crypto/OperationalKeystore.h>
 #include <lib/core/CHIPEncoding.h>
@@ -955,6 +956,24 @@ public:
                                         Credentials::ValidationContext & context, CompressedFabricId & outCompressedFabricId,
                                         FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
                                         Crypto::P256PublicKey * outRootPublicKey = nullptr);
+
+    /**
+     * @brief Get the cache of certificate signatures verified for peers of the fabrics in this table, to be set as
+     *        the mVerifiedCertCache of the ValidationContext used to verify peer credentials.
+     *
+     * The cache is cleared whenever a fabric is added, updated or removed.
+     *
+     * @return the cache, or nullptr if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE is 0
+     */
+    Credentials::VerifiedCertificateCache * GetVerifiedCertificateCache() const
+    {
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+        return &mVerifiedCertCache;
+#else
+        return nullptr;
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+    }
+
     /**
      * @brief Enables FabricInfo instances to collide and reference the same logical fabric (i.e Root Public Key + FabricId).
      *
@@ -1156,6 +1175,7 @@ private:
 
     CHIP_ERROR NotifyFabricUpdated(FabricIndex fabricIndex);
     CHIP_ERROR NotifyFabricCommitted(FabricIndex fabricIndex);
+    void InvalidateVerifiedCertificateCache();
 
     // Commit management clean-up APIs
     CHIP_ERROR StoreCommitMarker(const CommitMarker & commitMarker);
@@ -1181,6 +1201,11 @@ private:
 
     LastKnownGoodTime mLastKnownGoodTime;
 
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+    // Mutable since verifying credentials, which fills it, does not otherwise modify the table.
+    mutable Credentials::VerifiedCertificateCache mVerifiedCertCache;
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+
     // We may not have an mNextAvailableFabricIndex if our table is as large as
     // it can go and is full.
     Optional<FabricIndex> mNextAvailableFabricIndex;
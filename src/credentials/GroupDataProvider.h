@@ -316,7 +316,23 @@ public:
     void SetListener(GroupListener * listener) { mListener = listener; };
     void RemoveListener() { mListener = nullptr; };
 
+    /**
+     *  Returns whether GetKeySetGeneration() changes whenever key sets are written or removed. Implementations
+     *  that call KeySetsChanged() on every such change override this to return true. Otherwise, users keeping
+     *  copies of key material obtained from this provider must read it again each time they need it.
+     */
+    virtual bool SupportsKeySetGeneration() const { return false; }
+
+    /**
+     *  Returns a counter that changes whenever key sets are written or removed, so that users keeping copies of
+     *  key material obtained from this provider (e.g. IPKs) know when to read it again. Only meaningful if
+     *  SupportsKeySetGeneration() returns true.
+     */
+    uint32_t GetKeySetGeneration() const { return mKeySetGeneration; }
+
 protected:
+    void KeySetsChanged() { mKeySetGeneration++; }
+
     void GroupAdded(FabricIndex fabric_index, const GroupInfo & new_group)
     {
         if (mListener)
@@ -333,7 +349,8 @@ protected:
     }
     const uint16_t mMaxGroupsPerFabric;
     const uint16_t mMaxGroupKeysPerFabric;
-    GroupListener * mListener = nullptr;
+    GroupListener * mListener  = nullptr;
+    uint32_t mKeySetGeneration = 0;
 };
 
 /**
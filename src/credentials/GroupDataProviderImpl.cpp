@@ -832,12 +832,18 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mGroupSessionIndex), sizeof(mGroupSessionIndex));
+    mGroupSessionIndexCount = 0;
+#endif
+    InvalidateGroupSessionIndex();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
     mStorage = storage;
+    InvalidateGroupSessionIndex();
 }
 
 //
@@ -1349,6 +1355,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1422,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1455,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1532,8 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
+    KeySetsChanged();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1559,13 +1570,17 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
     // New keyset
     VerifyOrReturnError(fabric.keyset_count < mMaxGroupKeysPerFabric, CHIP_ERROR_INVALID_LIST_LENGTH);
 
+    // The new keyset and the fabric data linking it are written together
+    PersistentStorageBatch storageBatch(*mStorage);
+
     // Insert first
     keyset.next = fabric.first_keyset;
     ReturnErrorOnFailure(keyset.Save(mStorage));
     // Update fabric
     fabric.keyset_count++;
     fabric.first_keyset = in_keyset.keyset_id;
-    return fabric.Save(mStorage);
+    ReturnErrorOnFailure(fabric.Save(mStorage));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint16_t target_id, KeySet & out_keyset)
@@ -1594,12 +1609,17 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
+    KeySetsChanged();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
 
     ReturnErrorOnFailure(fabric.Load(mStorage));
     VerifyOrReturnError(keyset.Find(mStorage, fabric, target_id), CHIP_ERROR_NOT_FOUND);
+
+    // Unlinking the keyset and removing its group mappings are written together
+    PersistentStorageBatch storageBatch(*mStorage);
     ReturnErrorOnFailure(keyset.Delete(mStorage));
 
     if (keyset.first)
@@ -1638,7 +1658,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, u
         // open to suggestsions for the correct behavior.
         RemoveGroupKeyAt(fabric_index, idx);
     }
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 GroupDataProvider::KeySetIterator * GroupDataProviderImpl::IterateKeySets(chip::FabricIndex fabric_index)
@@ -1695,6 +1715,9 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionIndex();
+    KeySetsChanged();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1839,12 +1862,115 @@ CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::PrivacyDecrypt(const ByteSpan
 GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGroupSessions(uint16_t session_id)
 {
     VerifyOrReturnError(IsInitialized(), nullptr);
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    // Live iterators may refer to the index, so it is only reloaded once they are all released.
+    if (mGroupSessionIndexState == IndexState::kStale && mGroupSessionsIterator.Allocated() == 0)
+    {
+        mGroupSessionIndexState = (CHIP_NO_ERROR == LoadGroupSessionIndex()) ? IndexState::kLoaded : IndexState::kFailed;
+    }
+#endif
     return mGroupSessionsIterator.CreateObject(*this, session_id);
 }
 
+void GroupDataProviderImpl::InvalidateGroupSessionIndex()
+{
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    mGroupSessionIndexState = IndexState::kStale;
+#endif
+}
+
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+CHIP_ERROR GroupDataProviderImpl::LoadGroupSessionIndex()
+{
+    Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mGroupSessionIndex), sizeof(mGroupSessionIndex));
+    mGroupSessionIndexCount = 0;
+
+    FabricList fabric_list;
+    CHIP_ERROR err = fabric_list.Load(mStorage);
+    if (CHIP_ERROR_NOT_FOUND == err)
+    {
+        return CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        ReturnErrorOnFailure(fabric.Load(mStorage));
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            ReturnErrorOnFailure(mapping.Load(mStorage));
+
+            KeySetData keyset;
+            VerifyOrReturnError(keyset.Find(mStorage, fabric, mapping.keyset_id), CHIP_ERROR_KEY_NOT_FOUND);
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                ReturnErrorOnFailure(
+                    AddToGroupSessionIndex(fabric.fabric_index, mapping.group_id, keyset.policy, keyset.operational_keys[k]));
+            }
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR GroupDataProviderImpl::AddToGroupSessionIndex(FabricIndex fabric_index, GroupId group_id, SecurityPolicy policy,
+                                                         const Crypto::GroupOperationalCredentials & creds)
+{
+    VerifyOrReturnError(mGroupSessionIndexCount < ArraySize(mGroupSessionIndex), CHIP_ERROR_NO_MEMORY);
+
+    // Insert after the entries with the same session id, so that candidates are still tried in storage order.
+    size_t pos = mGroupSessionIndexCount;
+    while (pos > 0 && mGroupSessionIndex[pos - 1].session_id > creds.hash)
+    {
+        mGroupSessionIndex[pos] = mGroupSessionIndex[pos - 1];
+        pos--;
+    }
+
+    GroupSessionEntry & entry = mGroupSessionIndex[pos];
+    entry.session_id          = creds.hash;
+    entry.fabric_index        = fabric_index;
+    entry.group_id            = group_id;
+    entry.security_policy     = policy;
+    memcpy(entry.encryption_key, creds.encryption_key, sizeof(entry.encryption_key));
+    memcpy(entry.privacy_key, creds.privacy_key, sizeof(entry.privacy_key));
+    mGroupSessionIndexCount++;
+    return CHIP_NO_ERROR;
+}
+#endif // CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    if (provider.mGroupSessionIndexState == IndexState::kLoaded)
+    {
+        const GroupSessionEntry * index = provider.mGroupSessionIndex;
+        size_t begin                    = 0;
+        size_t end                      = provider.mGroupSessionIndexCount;
+        while (begin < end)
+        {
+            size_t middle = begin + (end - begin) / 2;
+            if (index[middle].session_id < session_id)
+            {
+                begin = middle + 1;
+            }
+            else
+            {
+                end = middle;
+            }
+        }
+        for (end = begin; end < provider.mGroupSessionIndexCount && index[end].session_id == session_id; end++)
+        {
+        }
+        mIndexed  = true;
+        mIndexPos = begin;
+        mIndexEnd = end;
+        return;
+    }
+#endif
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1857,6 +1983,11 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
+    if (mIndexed)
+    {
+        return mIndexEnd - mIndexPos;
+    }
+
     FabricData fabric(mFirstFabric);
     size_t count = 0;
 
@@ -1898,6 +2029,20 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    if (mIndexed)
+    {
+        VerifyOrReturnError(mIndexPos < mIndexEnd, false);
+        const GroupSessionEntry & entry = mProvider.mGroupSessionIndex[mIndexPos++];
+        mGroupKeyContext.Initialize(entry.encryption_key, mSessionId, entry.privacy_key);
+        output.fabric_index    = entry.fabric_index;
+        output.group_id        = entry.group_id;
+        output.security_policy = entry.security_policy;
+        output.keyContext      = &mGroupKeyContext;
+        return true;
+    }
+#endif
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
@@ -89,6 +89,7 @@ public:
     CHIP_ERROR RemoveKeySet(FabricIndex fabric_index, chip::KeysetId keyset_id) override;
     CHIP_ERROR GetIpkKeySet(FabricIndex fabric_index, KeySet & out_keyset) override;
     KeySetIterator * IterateKeySets(FabricIndex fabric_index) override;
+    bool SupportsKeySetGeneration() const override { return true; }
 
     // Fabrics
     CHIP_ERROR RemoveFabric(FabricIndex fabric_index) override;
@@ -232,6 +233,9 @@ protected:
     protected:
         GroupDataProviderImpl & mProvider;
         uint16_t mSessionId      = 0;
+        bool mIndexed            = false; // Iterate mProvider.mGroupSessionIndex instead of the persistent storage
+        size_t mIndexPos         = 0;
+        size_t mIndexEnd         = 0;
         FabricIndex mFirstFabric = kUndefinedFabricIndex;
         FabricIndex mFabric      = kUndefinedFabricIndex;
         uint16_t mFabricCount    = 0;
@@ -243,9 +247,34 @@ protected:
         bool mFirstMap           = true;
         GroupKeyContext mGroupKeyContext;
     };
+    // Operational key of a keyset mapped to a group, as found by IterateGroupSessions()
+    struct GroupSessionEntry
+    {
+        uint16_t session_id;
+        FabricIndex fabric_index;
+        GroupId group_id;
+        SecurityPolicy security_policy;
+        Crypto::Symmetric128BitsKeyByteArray encryption_key;
+        Crypto::Symmetric128BitsKeyByteArray privacy_key;
+    };
+
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
 
+    /**
+     * Must be called before changing the group key map or key sets, so that the next lookup reloads the session index.
+     */
+    void InvalidateGroupSessionIndex();
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    /**
+     * Load the operational keys of every keyset-group mapping, sorted by session id and otherwise in storage order.
+     * Fails if they do not all fit.
+     */
+    CHIP_ERROR LoadGroupSessionIndex();
+    CHIP_ERROR AddToGroupSessionIndex(FabricIndex fabric_index, GroupId group_id, SecurityPolicy policy,
+                                      const Crypto::GroupOperationalCredentials & creds);
+#endif
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
@@ -254,6 +283,17 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+#if CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE > 0
+    enum class IndexState : uint8_t
+    {
+        kStale,  // Reload on next lookup
+        kLoaded, // mGroupSessionIndex holds every mapped key
+        kFailed, // Keys did not fit or could not be loaded, look them up in storage until the next change
+    };
+    GroupSessionEntry mGroupSessionIndex[CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE];
+    size_t mGroupSessionIndexCount     = 0;
+    IndexState mGroupSessionIndexState = IndexState::kStale;
+#endif
 };
 
 } // namespace Credentials
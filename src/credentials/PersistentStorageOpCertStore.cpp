@@ -334,6 +334,8 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
     }
 
     // TODO: Handle transaction marking to revert partial certs at next boot if we get interrupted by reboot.
+    // Storage that supports batches already writes all certs at once, and keeps none of them on failure.
+    PersistentStorageBatch storageBatch(*mStorage);
 
     // Start committing NOC first so we don't have dangling roots if one was added.
     ByteSpan pendingNocSpan{ mPendingNoc.Get(), mPendingNoc.AllocatedSize() };
@@ -374,9 +376,12 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
             // TODO: Handle transaction marking to revert certs if somehow failing store on update by pre-backing-up opcerts
         }
 
+        // Aborting the batch restores the previous certs where storage supports batches.
         return stickyErr;
     }
 
+    ReturnErrorOnFailure(storageBatch.Commit());
+
     // If we got here, we succeeded and can reset the pending certs: next `GetCertificate` will use the stored certs
     RevertPendingOpCerts();
     return CHIP_NO_ERROR;
@@ -411,6 +416,7 @@ CHIP_ERROR PersistentStorageOpCertStore::RemoveOpCertsForFabric(FabricIndex fabr
     RevertPendingOpCerts();
 
     // Remove all persisted certs for the given fabric, blindly
+    PersistentStorageBatch storageBatch(*mStorage);
     CHIP_ERROR nocErr  = DeleteCertFromStorage(mStorage, fabricIndex, CertChainElement::kNoc);
     CHIP_ERROR icacErr = DeleteCertFromStorage(mStorage, fabricIndex, CertChainElement::kIcac);
     CHIP_ERROR rcacErr = DeleteCertFromStorage(mStorage, fabricIndex, CertChainElement::kRcac);
@@ -425,7 +431,8 @@ CHIP_ERROR PersistentStorageOpCertStore::RemoveOpCertsForFabric(FabricIndex fabr
     stickyErr            = (stickyErr != CHIP_NO_ERROR) ? stickyErr : icacErr;
     stickyErr            = (stickyErr != CHIP_NO_ERROR) ? stickyErr : rcacErr;
 
-    return stickyErr;
+    CHIP_ERROR batchErr = storageBatch.Commit();
+    return (stickyErr != CHIP_NO_ERROR) ? stickyErr : batchErr;
 }
 
 CHIP_ERROR PersistentStorageOpCertStore::GetPendingCertificate(FabricIndex fabricIndex, CertChainElement element,
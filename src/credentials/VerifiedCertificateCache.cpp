@@ -0,0 +1,110 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <credentials/VerifiedCertificateCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <mutex>
+#include <string.h>
+
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+
+namespace chip {
+namespace Credentials {
+
+VerifiedCertificateCache::VerifiedCertificateCache()
+{
+    System::Mutex::Init(mLock);
+}
+
+VerifiedCertificateCache::~VerifiedCertificateCache()
+{
+    Clear();
+}
+
+CHIP_ERROR VerifiedCertificateCache::ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & signer,
+                                                   uint8_t (&outDigest)[Crypto::kSHA256_Hash_Length])
+{
+    VerifyOrReturnError(cert.mCertFlags.Has(CertFlags::kTBSHashPresent), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Crypto::Hash_SHA256_stream hash;
+    ReturnErrorOnFailure(hash.Begin());
+    ReturnErrorOnFailure(hash.AddData(ByteSpan(cert.mTBSHash)));
+    ReturnErrorOnFailure(hash.AddData(cert.mSignature));
+    ReturnErrorOnFailure(hash.AddData(signer.mPublicKey));
+    MutableByteSpan digestSpan(outDigest);
+    return hash.Finish(digestSpan);
+}
+
+bool VerifiedCertificateCache::Contains(const ChipCertificateData & cert, const ChipCertificateData & signer)
+{
+    uint8_t digest[Crypto::kSHA256_Hash_Length];
+    VerifyOrReturnValue(ComputeDigest(cert, signer, digest) == CHIP_NO_ERROR, false);
+
+    std::lock_guard<System::Mutex> lock(mLock);
+    for (size_t i = 0; i < mSize; i++)
+    {
+        if (memcmp(mEntries[i].mDigest, digest, sizeof(digest)) == 0)
+        {
+            mEntries[i].mLastUsed = ++mUseCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+void VerifiedCertificateCache::Add(const ChipCertificateData & cert, const ChipCertificateData & signer)
+{
+    uint8_t digest[Crypto::kSHA256_Hash_Length];
+    VerifyOrReturn(ComputeDigest(cert, signer, digest) == CHIP_NO_ERROR);
+
+    std::lock_guard<System::Mutex> lock(mLock);
+    size_t index = 0;
+    for (size_t i = 0; i < mSize; i++)
+    {
+        if (memcmp(mEntries[i].mDigest, digest, sizeof(digest)) == 0)
+        {
+            // Added by a concurrent validation of the same chain.
+            mEntries[i].mLastUsed = ++mUseCount;
+            return;
+        }
+        if (mEntries[i].mLastUsed < mEntries[index].mLastUsed)
+        {
+            index = i;
+        }
+    }
+    if (mSize < kCapacity)
+    {
+        index = mSize++;
+    }
+
+    memcpy(mEntries[index].mDigest, digest, sizeof(digest));
+    mEntries[index].mLastUsed = ++mUseCount;
+}
+
+void VerifiedCertificateCache::Clear()
+{
+    std::lock_guard<System::Mutex> lock(mLock);
+    mSize = 0;
+}
+
+} // namespace Credentials
+} // namespace chip
+
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <credentials/CHIPCert.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <system/SystemMutex.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+
+namespace chip {
+namespace Credentials {
+
+/**
+ * A bounded, least recently used set of certificate signatures that were found valid, so that validating a certificate
+ * chain that was seen before skips the ECDSA verifications.
+ *
+ * An entry is the SHA-256 digest of a certificate's TBS hash, its signature and the public key of the certificate that
+ * signed it, so a hit means that this exact signature was verified with this exact key. Only signatures are cached: the
+ * key usage, validity period and policy checks of ChipCertificateSet::ValidateCert still run on every validation, which
+ * keeps the result correct when the effective time changes. Entries for a chain naturally stop matching when its root or
+ * any certificate in it changes; the owner may also Clear() the cache when fabrics change, to drop them sooner.
+ *
+ * The cache may be used from several threads at once, e.g. from CASE work running in the background.
+ */
+class VerifiedCertificateCache
+{
+public:
+    static constexpr size_t kCapacity = CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE;
+
+    VerifiedCertificateCache();
+    ~VerifiedCertificateCache();
+
+    /**
+     * Returns whether the signature of cert was previously verified with the public key of signer, and if so makes it the
+     * most recently used entry.
+     */
+    bool Contains(const ChipCertificateData & cert, const ChipCertificateData & signer);
+
+    /**
+     * Record that the signature of cert was verified with the public key of signer, evicting the least recently used entry
+     * if the cache is full.
+     */
+    void Add(const ChipCertificateData & cert, const ChipCertificateData & signer);
+
+    void Clear();
+
+private:
+    struct Entry
+    {
+        uint8_t mDigest[Crypto::kSHA256_Hash_Length];
+        uint32_t mLastUsed;
+    };
+
+    static CHIP_ERROR ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & signer,
+                                    uint8_t (&outDigest)[Crypto::kSHA256_Hash_Length]);
+
+    System::Mutex mLock;
+    Entry mEntries[kCapacity];
+    size_t mSize       = 0;
+    uint32_t mUseCount = 0;
+};
+
+} // namespace Credentials
+} // namespace chip
+
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
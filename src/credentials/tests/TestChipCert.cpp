@@ -25,6 +25,7 @@
  */
 
 #include <credentials/CHIPCert.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <credentials/examples/LastKnownGoodTimeCertificateValidityPolicyExample.h>
 #include <credentials/examples/StrictCertificateValidityPolicyExample.h>
 #include <crypto/CHIPCryptoPAL.h>
@@ -1335,6 +1336,46 @@ static void TestChipCert_LoadDuplicateCerts(nlTestSuite * inSuite, void * inCont
     NL_TEST_ASSERT(inSuite, certSet.GetCertCount() == 3);
 }
 
+static void TestChipCert_VerifiedCertCache(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+    ChipCertificateSet certSet;
+    VerifiedCertificateCache cache;
+    ValidationContext validContext;
+
+    NL_TEST_ASSERT(inSuite, certSet.Init(3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, LoadTestCertSet01(certSet) == CHIP_NO_ERROR);
+    const ChipCertificateData * rootCert = &certSet.GetCertSet()[0];
+    const ChipCertificateData * icaCert  = &certSet.GetCertSet()[1];
+    const ChipCertificateData * nocCert  = &certSet.GetCertSet()[2];
+
+    validContext.Reset();
+    validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+    validContext.mVerifiedCertCache = &cache;
+
+    // Validating the chain records both of its signatures.
+    NL_TEST_ASSERT(inSuite, SetCurrentTime(validContext, 2021, 1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !cache.Contains(*nocCert, *icaCert));
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(nocCert, validContext) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Contains(*nocCert, *icaCert));
+    NL_TEST_ASSERT(inSuite, cache.Contains(*icaCert, *rootCert));
+
+    // A signature is only known as verified with the key that verified it.
+    NL_TEST_ASSERT(inSuite, !cache.Contains(*nocCert, *rootCert));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(*icaCert, *icaCert));
+
+    // Cached signatures do not skip the other checks, e.g. of the validity period.
+    NL_TEST_ASSERT(inSuite, SetCurrentTime(validContext, 2020, 1, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(nocCert, validContext) == CHIP_ERROR_CERT_NOT_VALID_YET);
+    NL_TEST_ASSERT(inSuite, SetCurrentTime(validContext, 2021, 1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(nocCert, validContext) == CHIP_NO_ERROR);
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, !cache.Contains(*nocCert, *icaCert));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(*icaCert, *rootCert));
+#endif // CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE > 0
+}
+
 static void TestChipCert_GenerateRootCert(nlTestSuite * inSuite, void * inContext)
 {
     // Generate a new keypair for cert signing
@@ -2237,6 +2278,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test CHIP Certificate ID", TestChipCert_CertId),
     NL_TEST_DEF("Test CHIP Certificate Decoding Options", TestChipCert_DecodingOptions),
     NL_TEST_DEF("Test Loading Duplicate Certificates", TestChipCert_LoadDuplicateCerts),
+    NL_TEST_DEF("Test Verified Certificate Cache", TestChipCert_VerifiedCertCache),
     NL_TEST_DEF("Test CHIP Generate Root Certificate", TestChipCert_GenerateRootCert),
     NL_TEST_DEF("Test CHIP Generate Root Certificate with Fabric", TestChipCert_GenerateRootFabCert),
     NL_TEST_DEF("Test CHIP Generate ICA Certificate", TestChipCert_GenerateICACert),
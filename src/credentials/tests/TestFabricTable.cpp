@@ -35,6 +35,7 @@
 #include <crypto/PersistentStorageOperationalKeystore.h>
 #include <lib/asn1/ASN1.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
 #include <lib/support/UnitTestExtendedAssertions.h>
 #include <lib/support/UnitTestRegistration.h>
@@ -2996,6 +2997,85 @@ void TestCommitMarker(nlTestSuite * inSuite, void * inContext)
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 }
 
+void TestFailedOpCertCommit(nlTestSuite * inSuite, void * inContext)
+{
+    Credentials::TestOnlyLocalCertificateAuthority fabricCertAuthority;
+
+    chip::TestPersistentStorageDelegate storage;
+
+    NL_TEST_ASSERT(inSuite, fabricCertAuthority.Init().IsSuccess());
+
+    constexpr uint16_t kVendorId = 0xFFF1u;
+    constexpr FabricId kFabricId = 1111;
+    constexpr NodeId kNodeId     = 55;
+
+    size_t numStorageKeysAtStart = storage.GetNumKeys();
+
+    {
+        ScopedFabricTable fabricTableHolder;
+        NL_TEST_ASSERT(inSuite, fabricTableHolder.Init(&storage) == CHIP_NO_ERROR);
+        FabricTable & fabricTable = fabricTableHolder.GetFabricTable();
+
+        // Add Fabric 1111 Node Id 55, no ICAC
+        {
+            uint8_t csrBuf[chip::Crypto::kMIN_CSR_Buffer_Size];
+            MutableByteSpan csrSpan{ csrBuf };
+            NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.AllocatePendingOperationalKey(chip::NullOptional, csrSpan));
+
+            NL_TEST_ASSERT_SUCCESS(
+                inSuite, fabricCertAuthority.SetIncludeIcac(false).GenerateNocChain(kFabricId, kNodeId, csrSpan).GetStatus());
+            NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.AddNewPendingTrustedRootCert(fabricCertAuthority.GetRcac()));
+            FabricIndex newFabricIndex = kUndefinedFabricIndex;
+            NL_TEST_ASSERT_SUCCESS(inSuite,
+                                   fabricTable.AddNewPendingFabricWithOperationalKeystore(fabricCertAuthority.GetNoc(), ByteSpan{},
+                                                                                          kVendorId, &newFabricIndex));
+            NL_TEST_ASSERT(inSuite, newFabricIndex == 1);
+            NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.CommitPendingFabricData());
+            NL_TEST_ASSERT_EQUALS(inSuite, fabricTable.FabricCount(), 1);
+        }
+
+        // Update it with an ICAC that cannot be stored: committing the op certs aborts their nested batch, which
+        // makes the batch of the whole commit fail.
+        {
+            uint8_t csrBuf[chip::Crypto::kMIN_CSR_Buffer_Size];
+            MutableByteSpan csrSpan{ csrBuf };
+            NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.AllocatePendingOperationalKey(chip::MakeOptional<FabricIndex>(1), csrSpan));
+
+            NL_TEST_ASSERT_SUCCESS(
+                inSuite, fabricCertAuthority.SetIncludeIcac(true).GenerateNocChain(kFabricId, kNodeId, csrSpan).GetStatus());
+            NL_TEST_ASSERT_SUCCESS(inSuite,
+                                   fabricTable.UpdatePendingFabricWithOperationalKeystore(1, fabricCertAuthority.GetNoc(),
+                                                                                          fabricCertAuthority.GetIcac()));
+
+            storage.AddPoisonKey(DefaultStorageKeyAllocator::FabricICAC(1).KeyName());
+            NL_TEST_ASSERT(inSuite, fabricTable.CommitPendingFabricData() != CHIP_NO_ERROR);
+            storage.ClearPoisonKeys();
+
+            NL_TEST_ASSERT_EQUALS(inSuite, fabricTable.FabricCount(), 0);
+        }
+
+        // The failed commit removed the fabric from storage too, not only from memory.
+        NL_TEST_ASSERT(inSuite, !storage.HasKey(DefaultStorageKeyAllocator::FabricMetadata(1).KeyName()));
+        NL_TEST_ASSERT(inSuite, !storage.HasKey(DefaultStorageKeyAllocator::FabricNOC(1).KeyName()));
+        NL_TEST_ASSERT(inSuite, !storage.HasKey(DefaultStorageKeyAllocator::FabricICAC(1).KeyName()));
+        NL_TEST_ASSERT(inSuite, !storage.HasKey(DefaultStorageKeyAllocator::FabricRCAC(1).KeyName()));
+        NL_TEST_ASSERT(inSuite, !storage.HasKey(DefaultStorageKeyAllocator::FabricOpKey(1).KeyName()));
+        NL_TEST_ASSERT(inSuite, !storage.HasKey(DefaultStorageKeyAllocator::FailSafeCommitMarkerKey().KeyName()));
+        NL_TEST_ASSERT(inSuite, storage.GetNumKeys() > numStorageKeysAtStart); // Fabric index and last known good time remain
+    }
+
+    // The fabric does not come back on reboot.
+    {
+        ScopedFabricTable fabricTableHolder;
+        NL_TEST_ASSERT(inSuite, fabricTableHolder.Init(&storage) == CHIP_NO_ERROR);
+        FabricTable & fabricTable = fabricTableHolder.GetFabricTable();
+
+        NL_TEST_ASSERT_EQUALS(inSuite, fabricTable.FabricCount(), 0);
+        NL_TEST_ASSERT(inSuite, fabricTable.FindFabricWithIndex(1) == nullptr);
+        NL_TEST_ASSERT(inSuite, fabricTable.GetDeletedFabricFromCommitMarker() == kUndefinedFabricIndex);
+    }
+}
+
 // Test Suite
 
 /**
@@ -3023,6 +3103,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Test invalid chaining in AddNOC and UpdateNOC", TestInvalidChaining),
     NL_TEST_DEF("Test ephemeral keys allocation", TestEphemeralKeys),
     NL_TEST_DEF("Test proper detection of Commit Marker on init", TestCommitMarker),
+    NL_TEST_DEF("Test failed op cert commit removes the fabric from storage", TestFailedOpCertCommit),
     NL_TEST_DEF("Test colliding fabrics in the fabric table", TestCollidingFabrics),
 
     NL_TEST_SENTINEL()
@@ -38,6 +38,10 @@ using KeySet         = GroupDataProvider::KeySet;
 using GroupSession   = GroupDataProvider::GroupSession;
 using SecurityPolicy = GroupDataProvider::SecurityPolicy;
 
+namespace {
+static chip::TestPersistentStorageDelegate sDelegate;
+} // namespace
+
 namespace chip {
 namespace app {
 namespace TestGroups {
@@ -1196,13 +1200,62 @@ void TestGroupDecryption(nlTestSuite * apSuite, void * apContext)
     }
 }
 
+size_t CountGroupSessions(GroupDataProvider * provider, uint16_t session_id, FabricIndex fabric_index, GroupId group_id)
+{
+    GroupSession session;
+    size_t count = 0;
+    auto it      = provider->IterateGroupSessions(session_id);
+    VerifyOrReturnValue(it != nullptr, 0);
+    while (it->Next(session))
+    {
+        if (session.fabric_index == fabric_index && session.group_id == group_id)
+        {
+            count++;
+        }
+    }
+    it->Release();
+    return count;
+}
+
+void TestGroupSessionIndex(nlTestSuite * apSuite, void * apContext)
+{
+    // Relies on the key sets and mappings set up by TestGroupDecryption
+    GroupDataProvider * provider = GetGroupDataProvider();
+    NL_TEST_ASSERT(apSuite, provider);
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric2, kGroup2);
+    NL_TEST_ASSERT(apSuite, nullptr != key_context);
+    VerifyOrReturn(nullptr != key_context);
+    uint16_t session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+
+    // Once loaded, sessions are found without reading the storage
+    for (const auto & key : sDelegate.GetKeys())
+    {
+        sDelegate.AddPoisonKey(key);
+    }
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+    sDelegate.ClearPoisonKeys();
+
+    // Mapping changes are seen by the next lookup
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveGroupKeyAt(kFabric2, 0));
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 1, kGroup2Keyset1));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+
+    // So are key set changes
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveKeySet(kFabric2, kKeySet1.keyset_id));
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, session_id, kFabric2, kGroup2));
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
 
 namespace {
 
-static chip::TestPersistentStorageDelegate sDelegate;
 static chip::Crypto::DefaultSessionKeystore sSessionKeystore;
 static GroupDataProviderImpl sProvider(chip::app::TestGroups::kMaxGroupsPerFabric, chip::app::TestGroups::kMaxGroupKeysPerFabric);
 
@@ -1275,6 +1328,7 @@ const nlTest sTests[] = { NL_TEST_DEF("TestStorageDelegate", chip::app::TestGrou
                           NL_TEST_DEF("TestIpk", chip::app::TestGroups::TestIpk),
                           NL_TEST_DEF("TestPerFabricData", chip::app::TestGroups::TestPerFabricData),
                           NL_TEST_DEF("TestGroupDecryption", chip::app::TestGroups::TestGroupDecryption),
+                          NL_TEST_DEF("TestGroupSessionIndex", chip::app::TestGroups::TestGroupSessionIndex),
                           NL_TEST_SENTINEL() };
 } // namespace
 
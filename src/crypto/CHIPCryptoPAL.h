@@ -600,12 +600,42 @@ public:
     template <class T>
     T & AsMutable()
     {
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+        // The key may be about to change, so a cipher keyed with it can no longer be trusted.
+        ReleaseCachedCipher();
+#endif
         return *SafePointerCast<T *>(&mContext);
     }
 
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+    /**
+     * @brief Cipher context keyed with this handle's key, kept by the crypto PAL between operations
+     *        so that they do not each have to run the key schedule.
+     *
+     * The cached cipher is owned by the handle and released with it, or when the key is accessed
+     * through AsMutable(). A handle with a cached cipher must not be used from several threads at once.
+     */
+    struct CachedCipher
+    {
+        void * context     = nullptr; // Opaque PAL cipher context, nullptr if none is cached
+        size_t nonceLength = 0;       // Nonce length the context was set up for
+        size_t tagLength   = 0;       // Tag length the context was set up for
+        bool encrypt       = false;   // Whether the context was set up for encryption or decryption
+    };
+
+    CachedCipher & GetCachedCipher() const { return mCachedCipher; }
+    void ReleaseCachedCipher() const;
+#endif
+
 protected:
     Symmetric128BitsKeyHandle() = default;
-    ~Symmetric128BitsKeyHandle() { ClearSecretData(mContext.mOpaque); }
+    ~Symmetric128BitsKeyHandle()
+    {
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+        ReleaseCachedCipher();
+#endif
+        ClearSecretData(mContext.mOpaque);
+    }
 
 private:
     static constexpr size_t kContextSize = CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES;
@@ -614,6 +644,10 @@ private:
     {
         uint8_t mOpaque[kContextSize] = {};
     } mContext;
+
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+    mutable CachedCipher mCachedCipher;
+#endif
 };
 
 /**
@@ -146,19 +146,85 @@ static int _compareDaysAndSeconds(const int days, const int seconds)
     return 0;
 }
 
+void Symmetric128BitsKeyHandle::ReleaseCachedCipher() const
+{
+    if (mCachedCipher.context != nullptr)
+    {
+#if CHIP_CRYPTO_BORINGSSL
+        EVP_AEAD_CTX_free(static_cast<EVP_AEAD_CTX *>(mCachedCipher.context));
+#else
+        EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX *>(mCachedCipher.context));
+#endif // CHIP_CRYPTO_BORINGSSL
+    }
+    mCachedCipher = CachedCipher();
+}
+
+#if CHIP_CRYPTO_BORINGSSL
+using AesCcmContext = EVP_AEAD_CTX;
+#else
+using AesCcmContext = EVP_CIPHER_CTX;
+#endif // CHIP_CRYPTO_BORINGSSL
+
+/**
+ * Returns the AES-CCM context cached in the key handle, keyed with its key for the given nonce and
+ * tag lengths and direction, setting one up if there is none or it was set up differently.
+ *
+ * The OpenSSL context keeps the key schedule across messages: each message only needs its nonce
+ * (and for decryption its tag) passed in again. Returns nullptr on failure.
+ */
+static AesCcmContext * _getKeyedAesCcmContext(const Aes128KeyHandle & key, size_t nonce_length, size_t tag_length, bool encrypt)
+{
+    Aes128KeyHandle::CachedCipher & cached = key.GetCachedCipher();
+#if CHIP_CRYPTO_BORINGSSL
+    // An EVP_AEAD_CTX can both seal and open.
+    encrypt = cached.encrypt;
+#endif // CHIP_CRYPTO_BORINGSSL
+    if (cached.context != nullptr && cached.nonceLength == nonce_length && cached.tagLength == tag_length &&
+        cached.encrypt == encrypt)
+    {
+        return static_cast<AesCcmContext *>(cached.context);
+    }
+    key.ReleaseCachedCipher();
+
+#if CHIP_CRYPTO_BORINGSSL
+    AesCcmContext * context = EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), key.As<Symmetric128BitsKeyByteArray>(),
+                                               sizeof(Symmetric128BitsKeyByteArray), tag_length);
+    VerifyOrReturnValue(context != nullptr, nullptr);
+#else
+    AesCcmContext * context = EVP_CIPHER_CTX_new();
+    VerifyOrReturnValue(context != nullptr, nullptr);
+
+    // Pass in cipher, nonce length and tag length. Casts are safe because the callers checked the lengths.
+    // CCM binds both lengths, and the direction, when the key is set, so they cannot change afterwards.
+    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
+    const int enc = encrypt ? 1 : 0;
+    if (EVP_CipherInit_ex(context, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, enc) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr) != 1 ||
+        EVP_CipherInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), nullptr, enc) != 1)
+    {
+        EVP_CIPHER_CTX_free(context);
+        return nullptr;
+    }
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    cached.context     = context;
+    cached.nonceLength = nonce_length;
+    cached.tagLength   = tag_length;
+    cached.encrypt     = encrypt;
+    return context;
+}
+
 CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
                            const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
                            uint8_t * tag, size_t tag_length)
 {
+    AesCcmContext * context = nullptr;
 #if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
     size_t written_tag_len = 0;
-    const EVP_AEAD * aead  = nullptr;
 #else
-    EVP_CIPHER_CTX * context = nullptr;
     int bytesWritten         = 0;
     size_t ciphertext_length = 0;
-    const EVP_CIPHER * type  = nullptr;
 #endif
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -201,38 +267,17 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
                               error = CHIP_ERROR_INVALID_ARGUMENT);
 #endif // CHIP_CRYPTO_BORINGSSL
 
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
-
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
+    context = _getKeyedAesCcmContext(key, nonce_length, tag_length, true);
     VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
+#if CHIP_CRYPTO_BORINGSSL
     result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
                                        plaintext_length, nullptr, 0, aad, aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
     VerifyOrExit(written_tag_len == tag_length, error = CHIP_ERROR_INTERNAL);
 #else
-
-    type = EVP_aes_128_ccm();
-
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
-
-    // Pass in cipher
-    result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    // Pass in nonce, keeping the key
+    result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in plain text length
@@ -268,14 +313,10 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (error != CHIP_NO_ERROR)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
-        context = nullptr;
+        // Do not reuse a context left in an unknown state.
+        key.ReleaseCachedCipher();
     }
 
     return error;
@@ -285,15 +326,10 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext)
 {
-#if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
-    const EVP_AEAD * aead  = nullptr;
-#else
-
-    EVP_CIPHER_CTX * context = nullptr;
-    int bytesOutput          = 0;
-    const EVP_CIPHER * type  = nullptr;
-#endif // CHIP_CRYPTO_BORINGSSL
+    AesCcmContext * context = nullptr;
+#if !CHIP_CRYPTO_BORINGSSL
+    int bytesOutput = 0;
+#endif // !CHIP_CRYPTO_BORINGSSL
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
 
@@ -333,28 +369,17 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
     VerifyOrExit(nonce != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(nonce_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
-
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
+    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    context = _getKeyedAesCcmContext(key, nonce_length, tag_length, false);
     VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
+#if CHIP_CRYPTO_BORINGSSL
     result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length, aad,
                                       aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 #else
-    type = EVP_aes_128_ccm();
-
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
-
-    // Pass in cipher
-    result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in nonce length
-    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
+    // Pass in nonce, keeping the key
+    result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in expected tag
@@ -365,11 +390,6 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                                               const_cast<void *>(static_cast<const void *>(tag)));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
     // Pass in cipher text length
     VerifyOrExit(CanCastTo<int>(ciphertext_length), error = CHIP_ERROR_INVALID_ARGUMENT);
     result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, nullptr, static_cast<int>(ciphertext_length));
@@ -397,15 +417,10 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (error != CHIP_NO_ERROR)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
-
-        context = nullptr;
+        // Do not reuse a context left in an unknown state.
+        key.ReleaseCachedCipher();
     }
 
     return error;
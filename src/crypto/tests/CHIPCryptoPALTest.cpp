@@ -432,6 +432,63 @@ static void TestAES_CCM_128DecryptInvalidNonceLen(nlTestSuite * inSuite, void *
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+static void TestAES_CCM_128ReuseKey(nlTestSuite * inSuite, void * inContext)
+{
+    HeapChecker heapChecker(inSuite);
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+            out_ct.Alloc(vector->ct_len);
+            NL_TEST_ASSERT(inSuite, out_ct);
+            Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+            out_tag.Alloc(vector->tag_len);
+            NL_TEST_ASSERT(inSuite, out_tag);
+            Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+            out_pt.Alloc(vector->pt_len);
+            NL_TEST_ASSERT(inSuite, out_pt);
+
+            // The same key handle is used for every operation, alternating between encryption and decryption,
+            // with a failed decryption and a different tag length in between.
+            TestAesKey key(inSuite, vector->key, vector->key_len);
+
+            for (int round = 0; round < 2; round++)
+            {
+                memset(out_ct.Get(), 0, vector->ct_len);
+                memset(out_tag.Get(), 0, vector->tag_len);
+                CHIP_ERROR err = AES_CCM_encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, key.key, vector->nonce,
+                                                 vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len);
+                NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, memcmp(out_ct.Get(), vector->ct, vector->ct_len) == 0);
+                NL_TEST_ASSERT(inSuite, memcmp(out_tag.Get(), vector->tag, vector->tag_len) == 0);
+
+                out_tag[0] ^= 1;
+                err = AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, out_tag.Get(), vector->tag_len,
+                                      key.key, vector->nonce, vector->nonce_len, out_pt.Get());
+                NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+
+                memset(out_pt.Get(), 0, vector->pt_len);
+                err = AES_CCM_decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                      key.key, vector->nonce, vector->nonce_len, out_pt.Get());
+                NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, memcmp(out_pt.Get(), vector->pt, vector->pt_len) == 0);
+
+                uint8_t other_tag[16];
+                size_t other_tag_len = (vector->tag_len == sizeof(other_tag)) ? 8 : sizeof(other_tag);
+                err = AES_CCM_encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, key.key, vector->nonce,
+                                      vector->nonce_len, out_ct.Get(), other_tag, other_tag_len);
+                NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            }
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
 static void TestSensitiveDataBuffer(nlTestSuite * inSuite, void * inContext)
 {
     HeapChecker heapChecker(inSuite);
@@ -2984,6 +3041,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid nonce", TestAES_CCM_128EncryptInvalidNonceLen),
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid tag", TestAES_CCM_128EncryptInvalidTagLen),
     NL_TEST_DEF("Test decrypting AES-CCM-128 invalid nonce", TestAES_CCM_128DecryptInvalidNonceLen),
+    NL_TEST_DEF("Test reusing an AES-CCM-128 key across operations", TestAES_CCM_128ReuseKey),
     NL_TEST_DEF("Test encrypt/decrypt AES-CTR-128 test vectors", TestAES_CTR_128CryptTestVectors),
     NL_TEST_DEF("Test ASN.1 signature conversion routines", TestAsn1Conversions),
     NL_TEST_DEF("Test reading a length from ASN.1 DER stream success cases", TestReadDerLengthValidCases),
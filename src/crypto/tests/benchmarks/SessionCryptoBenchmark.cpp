@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Microbenchmark measuring how many messages per second a session can encrypt and decrypt
+ *      with AES-CCM-128, for increasing payload sizes, when each operation uses a fresh key
+ *      handle and when the session key handles are reused from one message to the next.
+ *
+ *      Usage: chip-crypto-session-benchmark [payload-size ...]
+ */
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+constexpr size_t kMessageCount = 20000;
+constexpr size_t kTagLength    = CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
+constexpr size_t kHeaderLength = 8;
+
+struct Message
+{
+    std::vector<uint8_t> header;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> ciphertext;
+    std::vector<uint8_t> decrypted;
+    uint8_t nonce[kAES_CCM128_Nonce_Length];
+    uint8_t tag[kTagLength];
+};
+
+double MessagesPerSecond(std::chrono::steady_clock::time_point start, size_t count)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(count) / elapsed.count();
+}
+
+void Check(CHIP_ERROR err, const char * what)
+{
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "%s failed: %" CHIP_ERROR_FORMAT "\n", what, err.Format());
+        exit(EXIT_FAILURE);
+    }
+}
+
+void RoundTrip(Message & message, const Aes128KeyHandle & encryptionKey, const Aes128KeyHandle & decryptionKey)
+{
+    Check(AES_CCM_encrypt(message.payload.data(), message.payload.size(), message.header.data(), message.header.size(),
+                          encryptionKey, message.nonce, sizeof(message.nonce), message.ciphertext.data(), message.tag,
+                          sizeof(message.tag)),
+          "AES_CCM_encrypt");
+    Check(AES_CCM_decrypt(message.ciphertext.data(), message.ciphertext.size(), message.header.data(), message.header.size(),
+                          message.tag, sizeof(message.tag), decryptionKey, message.nonce, sizeof(message.nonce),
+                          message.decrypted.data()),
+          "AES_CCM_decrypt");
+}
+
+// Each operation sets up its key from scratch, as a PAL without a per-key cipher cache does.
+double RunFreshKeys(DefaultSessionKeystore & keystore, const Symmetric128BitsKeyByteArray & keyMaterial, Message & message)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        message.nonce[0] = static_cast<uint8_t>(i);
+        Aes128KeyHandle encryptionKey;
+        Aes128KeyHandle decryptionKey;
+        Check(keystore.CreateKey(keyMaterial, encryptionKey), "CreateKey");
+        Check(keystore.CreateKey(keyMaterial, decryptionKey), "CreateKey");
+        RoundTrip(message, encryptionKey, decryptionKey);
+        keystore.DestroyKey(encryptionKey);
+        keystore.DestroyKey(decryptionKey);
+    }
+    return MessagesPerSecond(start, kMessageCount);
+}
+
+// The key handles live as long as the session, as they do in CryptoContext.
+double RunSessionKeys(DefaultSessionKeystore & keystore, const Symmetric128BitsKeyByteArray & keyMaterial, Message & message)
+{
+    Aes128KeyHandle encryptionKey;
+    Aes128KeyHandle decryptionKey;
+    Check(keystore.CreateKey(keyMaterial, encryptionKey), "CreateKey");
+    Check(keystore.CreateKey(keyMaterial, decryptionKey), "CreateKey");
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        message.nonce[0] = static_cast<uint8_t>(i);
+        RoundTrip(message, encryptionKey, decryptionKey);
+    }
+    double result = MessagesPerSecond(start, kMessageCount);
+
+    keystore.DestroyKey(encryptionKey);
+    keystore.DestroyKey(decryptionKey);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; i++)
+    {
+        sizes.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 0)));
+    }
+    if (sizes.empty())
+    {
+        sizes = { 16, 64, 256, 1024 };
+    }
+
+    DefaultSessionKeystore keystore;
+    Symmetric128BitsKeyByteArray keyMaterial;
+    for (size_t i = 0; i < sizeof(keyMaterial); i++)
+    {
+        keyMaterial[i] = static_cast<uint8_t>(i);
+    }
+
+    printf("%8s  %16s  %16s\n", "payload", "fresh keys msg/s", "session msg/s");
+    for (size_t size : sizes)
+    {
+        Message message;
+        message.header.assign(kHeaderLength, 0x5a);
+        message.payload.assign(size, 0xa5);
+        message.ciphertext.resize(size);
+        message.decrypted.resize(size);
+        memset(message.nonce, 0, sizeof(message.nonce));
+
+        double fresh   = RunFreshKeys(keystore, keyMaterial, message);
+        double session = RunSessionKeys(keystore, keyMaterial, message);
+        if (message.decrypted != message.payload)
+        {
+            fprintf(stderr, "decrypted payload differs\n");
+            return EXIT_FAILURE;
+        }
+        printf("%8zu  %16.0f  %16.0f\n", size, fresh, session);
+    }
+
+    return EXIT_SUCCESS;
+}
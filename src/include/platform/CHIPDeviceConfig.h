@@ -91,6 +91,16 @@
 #define CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE 100
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_POSIX_EVENT_QUEUE_SIZE
+ *
+ * The number of events that can be held in the lock-free ring of the chip Platform event queue on POSIX platforms.
+ * Events are posted to it without taking a lock, from any thread; while it is full, they go to a list on the heap.
+ */
+#ifndef CHIP_DEVICE_CONFIG_POSIX_EVENT_QUEUE_SIZE
+#define CHIP_DEVICE_CONFIG_POSIX_EVENT_QUEUE_SIZE 1024
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
  *
@@ -127,6 +137,17 @@
 #define CHIP_DEVICE_CONFIG_BG_TASK_PRIORITY 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+ *
+ * The number of background tasks processing the background event queue, on platforms that support
+ * more than one (POSIX). Background work items, such as the certificate validation and signing
+ * steps of CASE session establishment, run in parallel on up to this many tasks.
+ */
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+#define CHIP_DEVICE_CONFIG_BG_TASK_COUNT 1
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
  *
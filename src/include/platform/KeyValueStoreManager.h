@@ -170,10 +170,52 @@ public:
      */
     CHIP_ERROR Delete(const char * key);
 
+    /**
+     * @brief
+     * Starts a batch of changes. Until the batch ends, a KVS that supports
+     * batches may hold back Puts and Deletes and make them durable together
+     * when the batch is committed. Gets return the values as changed by the
+     * batch so far. Batches nest, only ending the outermost batch commits or
+     * aborts its changes, and aborting a nested batch makes the outermost
+     * one fail to commit.
+     *
+     * A KVS that does not support batches applies every change as it is made.
+     *
+     * @return CHIP_NO_ERROR the batch was started
+     *         CHIP_ERROR_UNINITIALIZED the KVS is not initialized
+     */
+    CHIP_ERROR BeginBatch();
+
+    /**
+     * @brief
+     * Ends a batch started by BeginBatch(), making the changes of the
+     * outermost batch durable together.
+     *
+     * @return CHIP_NO_ERROR the changes were committed
+     *         CHIP_ERROR_PERSISTED_STORAGE_FAILED failed to write the changes,
+     *                                             or a nested batch was
+     *                                             aborted; the changes have
+     *                                             been discarded.
+     */
+    CHIP_ERROR CommitBatch();
+
+    /**
+     * @brief
+     * Ends a batch started by BeginBatch(), discarding all changes made since
+     * the outermost batch was started. For a nested batch, the changes are
+     * discarded when the outermost batch ends.
+     */
+    void AbortBatch();
+
 private:
     using ImplClass = ::chip::DeviceLayer::PersistedStorage::KeyValueStoreManagerImpl;
 
 protected:
+    // Default implementations for a KVS without batch support, the implementation class may hide these.
+    CHIP_ERROR _BeginBatch() { return CHIP_NO_ERROR; }
+    CHIP_ERROR _CommitBatch() { return CHIP_NO_ERROR; }
+    void _AbortBatch() {}
+
     // Construction/destruction limited to subclasses.
     KeyValueStoreManager()  = default;
     ~KeyValueStoreManager() = default;
@@ -233,6 +275,21 @@ inline CHIP_ERROR KeyValueStoreManager::Delete(const char * key)
     return static_cast<ImplClass *>(this)->_Delete(key);
 }
 
+inline CHIP_ERROR KeyValueStoreManager::BeginBatch()
+{
+    return static_cast<ImplClass *>(this)->_BeginBatch();
+}
+
+inline CHIP_ERROR KeyValueStoreManager::CommitBatch()
+{
+    return static_cast<ImplClass *>(this)->_CommitBatch();
+}
+
+inline void KeyValueStoreManager::AbortBatch()
+{
+    static_cast<ImplClass *>(this)->_AbortBatch();
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
@@ -103,6 +103,24 @@ public:
         return mKvsManager->Delete(key);
     }
 
+    CHIP_ERROR SyncBeginBatch() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->BeginBatch();
+    }
+
+    CHIP_ERROR SyncCommitBatch() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->CommitBatch();
+    }
+
+    void SyncAbortBatch() override
+    {
+        VerifyOrReturn(mKvsManager != nullptr);
+        mKvsManager->AbortBatch();
+    }
+
 protected:
     DeviceLayer::PersistedStorage::KeyValueStoreManager * mKvsManager = nullptr;
 };
@@ -24,7 +24,7 @@
 
 #pragma once
 
-#include <platform/DeviceSafeQueue.h>
+#include <platform/DeviceEventRingQueue.h>
 #include <platform/internal/GenericPlatformManagerImpl.h>
 
 #include <fcntl.h>
@@ -93,6 +93,13 @@ protected:
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
     void _Shutdown();
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    void _RunBackgroundEventLoop();
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+#endif
+
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
@@ -108,11 +115,27 @@ private:
     static void _DispatchEventViaScheduleWork(System::Layer * aLayer, void * appState);
 #else
 
-    DeviceSafeQueue mChipEventQueue;
+    DeviceEventRingQueue<CHIP_DEVICE_CONFIG_POSIX_EVENT_QUEUE_SIZE> mChipEventQueue;
+    // Set by the first event posted after the CHIP task started draining the queue, so that a burst of events
+    // from other threads wakes the CHIP task only once.
+    std::atomic<bool> mChipEventQueueWakePending{ false };
     std::atomic<bool> mShouldRunEventLoop{ true };
     static void * EventLoopTaskMain(void * arg);
 #endif
     void ProcessDeviceEvents();
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Background events are processed by a pool of CHIP_DEVICE_CONFIG_BG_TASK_COUNT tasks, so independent
+    // background work items run in parallel. Stopping the pool lets the tasks finish the events already
+    // queued. While no task is running, background events are posted to the CHIP event queue instead.
+    pthread_mutex_t mBackgroundEventQueueLock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t mBackgroundEventQueueCond  = PTHREAD_COND_INITIALIZER;
+    std::queue<ChipDeviceEvent> mBackgroundEventQueue;
+    bool mShouldRunBackgroundEventLoop = false; // Guarded by mBackgroundEventQueueLock
+    pthread_t mBackgroundTasks[CHIP_DEVICE_CONFIG_BG_TASK_COUNT];
+    size_t mBackgroundTaskCount = 0;
+    static void * BackgroundEventLoopTaskMain(void * arg);
+#endif
 };
 
 // Instruct the compiler to instantiate the template only when explicitly told to do so.
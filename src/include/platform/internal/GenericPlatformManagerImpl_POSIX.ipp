@@ -40,6 +40,7 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <sched.h>
+#include <string.h>
 #include <unistd.h>
 
 namespace chip {
@@ -72,6 +73,10 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_InitChipStack()
     VerifyOrReturnError(ret == 0, CHIP_ERROR_POSIX(ret));
 #endif
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    ReturnErrorOnFailure(_StartBackgroundEventLoopTask());
+#endif
+
     return CHIP_NO_ERROR;
 }
 
@@ -169,7 +174,11 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDev
 #else
     mChipEventQueue.Push(*event);
 
-    SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    // Events posted while a wake up is pending are picked up by the drain it triggers.
+    if (!mChipEventQueueWakePending.exchange(true, std::memory_order_acq_rel))
+    {
+        SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    }
     return CHIP_NO_ERROR;
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
@@ -179,10 +188,18 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDev
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessDeviceEvents()
 {
-    while (!mChipEventQueue.Empty())
+    ChipDeviceEvent event;
+
+    //
+    // Clear the pending wake up before draining, so that an event posted after the drain started wakes us
+    // up again. An event whose producer has not set the flag yet is left for the wake up it is about to trigger.
+    //
+    while (mChipEventQueueWakePending.exchange(false, std::memory_order_acq_rel))
     {
-        const ChipDeviceEvent event = mChipEventQueue.PopFront();
-        Impl()->DispatchEvent(&event);
+        while (mChipEventQueue.Pop(event))
+        {
+            Impl()->DispatchEvent(&event);
+        }
     }
 }
 
@@ -307,6 +324,119 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartEventLoopTask()
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    VerifyOrReturnError(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    if (!mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        // Use foreground event loop for background events
+        return _PostEvent(event);
+    }
+    mBackgroundEventQueue.push(*event);
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    pthread_cond_signal(&mBackgroundEventQueueCond);
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    while (true)
+    {
+        while (mShouldRunBackgroundEventLoop && mBackgroundEventQueue.empty())
+        {
+            pthread_cond_wait(&mBackgroundEventQueueCond, &mBackgroundEventQueueLock);
+        }
+        // Once stopped, the tasks still drain the queue: every queued work item runs, so that it can release
+        // whatever its argument holds. The CHIP event loop may already be gone, so the work cannot go there.
+        if (mBackgroundEventQueue.empty())
+        {
+            break;
+        }
+
+        const ChipDeviceEvent event = mBackgroundEventQueue.front();
+        mBackgroundEventQueue.pop();
+
+        // Dispatch without holding the queue lock, so that the other tasks can pick up work meanwhile.
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        Impl()->DispatchEvent(&event);
+        pthread_mutex_lock(&mBackgroundEventQueueLock);
+    }
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+}
+
+template <class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::BackgroundEventLoopTaskMain(void * arg)
+{
+    ChipLogDetail(DeviceLayer, "CHIP background task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass> *>(arg)->Impl()->RunBackgroundEventLoop();
+    return nullptr;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    if (mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        return CHIP_NO_ERROR;
+    }
+    mShouldRunBackgroundEventLoop = true;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    for (mBackgroundTaskCount = 0; mBackgroundTaskCount < CHIP_DEVICE_CONFIG_BG_TASK_COUNT; mBackgroundTaskCount++)
+    {
+        int err = pthread_create(&mBackgroundTasks[mBackgroundTaskCount], nullptr, BackgroundEventLoopTaskMain, this);
+        if (err != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to start CHIP background task: %s", strerror(err));
+            _StopBackgroundEventLoopTask();
+            return CHIP_ERROR_POSIX(err);
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = false;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+    pthread_cond_broadcast(&mBackgroundEventQueueCond);
+
+    int err = 0;
+    for (size_t i = 0; i < mBackgroundTaskCount; i++)
+    {
+        // A background task stopping the pool cannot wait for itself.
+        if (pthread_equal(pthread_self(), mBackgroundTasks[i]) == 0)
+        {
+            int joinErr = pthread_join(mBackgroundTasks[i], nullptr);
+            err         = (err == 0) ? joinErr : err;
+        }
+        else
+        {
+            pthread_detach(mBackgroundTasks[i]);
+        }
+    }
+    mBackgroundTaskCount = 0;
+
+    return CHIP_ERROR_POSIX(err);
+}
+
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 #if CHIP_SYSTEM_CONFIG_USE_LIBEV
 // fallback implementation
 void __attribute__((weak)) ExitExternalMainLoop()
@@ -393,6 +523,10 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     //
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    _StopBackgroundEventLoopTask();
+#endif
+
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
@@ -272,6 +272,42 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG
+ *
+ *  @brief
+ *    Use recvmmsg() in the socket-based implementation of UDP endpoints, so
+ *    that several datagrams are received per socket readiness event.
+ *
+ *  @details
+ *    This call is a Linux extension; other platforms fall back to one
+ *    recvmsg() per datagram.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG
+#if defined(__linux__) && !defined(__ZEPHYR__)
+#define INET_CONFIG_UDP_SOCKET_MMSG 1
+#else
+#define INET_CONFIG_UDP_SOCKET_MMSG 0
+#endif
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+ *
+ *  @brief
+ *    Maximum number of datagrams received by one recvmmsg() call when
+ *    INET_CONFIG_UDP_SOCKET_MMSG is enabled.
+ *
+ *  @details
+ *    Each listening UDP endpoint starts with a single posted receive buffer
+ *    and doubles the batch, up to this size, while recvmmsg() fills it;
+ *    the buffers that stay posted between readiness events are maximum-size
+ *    packet buffers.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 8
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
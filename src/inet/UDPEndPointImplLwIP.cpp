@@ -143,11 +143,14 @@ CHIP_ERROR UDPEndPointImplLwIP::SendMsgImpl(const IPPacketInfo * pktInfo, System
     {
         // when retaining a buffer, the caller expects the msg to be unmodified.
         // LwIP stack will normally prepend the packet headers as the packet traverses
-        // the UDP/IP/netif layers, which normally modifies the packet. We need to clone
-        // msg into a fresh object in this case, and queues that for transmission, leaving
-        // the original msg available after return.
-        msg = msg.CloneData();
-        VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
+        // the UDP/IP/netif layers, which normally modifies the packet. Rather than cloning
+        // msg, chain it behind a fresh, empty buffer that takes the headers, leaving the
+        // data of the original msg untouched after return. With PBUF_POOL buffers the
+        // header buffer still takes a full pool entry, so this only saves the copy.
+        System::PacketBufferHandle headers = System::PacketBufferHandle::New(0);
+        VerifyOrReturnError(!headers.IsNull(), CHIP_ERROR_NO_MEMORY);
+        headers->AddToEnd(std::move(msg));
+        msg = std::move(headers);
     }
 
     CHIP_ERROR res = CHIP_NO_ERROR;
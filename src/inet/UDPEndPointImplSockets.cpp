@@ -43,6 +43,7 @@
 #include <zephyr/net/socket.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_ZEPHYR_SOCKETS
 
+#include <algorithm>
 #include <cerrno>
 #include <unistd.h>
 #include <utility>
@@ -278,6 +279,17 @@ CHIP_ERROR UDPEndPointImplSockets::ListenImpl()
     return layer->RequestCallbackOnPendingRead(mWatch);
 }
 
+/**
+ * Storage for the recvmsg() arguments describing one inbound datagram.
+ */
+struct UDPEndPointImplSockets::InboundMessage
+{
+    struct msghdr mHeader;
+    struct iovec mIOV;
+    SockAddr mPeerSockAddr;
+    uint8_t mControlData[256];
+};
+
 CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
 {
     // Ensure packet buffer is not null
@@ -431,6 +443,14 @@ void UDPEndPointImplSockets::CloseImpl()
         close(mSocket);
         mSocket = kInvalidSocketFd;
     }
+
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    for (auto & buffer : mReceiveBuffers)
+    {
+        buffer = nullptr;
+    }
+    mReceiveBatchSize = 1;
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
 }
 
 void UDPEndPointImplSockets::Free()
@@ -575,113 +595,216 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    ReceiveMessageBatch();
+#else
+    ReceiveMessage();
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+}
+
+#if !INET_CONFIG_UDP_SOCKET_MMSG
+void UDPEndPointImplSockets::ReceiveMessage()
+{
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
 
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort  = mBoundPort;
-    lPacketInfo.Interface = mBoundIntfId;
-
     lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
 
     if (!lBuffer.IsNull())
     {
-        struct iovec msgIOV;
-        SockAddr lPeerSockAddr;
-        uint8_t controlData[256];
-        struct msghdr msgHeader;
+        InboundMessage inbound;
+        PrepareInboundMessage(lBuffer, inbound);
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
-
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
-
-        memset(&msgHeader, 0, sizeof(msgHeader));
-
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
-
-        ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+        ssize_t rcvLen = recvmsg(mSocket, &inbound.mHeader, MSG_DONTWAIT);
 
         if (rcvLen < 0)
         {
             lStatus = CHIP_ERROR_POSIX(errno);
         }
-        else if (rcvLen > lBuffer->AvailableDataLength())
-        {
-            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
         else
         {
-            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+            lStatus = ParseInboundMessage(inbound, static_cast<size_t>(rcvLen), lBuffer, lPacketInfo);
+        }
+    }
+    else
+    {
+        lStatus = CHIP_ERROR_NO_MEMORY;
+    }
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
+    DeliverInboundMessage(lStatus, std::move(lBuffer), lPacketInfo);
+}
+#endif // !INET_CONFIG_UDP_SOCKET_MMSG
+
+#if INET_CONFIG_UDP_SOCKET_MMSG
+void UDPEndPointImplSockets::ReceiveMessageBatch()
+{
+    constexpr size_t kBatchSize = INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE;
+
+    InboundMessage inbound[kBatchSize];
+    struct mmsghdr headers[kBatchSize];
+
+    // Post mReceiveBatchSize buffers. Buffers that are not filled by this call stay in mReceiveBuffers for the
+    // next readiness event, so each datagram costs one buffer allocation.
+    size_t posted = 0;
+    for (; posted < mReceiveBatchSize; posted++)
+    {
+        if (mReceiveBuffers[posted].IsNull())
+        {
+            mReceiveBuffers[posted] = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (mReceiveBuffers[posted].IsNull())
             {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
+                break;
             }
         }
+        PrepareInboundMessage(mReceiveBuffers[posted], inbound[posted]);
+        headers[posted].msg_hdr = inbound[posted].mHeader;
+        headers[posted].msg_len = 0;
+    }
 
-        if (lStatus == CHIP_NO_ERROR)
+    if (posted == 0)
+    {
+        DeliverInboundMessage(CHIP_ERROR_NO_MEMORY, System::PacketBufferHandle(), IPPacketInfo());
+        return;
+    }
+
+    const int received = recvmmsg(mSocket, headers, static_cast<unsigned int>(posted), MSG_DONTWAIT, nullptr);
+    if (received < 0)
+    {
+        DeliverInboundMessage(CHIP_ERROR_POSIX(errno), System::PacketBufferHandle(), IPPacketInfo());
+        return;
+    }
+
+    // Size the next batch from this one: double it while the socket fills every posted buffer, and shrink it back
+    // to what was actually received otherwise, releasing the buffers that are no longer posted. An endpoint with
+    // sparse traffic thus keeps a single receive buffer.
+    if (static_cast<size_t>(received) == posted)
+    {
+        mReceiveBatchSize = std::min(posted * 2, kBatchSize);
+    }
+    else
+    {
+        mReceiveBatchSize = std::max(static_cast<size_t>(received), static_cast<size_t>(1));
+        for (size_t i = mReceiveBatchSize; i < posted; i++)
         {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
+            mReceiveBuffers[i] = nullptr;
+        }
+    }
+
+    // Parse everything before delivering anything: callbacks may close the endpoint, which releases mReceiveBuffers.
+    System::PacketBufferHandle buffers[kBatchSize];
+    IPPacketInfo packetInfo[kBatchSize];
+    CHIP_ERROR status[kBatchSize];
+    for (int i = 0; i < received; i++)
+    {
+        buffers[i] = std::move(mReceiveBuffers[i]);
+        // recvmmsg() writes the returned address and control lengths into its own copy of each header.
+        inbound[i].mHeader = headers[i].msg_hdr;
+        status[i]          = ParseInboundMessage(inbound[i], headers[i].msg_len, buffers[i], packetInfo[i]);
+    }
+
+    // Hold a reference so that a callback calling Free() does not release the endpoint under us.
+    Retain();
+    for (int i = 0; i < received && mState == State::kListening; i++)
+    {
+        DeliverInboundMessage(status[i], std::move(buffers[i]), packetInfo[i]);
+    }
+    Release();
+}
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
+void UDPEndPointImplSockets::PrepareInboundMessage(const System::PacketBufferHandle & buffer, InboundMessage & inbound)
+{
+    inbound.mIOV.iov_base = buffer->Start();
+    inbound.mIOV.iov_len  = buffer->AvailableDataLength();
+
+    memset(&inbound.mPeerSockAddr, 0, sizeof(inbound.mPeerSockAddr));
+
+    struct msghdr & msgHeader = inbound.mHeader;
+    memset(&msgHeader, 0, sizeof(msgHeader));
+
+    msgHeader.msg_name       = &inbound.mPeerSockAddr;
+    msgHeader.msg_namelen    = sizeof(inbound.mPeerSockAddr);
+    msgHeader.msg_iov        = &inbound.mIOV;
+    msgHeader.msg_iovlen     = 1;
+    msgHeader.msg_control    = inbound.mControlData;
+    msgHeader.msg_controllen = sizeof(inbound.mControlData);
+}
+
+CHIP_ERROR UDPEndPointImplSockets::ParseInboundMessage(InboundMessage & inbound, size_t rcvLen, System::PacketBufferHandle & lBuffer,
+                                                       IPPacketInfo & lPacketInfo)
+{
+    struct msghdr & msgHeader  = inbound.mHeader;
+    const SockAddr & peer      = inbound.mPeerSockAddr;
+
+    lPacketInfo.Clear();
+    lPacketInfo.DestPort  = mBoundPort;
+    lPacketInfo.Interface = mBoundIntfId;
+
+    if (rcvLen > lBuffer->AvailableDataLength() || (msgHeader.msg_flags & MSG_TRUNC) != 0)
+    {
+        return CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+    }
+
+    lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+
+    if (peer.any.sa_family == AF_INET6)
+    {
+        lPacketInfo.SrcAddress = IPAddress(peer.in6.sin6_addr);
+        lPacketInfo.SrcPort    = ntohs(peer.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (peer.any.sa_family == AF_INET)
+    {
+        lPacketInfo.SrcAddress = IPAddress(peer.in.sin_addr);
+        lPacketInfo.SrcPort    = ntohs(peer.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
 #if INET_CONFIG_ENABLE_IPV4
 #ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
 #endif // defined(IP_PKTINFO)
 #endif // INET_CONFIG_ENABLE_IPV4
 
 #ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
             }
+            lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
         }
-    }
-    else
-    {
-        lStatus = CHIP_ERROR_NO_MEMORY;
+#endif // defined(IPV6_PKTINFO)
     }
 
+    return CHIP_NO_ERROR;
+}
+
+void UDPEndPointImplSockets::DeliverInboundMessage(CHIP_ERROR lStatus, System::PacketBufferHandle && lBuffer,
+                                                   const IPPacketInfo & lPacketInfo)
+{
     if (lStatus == CHIP_NO_ERROR)
     {
         lBuffer.RightSize();
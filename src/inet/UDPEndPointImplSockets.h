@@ -54,13 +54,31 @@ private:
     CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg) override;
     void CloseImpl() override;
 
+    struct InboundMessage;
+
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    void ReceiveMessageBatch();
+#else
+    void ReceiveMessage();
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+    static void PrepareInboundMessage(const System::PacketBufferHandle & buffer, InboundMessage & inbound);
+    CHIP_ERROR ParseInboundMessage(InboundMessage & inbound, size_t rcvLen, System::PacketBufferHandle & buffer,
+                                   IPPacketInfo & pktInfo);
+    void DeliverInboundMessage(CHIP_ERROR status, System::PacketBufferHandle && buffer, const IPPacketInfo & pktInfo);
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+#if INET_CONFIG_UDP_SOCKET_MMSG
+    // Receive buffers posted to recvmmsg() but not yet filled; kept between readiness events.
+    System::PacketBufferHandle mReceiveBuffers[INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE];
+    // Number of buffers posted to the next recvmmsg() call; grows while batches come back full.
+    size_t mReceiveBatchSize = 1;
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 public:
     using MulticastGroupHandler = CHIP_ERROR (*)(InterfaceId, const IPAddress &);
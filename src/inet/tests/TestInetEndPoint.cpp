@@ -361,6 +361,73 @@ static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(System::Stats::kInetLayer_NumTCPEps, 1));
 }
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+namespace {
+
+// More datagrams than INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE, so that the receive batch has to grow and wrap.
+constexpr size_t kUDPBatchCount = 20;
+size_t sUDPBatchReceived        = 0;
+
+void HandleUDPBatchMessageReceived(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    // Each message carries its own index so reordering or loss can be detected.
+    if (msg->DataLength() == 1 && msg->Start()[0] == sUDPBatchReceived)
+    {
+        sUDPBatchReceived++;
+    }
+}
+
+} // namespace
+
+// Test receiving a burst of datagrams queued on the socket before the endpoint gets to service it.
+static void TestInetUDPReceiveBatch(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress loopback;
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("::1", loopback));
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    CHIP_ERROR err         = gUDP.NewEndPoint(&receiver);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = gUDP.NewEndPoint(&sender);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = receiver->Bind(IPAddressType::kIPv6, loopback, 0);
+    if (err != CHIP_NO_ERROR)
+    {
+        // No IPv6 loopback in this environment.
+        receiver->Free();
+        sender->Free();
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, receiver->Listen(HandleUDPBatchMessageReceived, nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sender->Bind(IPAddressType::kIPv6, loopback, 0) == CHIP_NO_ERROR);
+
+    sUDPBatchReceived = 0;
+    for (size_t i = 0; i < kUDPBatchCount; i++)
+    {
+        IPPacketInfo pktInfo;
+        pktInfo.Clear();
+        pktInfo.DestAddress = loopback;
+        pktInfo.DestPort    = receiver->GetBoundPort();
+
+        const uint8_t index    = static_cast<uint8_t>(i);
+        PacketBufferHandle msg = PacketBufferHandle::NewWithData(&index, sizeof(index));
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, !msg.IsNull());
+        NL_TEST_ASSERT(inSuite, sender->SendMsg(&pktInfo, std::move(msg)) == CHIP_NO_ERROR);
+    }
+
+    for (int i = 0; i < 100 && sUDPBatchReceived < kUDPBatchCount; i++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, sUDPBatchReceived == kUDPBatchCount);
+
+    sender->Free();
+    receiver->Free();
+}
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
@@ -452,6 +519,9 @@ static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPr
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+                                 NL_TEST_DEF("InetEndPoint::TestInetUDPReceiveBatch", TestInetUDPReceiveBatch),
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
 #endif
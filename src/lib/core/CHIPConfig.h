@@ -241,6 +241,24 @@
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 16
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+ *
+ *  @brief
+ *    Number of hash buckets the exchange manager uses to look up the exchange
+ *    context an incoming message belongs to, keyed on session, exchange ID and
+ *    role. Must be a power of two.
+ *
+ *    The default gives one bucket per exchange context. Platforms that allocate
+ *    exchange contexts from the heap, and so may run many more than
+ *    CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS concurrently, should size this for the
+ *    expected number of concurrent exchanges.
+ *
+ */
+#ifndef CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+#define CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS 16
+#endif // CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+
 /**
  *  @def CHIP_CONFIG_MCSP_RECEIVE_TABLE_SIZE
  *
@@ -756,6 +774,22 @@
 #define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+ *
+ * @brief Track in-use local session IDs in a bitmap covering the whole
+ * 16-bit session ID space (8 KiB), so that allocating a session ID scans
+ * 64 IDs at a time instead of probing them one by one.
+ *
+ * This is worthwhile on controllers that keep a large number of concurrent
+ * sessions. When disabled, session ID allocation probes the secure session
+ * table's local session ID index, which costs up to one probe per session
+ * already in the table.
+ */
+#ifndef CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+#define CHIP_CONFIG_SECURE_SESSION_ID_BITMAP 0
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
 /**
  *  @def CHIP_CONFIG_MAX_GROUP_DATA_PEERS
  *
@@ -838,6 +872,7 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_NUM_SUBSCRIPTIONS
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS
+ *      * #CHIP_IM_SERVER_SUBSCRIPTION_PATHS_PER_FABRIC_ON_HEAP
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
@@ -909,15 +944,70 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS (CHIP_IM_MAX_NUM_READS * 9)
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_SUBSCRIPTION_PATHS_PER_FABRIC_ON_HEAP
+ *
+ * @brief When the interaction model pools are allocated on the heap, defines the number of attribute paths, and of event paths,
+ * that subscriptions are guaranteed per fabric. Once subscriptions use more than this number times CHIP_CONFIG_MAX_FABRICS paths,
+ * the subscriptions of the fabrics using more than their share are evicted, as with fixed pools. The number of subscriptions
+ * stays unlimited. 0 leaves the number of paths unlimited as well.
+ */
+#ifndef CHIP_IM_SERVER_SUBSCRIPTION_PATHS_PER_FABRIC_ON_HEAP
+#define CHIP_IM_SERVER_SUBSCRIPTION_PATHS_PER_FABRIC_ON_HEAP 0
+#endif
+
 /**
  * @def CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
  *
  * @brief Defines the maximum number of dirty set, limits the number of attributes being read or subscribed at the same time.
+ *
+ * Each entry takes 24 bytes and lookups are logarithmic in this size, so it can be raised to tens of thousands on devices
+ * with many attributes. When the set is full, dirty paths are merged into cluster or endpoint wildcards, which makes
+ * subscribers receive attributes that did not change. Unused when CHIP_SYSTEM_CONFIG_POOL_USE_HEAP is set, the dirty set then
+ * grows as needed.
  */
 #ifndef CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS
+ *
+ * @brief Defines the number of hash buckets in the reporting engine's index from subscribed and read attribute paths to
+ * ReadHandlers, which lets a dirty attribute visit only the handlers interested in it. Must be a power of two.
+ */
+#ifndef CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS
+#define CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS 32
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE
+ *
+ * @brief Defines the size in bytes of the buffer in which the reporting engine keeps encoded attribute reports while it runs,
+ * so that an attribute reported to several read handlers is read and encoded once. Attributes whose encoding does not fit
+ * are encoded for each read handler. At most 65535, or 0 to leave the cache out.
+ *
+ * Defaults to 0 unless the interaction model pools are allocated on the heap, so that devices built with fixed pools, which
+ * serve few read handlers, do not reserve the buffer.
+ */
+#ifndef CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE 1024
+#else
+#define CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE 0
+#endif
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES
+ *
+ * @brief Defines the maximum number of attribute reports the reporting engine keeps encoded while it runs, see
+ * CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE.
+ */
+#ifndef CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES
+#define CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES 32
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1094,6 +1184,32 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE
+ *
+ * @brief Defines the number of group operational keys kept in memory for inbound group messages
+ *
+ * One entry is used per key of each keyset mapped to a group, across all fabrics. While all
+ * mapped keys fit, the candidate keys for a group session ID are found without reading the
+ * group key map and key sets from persistent storage. Set to 0 to always read them from storage.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE
+#define CHIP_CONFIG_GROUP_SESSION_INDEX_SIZE 32
+#endif
+
+/**
+ * @def CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE
+ *
+ * @brief Defines the number of verified certificate signatures remembered by the fabric table
+ *
+ * Each CASE handshake validates the NOC, and ICAC if any, of the peer. Certificates whose
+ * signature was verified during a recent handshake are not verified again, which saves one
+ * ECDSA verification per certificate when known peers reconnect. Set to 0 to always verify.
+ */
+#ifndef CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE
+#define CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE 16
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1163,6 +1279,40 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_ENTRY_ITERATOR_DELEGATE_POOL_SIZE 1
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE
+ *
+ * Defines the number of recent access control check decisions remembered, keyed by
+ * subject descriptor, endpoint, cluster and privilege. The cache is cleared whenever
+ * the access control list changes. Set to 0 to disable.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE 8
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES
+ *
+ * Defines the number of access control entries that can be copied out of the delegate
+ * for the most recently checked subject, so that checks for that subject over many paths
+ * do not iterate the delegate's entries. Subjects with more applicable entries are
+ * checked against the delegate directly. Set to 0 to disable.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES
+#define CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_TARGETS
+ *
+ * Defines the total number of targets, across all copied entries, that can be copied
+ * out of the delegate for the most recently checked subject.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_TARGETS
+#define CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_TARGETS                                                                            \
+    (CHIP_CONFIG_ACCESS_CONTROL_COMPILED_MAX_ENTRIES * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_TARGETS_PER_ENTRY)
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_FAST_COPY_SUPPORT
  *
@@ -110,6 +110,101 @@ public:
         CHIP_ERROR err = SyncGetKeyValue(key, nullptr, size);
         return (err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_NO_ERROR);
     }
+
+    /**
+     * @brief
+     *   Start a batch of changes.
+     *
+     *   Until the batch ends, implementations that support batches may hold back the changes made by
+     *   SyncSetKeyValue and SyncDeleteKeyValue and make them durable all at once in SyncCommitBatch.
+     *   SyncGetKeyValue returns the values as changed by the batch so far. Batches nest: only ending the
+     *   outermost batch commits or aborts the changes, and aborting a nested batch makes the outermost one
+     *   fail to commit.
+     *
+     *   Implementations without batch support apply every change as it is made, which is what the
+     *   default implementation does. Callers should usually use PersistentStorageBatch instead of calling
+     *   this directly.
+     *
+     * @return CHIP_NO_ERROR if the batch was started, another CHIP_ERROR value from implementation otherwise,
+     *         in which case changes are applied as they are made and the batch must not be ended.
+     */
+    virtual CHIP_ERROR SyncBeginBatch() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   End a batch started by SyncBeginBatch, making the changes of the outermost batch durable together.
+     *
+     * @return CHIP_NO_ERROR on success, or another CHIP_ERROR value from implementation on failure, in which
+     *         case the changes of the batch have been discarded. CHIP_ERROR_PERSISTED_STORAGE_FAILED when
+     *         ending the outermost batch after a nested batch was aborted.
+     */
+    virtual CHIP_ERROR SyncCommitBatch() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   End a batch started by SyncBeginBatch, discarding all changes made since the outermost batch was
+     *   started. For a nested batch, the changes are discarded when the outermost batch ends, however it
+     *   ends. Implementations without batch support have already applied the changes and keep them.
+     */
+    virtual void SyncAbortBatch() {}
+};
+
+/**
+ * Scoped batch of changes to a PersistentStorageDelegate.
+ *
+ * The batch is started on construction and, unless Commit() was called, aborted on destruction, so a
+ * multi-key update that fails half way through does not leave part of its changes in storage on
+ * implementations that support batches.
+ */
+class PersistentStorageBatch
+{
+public:
+    explicit PersistentStorageBatch(PersistentStorageDelegate & storage) : mStorage(storage)
+    {
+        mActive = (mStorage.SyncBeginBatch() == CHIP_NO_ERROR);
+    }
+
+    ~PersistentStorageBatch()
+    {
+        if (mActive)
+        {
+            mStorage.SyncAbortBatch();
+        }
+    }
+
+    /**
+     * Commit the changes made since the batch was started. If the batch could not be started, the changes
+     * have already been applied one by one and this does nothing.
+     */
+    CHIP_ERROR Commit()
+    {
+        if (!mActive)
+        {
+            return CHIP_NO_ERROR;
+        }
+        mActive = false;
+        return mStorage.SyncCommitBatch();
+    }
+
+    /**
+     * Discard the changes made since the batch was started, as destroying the batch would, so that changes
+     * made afterwards are applied on their own. If the batch could not be started, this does nothing.
+     */
+    void Abort()
+    {
+        if (mActive)
+        {
+            mActive = false;
+            mStorage.SyncAbortBatch();
+        }
+    }
+
+    PersistentStorageBatch(const PersistentStorageBatch &)             = delete;
+    PersistentStorageBatch & operator=(const PersistentStorageBatch &) = delete;
+
+private:
+    PersistentStorageDelegate & mStorage;
+    bool mActive;
 };
 
 } // namespace chip
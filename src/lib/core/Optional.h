@@ -96,7 +96,7 @@ public:
         }
     }
 
-    constexpr Optional(Optional && other) : mHasValue(other.mHasValue)
+    constexpr Optional(Optional && other) noexcept(std::is_nothrow_move_constructible<T>::value) : mHasValue(other.mHasValue)
     {
         if (mHasValue)
         {
@@ -120,7 +120,7 @@ public:
         return *this;
     }
 
-    constexpr Optional & operator=(Optional && other)
+    constexpr Optional & operator=(Optional && other) noexcept(std::is_nothrow_move_constructible<T>::value)
     {
         if (mHasValue)
         {
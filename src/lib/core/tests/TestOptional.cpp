@@ -27,6 +27,7 @@
 #include <cinttypes>
 #include <cstdint>
 #include <cstring>
+#include <type_traits>
 
 #include <lib/core/Optional.h>
 #include <lib/support/Span.h>
@@ -76,6 +77,11 @@ public:
 int Count::created;
 int Count::destroyed;
 
+// Moves do not throw unless moving the value may throw.
+static_assert(std::is_nothrow_move_constructible<Optional<uint32_t>>::value, "Optional<uint32_t> moves must not throw");
+static_assert(std::is_nothrow_move_assignable<Optional<uint32_t>>::value, "Optional<uint32_t> moves must not throw");
+static_assert(!std::is_nothrow_move_constructible<Optional<Count>>::value, "Optional<Count> moves may throw");
+
 static void TestBasic(nlTestSuite * inSuite, void * inContext)
 {
     // Set up our test Count objects, which will mess with counts, before we reset the
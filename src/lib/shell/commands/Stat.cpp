@@ -47,6 +47,11 @@ CHIP_ERROR StatPeakHandler(int argc, char ** argv)
         streamer_printf(streamer_get(), "%s: %i\r\n", labels[i], static_cast<int>(watermarks[i]));
     }
 
+    const System::Stats::PacketBufferUsage & packetBufferUsage = System::Stats::GetPacketBufferUsage();
+    streamer_printf(streamer_get(), "Packet buffer bytes: %u\r\n", static_cast<unsigned>(packetBufferUsage.mBytesHighWatermark));
+    streamer_printf(streamer_get(), "Packet buffer clones: %u (%u bytes)\r\n", static_cast<unsigned>(packetBufferUsage.mClones),
+                    static_cast<unsigned>(packetBufferUsage.mClonedBytes));
+
     if (DeviceLayer::GetDiagnosticDataProvider().SupportsWatermarks())
     {
         uint64_t heapWatermark;
@@ -76,6 +81,11 @@ CHIP_ERROR StatResetHandler(int argc, char ** argv)
         watermarks[i] = current[i];
     }
 
+    System::Stats::PacketBufferUsage & packetBufferUsage = System::Stats::GetPacketBufferUsage();
+    packetBufferUsage.mBytesHighWatermark                = packetBufferUsage.mBytesInUse;
+    packetBufferUsage.mClones                            = 0;
+    packetBufferUsage.mClonedBytes                       = 0;
+
     if (DeviceLayer::GetDiagnosticDataProvider().SupportsWatermarks())
     {
         ReturnErrorOnFailure(DeviceLayer::GetDiagnosticDataProvider().ResetWatermarks());
@@ -27,6 +27,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace chip {
@@ -40,6 +41,10 @@ namespace chip {
  * be used in unit tests to make sure a module making use of the PersistentStorageDelegate
  * does not access some particular keys which should remain untouched by underlying
  * logic.
+ *
+ * Batches are supported: aborting the outermost one restores the values the keys had when it
+ * started, aborting a nested one makes committing the outermost one do so and fail, and
+ * GetNumDurableWrites() counts a committed batch as a single write.
  */
 class TestPersistentStorageDelegate : public PersistentStorageDelegate
 {
@@ -87,7 +92,9 @@ public:
                           static_cast<unsigned>(size));
         }
 
+        RememberForBatch(key);
         CHIP_ERROR err = SyncSetKeyValueInternal(key, value, size);
+        CountDurableWrite(err);
 
         if (mLoggingLevel >= LoggingLevel::kLogMutationAndReads)
         {
@@ -107,7 +114,9 @@ public:
         {
             ChipLogDetail(Test, "TestPersistentStorageDelegate::SyncDeleteKeyValue, Delete key '%s'", StringOrNullMarker(key));
         }
+        RememberForBatch(key);
         CHIP_ERROR err = SyncDeleteKeyValueInternal(key);
+        CountDurableWrite(err);
 
         if (mLoggingLevel >= LoggingLevel::kLogMutation)
         {
@@ -126,6 +135,50 @@ public:
         return err;
     }
 
+    CHIP_ERROR SyncBeginBatch() override
+    {
+        mBatchDepth++;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncCommitBatch() override
+    {
+        VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+        mBatchDepth--;
+        VerifyOrReturnError(mBatchDepth == 0, CHIP_NO_ERROR);
+        if (mBatchFailed)
+        {
+            // A nested batch was aborted, which aborts the whole batch.
+            RollBackBatch();
+            return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+        }
+        if (!mBatchUndo.empty())
+        {
+            mBatchUndo.clear();
+            mNumDurableWrites++;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    void SyncAbortBatch() override
+    {
+        VerifyOrReturn(mBatchDepth > 0);
+        mBatchDepth--;
+        if (mBatchDepth > 0)
+        {
+            // The changes stay visible until the outermost batch ends, which then discards them.
+            mBatchFailed = true;
+            return;
+        }
+        RollBackBatch();
+    }
+
+    /**
+     * @return the number of times storage was written durably: once for every successful change made
+     *         outside of a batch, and once for every committed batch that changed something.
+     */
+    virtual size_t GetNumDurableWrites() { return mNumDurableWrites; }
+
     /**
      * @brief Adds a "poison key": a key that, if read/written, implies some bad
      *        behavior occurred.
@@ -141,10 +194,15 @@ public:
     virtual void ClearPoisonKeys() { mPoisonKeys.clear(); }
 
     /**
-     * @brief Reset entire contents back to empty. This does NOT clear the "poison keys"
+     * @brief Reset entire contents back to empty, along with the count of durable writes. This does NOT clear
+     *        the "poison keys"
      *
      */
-    virtual void ClearStorage() { mStorage.clear(); }
+    virtual void ClearStorage()
+    {
+        mStorage.clear();
+        mNumDurableWrites = 0;
+    }
 
     /**
      * @return the number of keys currently written in storage
@@ -271,9 +329,58 @@ protected:
         return CHIP_NO_ERROR;
     }
 
+    void RememberForBatch(const char * key)
+    {
+        if (mBatchDepth == 0 || mBatchUndo.find(key) != mBatchUndo.end())
+        {
+            return;
+        }
+
+        auto it = mStorage.find(key);
+        if (it != mStorage.end())
+        {
+            mBatchUndo[key] = std::make_pair(true, it->second);
+        }
+        else
+        {
+            mBatchUndo[key] = std::make_pair(false, std::vector<uint8_t>());
+        }
+    }
+
+    void RollBackBatch()
+    {
+        for (auto & undo : mBatchUndo)
+        {
+            if (undo.second.first)
+            {
+                mStorage[undo.first] = std::move(undo.second.second);
+            }
+            else
+            {
+                mStorage.erase(undo.first);
+            }
+        }
+        mBatchUndo.clear();
+        mBatchFailed = false;
+    }
+
+    void CountDurableWrite(CHIP_ERROR err)
+    {
+        if (mBatchDepth == 0 && err == CHIP_NO_ERROR)
+        {
+            mNumDurableWrites++;
+        }
+    }
+
     std::map<std::string, std::vector<uint8_t>> mStorage;
     std::set<std::string> mPoisonKeys;
     LoggingLevel mLoggingLevel = LoggingLevel::kDisabled;
+
+    // Values keys had before the open batch first changed them, and whether they existed at all.
+    std::map<std::string, std::pair<bool, std::vector<uint8_t>>> mBatchUndo;
+    unsigned mBatchDepth     = 0;
+    bool mBatchFailed        = false; // A nested batch was aborted
+    size_t mNumDurableWrites = 0;
 };
 
 } // namespace chip
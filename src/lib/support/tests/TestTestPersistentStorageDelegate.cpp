@@ -341,9 +341,137 @@ void TestClearStorage(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, size == sizeof(buf));
 }
 
+// A delegate that only implements the mandatory methods, to check the fallback of batches.
+class NoBatchStorageDelegate : public PersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        return mStorage.SyncGetKeyValue(key, buffer, size);
+    }
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        return mStorage.SyncSetKeyValue(key, value, size);
+    }
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override { return mStorage.SyncDeleteKeyValue(key); }
+
+    TestPersistentStorageDelegate mStorage;
+};
+
+void TestBatches(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("kept", "1", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("changed", "2", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 2);
+
+    // A committed batch is a single write, whatever it contains.
+    {
+        PersistentStorageBatch batch(storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("changed", "3", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("added", "4", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("kept") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.SyncDoesKeyExist("kept"));
+        NL_TEST_ASSERT(inSuite, batch.Commit() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 3);
+    NL_TEST_ASSERT(inSuite, storage.GetKeys() == std::set<std::string>({ "added", "changed" }));
+
+    // Nested batches commit with the outermost one.
+    {
+        PersistentStorageBatch outer(storage);
+        {
+            PersistentStorageBatch inner(storage);
+            NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("nested", "5", 1) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, inner.Commit() == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 3);
+        NL_TEST_ASSERT(inSuite, outer.Commit() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 4);
+
+    // A batch that goes out of scope without being committed leaves storage as it was.
+    {
+        PersistentStorageBatch batch(storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("changed", "6", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("aborted", "7", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("nested") == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 4);
+    NL_TEST_ASSERT(inSuite, storage.GetKeys() == std::set<std::string>({ "added", "changed", "nested" }));
+
+    char value;
+    uint16_t size = sizeof(value);
+    NL_TEST_ASSERT(inSuite, storage.SyncGetKeyValue("changed", &value, size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, size == 1 && value == '3');
+
+    // Aborting a nested batch aborts the outermost one: committing it fails and discards all changes,
+    // including the ones made before and after the nested batch.
+    {
+        PersistentStorageBatch outer(storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("changed", "8", 1) == CHIP_NO_ERROR);
+        {
+            PersistentStorageBatch inner(storage);
+            NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("inner", "9", 1) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("after", "A", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, outer.Commit() == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 4);
+    NL_TEST_ASSERT(inSuite, storage.GetKeys() == std::set<std::string>({ "added", "changed", "nested" }));
+    size = sizeof(value);
+    NL_TEST_ASSERT(inSuite, storage.SyncGetKeyValue("changed", &value, size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, size == 1 && value == '3');
+
+    // Aborting both discards the changes the same way, and the next batch starts afresh.
+    {
+        PersistentStorageBatch outer(storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("changed", "B", 1) == CHIP_NO_ERROR);
+        {
+            PersistentStorageBatch inner(storage);
+            NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("added") == CHIP_NO_ERROR);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetKeys() == std::set<std::string>({ "added", "changed", "nested" }));
+    {
+        PersistentStorageBatch batch(storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("changed", "C", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, batch.Commit() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 5);
+    size = sizeof(value);
+    NL_TEST_ASSERT(inSuite, storage.SyncGetKeyValue("changed", &value, size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, size == 1 && value == 'C');
+
+    // An explicitly aborted batch discards its changes, and later changes apply on their own.
+    {
+        PersistentStorageBatch batch(storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("changed", "D", 1) == CHIP_NO_ERROR);
+        batch.Abort();
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("unbatched", "E", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 6);
+        NL_TEST_ASSERT(inSuite, batch.Commit() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumDurableWrites() == 6);
+    NL_TEST_ASSERT(inSuite, storage.SyncDoesKeyExist("unbatched"));
+    size = sizeof(value);
+    NL_TEST_ASSERT(inSuite, storage.SyncGetKeyValue("changed", &value, size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, size == 1 && value == 'C');
+
+    // Without batch support, changes apply as they are made and stay when the batch is aborted.
+    NoBatchStorageDelegate noBatchStorage;
+    {
+        PersistentStorageBatch batch(noBatchStorage);
+        NL_TEST_ASSERT(inSuite, noBatchStorage.SyncSetKeyValue("a", "1", 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, noBatchStorage.mStorage.GetNumDurableWrites() == 1);
+    }
+    NL_TEST_ASSERT(inSuite, noBatchStorage.SyncDoesKeyExist("a"));
+}
+
 const nlTest sTests[] = { NL_TEST_DEF("Test basic API", TestBasicApi),
                           NL_TEST_DEF("Test ClearStorage method of TestPersistentStorageDelegate", TestClearStorage),
-                          NL_TEST_SENTINEL() };
+                          NL_TEST_DEF("Test batches of changes", TestBatches), NL_TEST_SENTINEL() };
 
 } // namespace
 
@@ -256,6 +256,11 @@ private:
     ExchangeSessionHolder mSession; // The connection state
     uint16_t mExchangeId;           // Assigned exchange ID.
 
+    // Chains this exchange into its ExchangeManager's lookup index. The bucket is computed once, from the
+    // session the exchange was created on, since an exchange never moves to a different session.
+    ExchangeContext * mNextInIndex = nullptr;
+    size_t mIndexBucket            = 0;
+
     /**
      *  Track whether we are now expecting a response to a message sent via this exchange (because that
      *  message had the kExpectResponse flag set in its sendFlags).
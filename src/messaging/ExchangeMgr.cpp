@@ -115,7 +115,71 @@ ExchangeContext * ExchangeManager::NewContext(const SessionHandle & session, Exc
         ChipLogError(ExchangeManager, "NewContext failed: session inactive");
         return nullptr;
     }
-    return mContextPool.CreateObject(this, mNextExchangeId++, session, isInitiator, delegate);
+    return AllocContext(mNextExchangeId++, session, isInitiator, delegate);
+}
+
+void ExchangeManager::ReleaseContext(ExchangeContext * ec)
+{
+    RemoveFromIndex(ec);
+    mContextPool.ReleaseObject(ec);
+}
+
+ExchangeContext * ExchangeManager::AllocContext(uint16_t exchangeId, const SessionHandle & session, bool isInitiator,
+                                                ExchangeDelegate * delegate, bool isEphemeralExchange)
+{
+    ExchangeContext * ec = mContextPool.CreateObject(this, exchangeId, session, isInitiator, delegate, isEphemeralExchange);
+    if (ec != nullptr)
+    {
+        AddToIndex(ec, session);
+    }
+    return ec;
+}
+
+ExchangeContext * ExchangeManager::FindContext(const SessionHandle & session, const PacketHeader & packetHeader,
+                                               const PayloadHeader & payloadHeader)
+{
+    // A message sent by an initiator belongs to a responder exchange, and vice versa.
+    size_t bucket = IndexBucket(session.operator->(), payloadHeader.GetExchangeID(), !payloadHeader.IsInitiator());
+
+    for (ExchangeContext * ec = mExchangeIndex[bucket]; ec != nullptr; ec = ec->mNextInIndex)
+    {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            return ec;
+        }
+    }
+
+    return nullptr;
+}
+
+size_t ExchangeManager::IndexBucket(const Transport::Session * session, uint16_t exchangeId, bool isInitiator)
+{
+    // Drop the pointer's alignment bits, which carry no information, before mixing.
+    uint32_t hash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(session) >> 3);
+    hash ^= (static_cast<uint32_t>(exchangeId) << 1) | (isInitiator ? 1u : 0u);
+    hash *= 0x9E3779B1u;
+    hash ^= hash >> 16;
+    return hash & (kExchangeIndexBuckets - 1);
+}
+
+void ExchangeManager::AddToIndex(ExchangeContext * ec, const SessionHandle & session)
+{
+    ec->mIndexBucket                 = IndexBucket(session.operator->(), ec->GetExchangeId(), ec->IsInitiator());
+    ec->mNextInIndex                 = mExchangeIndex[ec->mIndexBucket];
+    mExchangeIndex[ec->mIndexBucket] = ec;
+}
+
+void ExchangeManager::RemoveFromIndex(ExchangeContext * ec)
+{
+    for (ExchangeContext ** link = &mExchangeIndex[ec->mIndexBucket]; *link != nullptr; link = &(*link)->mNextInIndex)
+    {
+        if (*link == ec)
+        {
+            *link            = ec->mNextInIndex;
+            ec->mNextInIndex = nullptr;
+            return;
+        }
+    }
 }
 
 CHIP_ERROR ExchangeManager::RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId,
@@ -238,23 +302,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindContext(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -329,7 +384,7 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
             return;
         }
 
-        ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, false, delegate);
+        ExchangeContext * ec = AllocContext(payloadHeader.GetExchangeID(), session, false, delegate);
 
         if (ec == nullptr)
         {
@@ -381,8 +436,8 @@ void ExchangeManager::SendStandaloneAckIfNeeded(const PacketHeader & packetHeade
     // If rcvd msg is from initiator then this exchange is created as not Initiator.
     // If rcvd msg is not from initiator then this exchange is created as Initiator.
     // Create a EphemeralExchange to generate a StandaloneAck
-    ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(),
-                                                     nullptr, true /* IsEphemeralExchange */);
+    ExchangeContext * ec =
+        AllocContext(payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(), nullptr, true /* IsEphemeralExchange */);
 
     if (ec == nullptr)
     {
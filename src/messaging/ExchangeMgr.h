@@ -100,7 +100,7 @@ public:
      */
     ExchangeContext * NewContext(const SessionHandle & session, ExchangeDelegate * delegate, bool isInitiator = true);
 
-    void ReleaseContext(ExchangeContext * ec) { mContextPool.ReleaseObject(ec); }
+    void ReleaseContext(ExchangeContext * ec);
 
     /**
      *  Register an unsolicited message handler for a given protocol identifier. This handler would be
@@ -230,11 +230,28 @@ private:
 
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
 
+    static constexpr size_t kExchangeIndexBuckets = CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS;
+    static_assert(kExchangeIndexBuckets > 0 && (kExchangeIndexBuckets & (kExchangeIndexBuckets - 1)) == 0,
+                  "CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS must be a power of two");
+
+    // Hash index over the active exchanges, keyed on (session, exchange ID, role), so that matching an
+    // incoming message to its exchange does not have to walk every active exchange. Each bucket is a
+    // chain linked through ExchangeContext::mNextInIndex.
+    ExchangeContext * mExchangeIndex[kExchangeIndexBuckets] = {};
+
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
 
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
 
+    ExchangeContext * AllocContext(uint16_t exchangeId, const SessionHandle & session, bool isInitiator,
+                                   ExchangeDelegate * delegate, bool isEphemeralExchange = false);
+    ExchangeContext * FindContext(const SessionHandle & session, const PacketHeader & packetHeader,
+                                  const PayloadHeader & payloadHeader);
+    static size_t IndexBucket(const Transport::Session * session, uint16_t exchangeId, bool isInitiator);
+    void AddToIndex(ExchangeContext * ec, const SessionHandle & session);
+    void RemoveFromIndex(ExchangeContext * ec);
+
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
 
@@ -21,11 +21,13 @@
  *
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <inttypes.h>
 
 #include <lib/support/BitFlags.h>
 #include <lib/support/CHIPFaultInjection.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <messaging/ErrorCategory.h>
@@ -46,13 +48,12 @@ using namespace chip::System::Clock::Literals;
 namespace chip {
 namespace Messaging {
 
-ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
-    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
+RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) : ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
 {
     ec->SetWaitingForAck(true);
 }
 
-ReliableMessageMgr::RetransTableEntry::~RetransTableEntry()
+RetransTableEntry::~RetransTableEntry()
 {
     ec->SetWaitingForAck(false);
 }
@@ -61,7 +62,12 @@ ReliableMessageMgr::ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_M
     mContextPool(contextPool), mSystemLayer(nullptr)
 {}
 
-ReliableMessageMgr::~ReliableMessageMgr() {}
+ReliableMessageMgr::~ReliableMessageMgr()
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    Platform::MemoryFree(mSchedule);
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+}
 
 void ReliableMessageMgr::Init(chip::System::Layer * systemLayer)
 {
@@ -74,7 +80,7 @@ void ReliableMessageMgr::Shutdown()
 
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        mRetransTable.ReleaseObject(entry);
+        ReleaseEntry(*entry);
         return Loop::Continue;
     });
 
@@ -118,10 +124,11 @@ void ReliableMessageMgr::ExecuteActions()
         }
     });
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime > now)
-            return Loop::Continue;
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired.  The schedule is
+    // re-examined after each entry, since handling one entry can reschedule or release others.
+    while (mScheduleSize > 0 && mSchedule[0]->nextRetransTime <= now)
+    {
+        RetransTableEntry * entry = mSchedule[0];
 
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
@@ -157,9 +164,9 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
+            ReleaseEntry(*entry);
 
-            return Loop::Continue;
+            continue;
         }
 
         entry->sendCount++;
@@ -169,10 +176,9 @@ void ReliableMessageMgr::ExecuteActions()
                         messageCounter, ChipLogValueExchange(&entry->ec.Get()), entry->sendCount);
 
         CalculateNextRetransTime(*entry);
+        Schedule(*entry);
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -199,12 +205,19 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
     VerifyOrDie(!rc->IsWaitingForAck());
 
     *rEntry = mRetransTable.CreateObject(rc);
-    if (*rEntry == nullptr)
+    if (*rEntry == nullptr || ReserveSchedule(mRetransTable.Allocated()) != CHIP_NO_ERROR)
     {
+        if (*rEntry != nullptr)
+        {
+            mRetransTable.ReleaseObject(*rEntry);
+            *rEntry = nullptr;
+        }
         ChipLogError(ExchangeManager, "mRetransTable Already Full");
         return CHIP_ERROR_RETRANS_TABLE_FULL;
     }
 
+    rc->mRetransEntry = *rEntry;
+
     return CHIP_NO_ERROR;
 }
 
@@ -270,29 +283,27 @@ System::Clock::Timestamp ReliableMessageMgr::GetBackoff(System::Clock::Timestamp
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
     CalculateNextRetransTime(*entry);
+    Schedule(*entry);
     StartTimer();
 }
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMessageCounter)
 {
-    bool removed = false;
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
-        {
-            // Clear the entry from the retransmision table.
-            ClearRetransTable(*entry);
-
-            ChipLogDetail(ExchangeManager,
-                          "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
-                          " from Retrans Table on exchange " ChipLogFormatExchange,
-                          ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
-            removed = true;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    // A context has at most one message awaiting an ack, so the context itself indexes its entry.
+    RetransTableEntry * entry = rc->mRetransEntry;
+    if (entry == nullptr || entry->retainedBuf.GetMessageCounter() != ackMessageCounter)
+    {
+        return false;
+    }
+
+    // Clear the entry from the retransmision table.
+    ClearRetransTable(*entry);
 
-    return removed;
+    ChipLogDetail(ExchangeManager,
+                  "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
+                  " from Retrans Table on exchange " ChipLogFormatExchange,
+                  ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
+    return true;
 }
 
 CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
@@ -351,23 +362,129 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc)
-        {
-            ClearRetransTable(*entry);
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    if (rc->mRetransEntry != nullptr)
+    {
+        ClearRetransTable(*rc->mRetransEntry);
+    }
 }
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseEntry(entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
 
+void ReliableMessageMgr::ReleaseEntry(RetransTableEntry & entry)
+{
+    Unschedule(entry);
+
+    ReliableMessageContext * rc = entry.ec->GetReliableMessageContext();
+    if (rc->mRetransEntry == &entry)
+    {
+        rc->mRetransEntry = nullptr;
+    }
+
+    mRetransTable.ReleaseObject(&entry);
+}
+
+CHIP_ERROR ReliableMessageMgr::ReserveSchedule(size_t count)
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (count > mScheduleCapacity)
+    {
+        size_t capacity = (mScheduleCapacity == 0) ? CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE : mScheduleCapacity * 2;
+        capacity        = std::max(capacity, count);
+
+        auto ** schedule = static_cast<RetransTableEntry **>(Platform::MemoryRealloc(mSchedule, capacity * sizeof(*mSchedule)));
+        VerifyOrReturnError(schedule != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        mSchedule         = schedule;
+        mScheduleCapacity = capacity;
+    }
+    return CHIP_NO_ERROR;
+#else
+    return (count <= ArraySize(mSchedule)) ? CHIP_NO_ERROR : CHIP_ERROR_NO_MEMORY;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+}
+
+void ReliableMessageMgr::Schedule(RetransTableEntry & entry)
+{
+    if (entry.scheduleIndex == RetransTableEntry::kNotScheduled)
+    {
+        // ReserveSchedule in AddToRetransTable guarantees there is room for every entry in the table.
+        PlaceInSchedule(mScheduleSize++, &entry);
+    }
+
+    // The retransmission time may have moved in either direction.
+    SiftUp(entry.scheduleIndex);
+    SiftDown(entry.scheduleIndex);
+}
+
+void ReliableMessageMgr::Unschedule(RetransTableEntry & entry)
+{
+    size_t index = entry.scheduleIndex;
+    VerifyOrReturn(index != RetransTableEntry::kNotScheduled);
+
+    entry.scheduleIndex = RetransTableEntry::kNotScheduled;
+    mScheduleSize--;
+
+    if (index != mScheduleSize)
+    {
+        // Fill the hole with the last entry and restore the heap order around it.
+        RetransTableEntry * moved = mSchedule[mScheduleSize];
+        PlaceInSchedule(index, moved);
+        SiftUp(moved->scheduleIndex);
+        SiftDown(moved->scheduleIndex);
+    }
+}
+
+void ReliableMessageMgr::SiftUp(size_t index)
+{
+    RetransTableEntry * entry = mSchedule[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (mSchedule[parent]->nextRetransTime <= entry->nextRetransTime)
+        {
+            break;
+        }
+        PlaceInSchedule(index, mSchedule[parent]);
+        index = parent;
+    }
+    PlaceInSchedule(index, entry);
+}
+
+void ReliableMessageMgr::SiftDown(size_t index)
+{
+    RetransTableEntry * entry = mSchedule[index];
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= mScheduleSize)
+        {
+            break;
+        }
+        if (child + 1 < mScheduleSize && mSchedule[child + 1]->nextRetransTime < mSchedule[child]->nextRetransTime)
+        {
+            child++;
+        }
+        if (entry->nextRetransTime <= mSchedule[child]->nextRetransTime)
+        {
+            break;
+        }
+        PlaceInSchedule(index, mSchedule[child]);
+        index = child;
+    }
+    PlaceInSchedule(index, entry);
+}
+
+void ReliableMessageMgr::PlaceInSchedule(size_t index, RetransTableEntry * entry)
+{
+    mSchedule[index]     = entry;
+    entry->scheduleIndex = index;
+}
+
 void ReliableMessageMgr::StartTimer()
 {
     // When do we need to next wake up to send an ACK?
@@ -381,13 +498,10 @@ void ReliableMessageMgr::StartTimer()
     });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    if (mScheduleSize > 0 && mSchedule[0]->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = mSchedule[0]->nextRetransTime;
+    }
 
     StopTimer();
 
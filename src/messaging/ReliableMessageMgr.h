@@ -42,30 +42,35 @@ namespace Messaging {
 enum class SendMessageFlags : uint16_t;
 class ReliableMessageContext;
 
+/**
+ *  @class RetransTableEntry
+ *
+ *  @brief
+ *    This class is part of the CHIP Reliable Messaging Protocol and is used
+ *    to keep track of CHIP messages that have been sent and are expecting an
+ *    acknowledgment back. If the acknowledgment is not received within a
+ *    specific timeout, the message would be retransmitted from this table.
+ *
+ */
+struct RetransTableEntry
+{
+    RetransTableEntry(ReliableMessageContext * rc);
+    ~RetransTableEntry();
+
+    static constexpr size_t kNotScheduled = SIZE_MAX;
+
+    ExchangeHandle ec;                        /**< The context for the stored CHIP message. */
+    EncryptedPacketBufferHandle retainedBuf;  /**< The packet buffer holding the CHIP message. */
+    System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
+    size_t scheduleIndex = kNotScheduled;     /**< Position in the retransmission schedule, or kNotScheduled. */
+    uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
+                                                   including both successfully and failure send. */
+};
+
 class ReliableMessageMgr
 {
 public:
-    /**
-     *  @class RetransTableEntry
-     *
-     *  @brief
-     *    This class is part of the CHIP Reliable Messaging Protocol and is used
-     *    to keep track of CHIP messages that have been sent and are expecting an
-     *    acknowledgment back. If the acknowledgment is not received within a
-     *    specific timeout, the message would be retransmitted from this table.
-     *
-     */
-    struct RetransTableEntry
-    {
-        RetransTableEntry(ReliableMessageContext * rc);
-        ~RetransTableEntry();
-
-        ExchangeHandle ec;                        /**< The context for the stored CHIP message. */
-        EncryptedPacketBufferHandle retainedBuf;  /**< The packet buffer holding the CHIP message. */
-        System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
-        uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
-                                                       including both successfully and failure send. */
-    };
+    using RetransTableEntry = Messaging::RetransTableEntry;
 
     ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
     ~ReliableMessageMgr();
@@ -124,8 +129,7 @@ public:
     void StartRetransmision(RetransTableEntry * entry);
 
     /**
-     *  Iterate through active exchange contexts and retrans table entries. Clear the entry matching
-     *  the specified ExchangeContext and the message ID from the retransmision table.
+     *  Clear the entry matching the specified ExchangeContext and the message ID from the retransmision table.
      *
      *  @param[in]    rc                 A pointer to the ExchangeContext object.
      *  @param[in]    ackMessageCounter  The acknowledged message counter of the received packet.
@@ -160,7 +164,7 @@ public:
     void ClearRetransTable(RetransTableEntry & rEntry);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
+     * Iterate through active exchange contexts and check the earliest scheduled retransmission.
      * Determine how many ReliableMessageProtocol ticks we need to sleep before we
      * need to physically wake the CPU to perform an action.  Set a timer to go off
      * when we next need to wake the system.
@@ -214,6 +218,21 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
+    /**
+     * Release an entry, removing it from the retransmission schedule and from its context.
+     */
+    void ReleaseEntry(RetransTableEntry & entry);
+
+    // The retransmission schedule is a binary min-heap of the entries that have been handed to
+    // StartRetransmision, ordered by nextRetransTime.  Each entry records its own position so that it
+    // can be rescheduled or removed in O(log n) when it is retransmitted or acknowledged.
+    CHIP_ERROR ReserveSchedule(size_t count);
+    void Schedule(RetransTableEntry & entry);
+    void Unschedule(RetransTableEntry & entry);
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+    void PlaceInSchedule(size_t index, RetransTableEntry * entry);
+
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
 
@@ -232,6 +251,14 @@ private:
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    RetransTableEntry ** mSchedule = nullptr;
+    size_t mScheduleCapacity       = 0;
+#else
+    RetransTableEntry * mSchedule[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE];
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    size_t mScheduleSize = 0;
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 };
 
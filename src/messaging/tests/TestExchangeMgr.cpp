@@ -99,6 +99,45 @@ class ExpireSessionFromTimeoutDelegate : public WaitForTimeoutDelegate
     }
 };
 
+class EchoDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ++mEchoCount;
+        return ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                               SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    int mEchoCount = 0;
+};
+
+class RecordingDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ++mReceivedCount;
+        mLastExchange = ec;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    int mReceivedCount              = 0;
+    ExchangeContext * mLastExchange = nullptr;
+};
+
 void CheckNewContextTest(nlTestSuite * inSuite, void * inContext)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
@@ -261,6 +300,51 @@ void CheckExchangeMessages(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+void CheckExchangeMatching(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // Both ends of the loopback share one exchange manager, so each echoed exchange below has a
+    // responder twin with the same exchange ID on the peer session.  Responses must only reach the
+    // initiator exchange they belong to.
+    constexpr int kNumExchanges = 4;
+
+    EchoDelegate echoDelegate;
+    CHIP_ERROR err =
+        ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &echoDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    RecordingDelegate initiatorDelegates[kNumExchanges];
+    ExchangeContext * initiators[kNumExchanges];
+    for (int i = 0; i < kNumExchanges; i++)
+    {
+        initiators[i] = ctx.NewExchangeToBob(&initiatorDelegates[i]);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, initiators[i] != nullptr);
+    }
+
+    for (auto * ec : initiators)
+    {
+        err = ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                              SendFlags(Messaging::SendMessageFlags::kExpectResponse)
+                                  .Set(Messaging::SendMessageFlags::kNoAutoRequestAck));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, echoDelegate.mEchoCount == kNumExchanges);
+    for (int i = 0; i < kNumExchanges; i++)
+    {
+        NL_TEST_ASSERT(inSuite, initiatorDelegates[i].mReceivedCount == 1);
+        NL_TEST_ASSERT(inSuite, initiatorDelegates[i].mLastExchange == initiators[i]);
+    }
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
 // Test Suite
 
 /**
@@ -272,6 +356,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test ExchangeMgr::NewContext",               CheckNewContextTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckUmhRegistrationTest", CheckUmhRegistrationTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMessages",    CheckExchangeMessages),
+    NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMatching",    CheckExchangeMatching),
     NL_TEST_DEF("Test OnConnectionExpired basics",            CheckSessionExpirationBasics),
     NL_TEST_DEF("Test OnConnectionExpired timeout handling",  CheckSessionExpirationTimeout),
     NL_TEST_DEF("Test session eviction in timeout handling",  CheckSessionExpirationDuringTimeout),
@@ -317,6 +317,7 @@ class TestReliableMessageProtocol
 {
 public:
     static void CheckAddClearRetrans(nlTestSuite * inSuite, void * inContext);
+    static void CheckRetransScheduleAcrossExchanges(nlTestSuite * inSuite, void * inContext);
     static void CheckResendApplicationMessage(nlTestSuite * inSuite, void * inContext);
     static void CheckCloseExchangeAndResendApplicationMessage(nlTestSuite * inSuite, void * inContext);
     static void CheckFailedMessageRetainOnSend(nlTestSuite * inSuite, void * inContext);
@@ -362,6 +363,79 @@ void TestReliableMessageProtocol::CheckAddClearRetrans(nlTestSuite * inSuite, vo
     exchange->Close();
 }
 
+void TestReliableMessageProtocol::CheckRetransScheduleAcrossExchanges(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr size_t kNumExchanges = 3;
+
+    MockAppDelegate mockSender(ctx);
+    ExchangeContext * exchanges[kNumExchanges];
+    for (auto *& exchange : exchanges)
+    {
+        exchange = ctx.NewExchangeToAlice(&mockSender);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, exchange != nullptr);
+    }
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    exchanges[0]->GetSessionHandle()->AsSecureSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        System::Clock::Timestamp(300), // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        System::Clock::Timestamp(300), // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+
+    // Drop the initial message on every exchange, so that each one has an entry in the retransmit table.
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = kNumExchanges;
+    loopback.mDroppedMessageCount = 0;
+
+    for (auto * exchange : exchanges)
+    {
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+        CHIP_ERROR err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer), SendMessageFlags::kExpectResponse);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == kNumExchanges);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kNumExchanges));
+
+    // Acknowledge the middle exchange's message.  An ack with the wrong counter must not match.
+    uint32_t messageCounter = 0;
+    rm->EnumerateRetransTable([&](auto * entry) {
+        if (&entry->ec.Get() == exchanges[1])
+        {
+            messageCounter = entry->retainedBuf.GetMessageCounter();
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+
+    ReliableMessageContext * rc = exchanges[1]->GetReliableMessageContext();
+    NL_TEST_ASSERT(inSuite, !rm->CheckAndRemRetransTable(rc, messageCounter + 1));
+    NL_TEST_ASSERT(inSuite, rm->CheckAndRemRetransTable(rc, messageCounter));
+    NL_TEST_ASSERT(inSuite, !rm->CheckAndRemRetransTable(rc, messageCounter));
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kNumExchanges - 1));
+
+    // The remaining messages are still scheduled, and get through on their first retransmission.
+    ctx.GetIOContext().DriveIOUntil(1000_ms32 + retryBoosterTimeout, [&] { return rm->TestGetCountRetransTable() == 0; });
+    ctx.DrainAndServiceIO();
+
+    // Initial sends, the two retransmissions and the peer's acks for them.
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount >= 2 * kNumExchanges - 1);
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == kNumExchanges);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    for (auto * exchange : exchanges)
+    {
+        exchange->Close();
+    }
+}
+
 /**
  * Tests MRP retransmission logic with the following scenario:
  *
@@ -2161,6 +2235,8 @@ void TestReliableMessageProtocol::CheckApplicationResponseNeverComes(nlTestSuite
 
 const nlTest sTests[] = {
     NL_TEST_DEF("Test ReliableMessageMgr::CheckAddClearRetrans", TestReliableMessageProtocol::CheckAddClearRetrans),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckRetransScheduleAcrossExchanges",
+                TestReliableMessageProtocol::CheckRetransScheduleAcrossExchanges),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckResendApplicationMessage",
                 TestReliableMessageProtocol::CheckResendApplicationMessage),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckCloseExchangeAndResendApplicationMessage",
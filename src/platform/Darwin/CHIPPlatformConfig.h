@@ -57,6 +57,14 @@ extern "C" int __cxa_atexit(void (*f)(void *), void * p, void * d);
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 8
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+#ifndef CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+#define CHIP_CONFIG_SECURE_SESSION_ID_BITMAP 1
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
+#ifndef CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+#define CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS 1024
+#endif // CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+
 #ifndef CHIP_LOG_FILTERING
 #define CHIP_LOG_FILTERING 1
 #endif // CHIP_LOG_FILTERING
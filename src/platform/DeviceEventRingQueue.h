@@ -0,0 +1,181 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares a lock-free CHIP device event queue for many producer threads and a single
+ *      consumer thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+#include <lib/core/CHIPCore.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/CHIPDeviceEvent.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ *  @class DeviceEventRingQueue
+ *
+ *  @brief
+ *      A fixed size ring of events that any number of threads may push to while a single thread pops from
+ *      it, without taking a lock.
+ *
+ *      Each slot carries a sequence number telling whether it is free for the push at a given position or
+ *      holds the event for the pop at that position. Producers claim a position with a compare-and-swap
+ *      and publish the event by advancing the slot's sequence number, so a pop never sees a partially
+ *      written event. A pop stops at the first slot that is claimed but not yet published; its producer
+ *      is expected to wake the consumer again once it has published.
+ *
+ *      Events pushed while the ring is full go to an overflow list on the heap, under a lock, so pushing
+ *      never fails. Each overflow event records how many ring positions were claimed before it and is
+ *      popped only once all of those were, so the events of a thread are popped in the order it pushed
+ *      them.
+ */
+template <size_t kCapacity>
+class DeviceEventRingQueue
+{
+public:
+    static_assert(kCapacity > 1, "A full slot must be distinguishable from a free one");
+
+    DeviceEventRingQueue()
+    {
+        for (size_t i = 0; i < kCapacity; i++)
+        {
+            mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Append the event to the queue. May be called from any thread.
+     */
+    void Push(const ChipDeviceEvent & event)
+    {
+        // Once an event went to the overflow list, later ones follow it there until it is popped.
+        if (mOverflowCount.load(std::memory_order_acquire) == 0 && PushToRing(event))
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mOverflowLock);
+        mOverflowCount.fetch_add(1, std::memory_order_acq_rel);
+        mOverflow.emplace_back(mPushPosition.load(std::memory_order_acquire), event);
+    }
+
+    /**
+     * Remove the oldest published event from the queue. Must only be called from the consumer thread.
+     *
+     * @return false if there is no event to pop.
+     */
+    bool Pop(ChipDeviceEvent & event)
+    {
+        if (PopFromRing(event))
+        {
+            return true;
+        }
+        VerifyOrReturnValue(mOverflowCount.load(std::memory_order_acquire) != 0, false);
+
+        std::lock_guard<std::mutex> lock(mOverflowLock);
+        // An event pushed to the ring before the oldest overflow event is not published yet.
+        VerifyOrReturnValue(!mOverflow.empty() && mOverflow.front().first <= mPopPosition, false);
+        event = mOverflow.front().second;
+        mOverflow.pop_front();
+        mOverflowCount.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> mSequence;
+        ChipDeviceEvent mEvent;
+    };
+
+    bool PushToRing(const ChipDeviceEvent & event)
+    {
+        size_t position = mPushPosition.load(std::memory_order_relaxed);
+        Slot * slot;
+        while (true)
+        {
+            slot            = &mSlots[position % kCapacity];
+            size_t sequence = slot->mSequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (mPushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (sequence < position)
+            {
+                // The slot still holds the event pushed one lap ago.
+                return false;
+            }
+            else
+            {
+                position = mPushPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->mEvent = event;
+        slot->mSequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool PopFromRing(ChipDeviceEvent & event)
+    {
+        Slot & slot = mSlots[mPopPosition % kCapacity];
+        if (slot.mSequence.load(std::memory_order_acquire) != mPopPosition + 1)
+        {
+            return false;
+        }
+
+        event = slot.mEvent;
+        slot.mSequence.store(mPopPosition + kCapacity, std::memory_order_release);
+        mPopPosition++;
+        return true;
+    }
+
+    Slot mSlots[kCapacity];
+
+    // Producers and the consumer update these concurrently, keep them on separate cache lines.
+    alignas(64) std::atomic<size_t> mPushPosition{ 0 };
+    alignas(64) size_t mPopPosition = 0;
+
+    // Events that did not fit in the ring, with the ring push position they were pushed at.
+    std::atomic<size_t> mOverflowCount{ 0 };
+    std::mutex mOverflowLock;
+    std::deque<std::pair<size_t, ChipDeviceEvent>> mOverflow;
+
+    DeviceEventRingQueue(const DeviceEventRingQueue &)             = delete;
+    DeviceEventRingQueue & operator=(const DeviceEventRingQueue &) = delete;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
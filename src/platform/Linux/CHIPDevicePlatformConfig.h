@@ -55,8 +55,37 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+ *
+ * Store the key value store in an append-only log (ChipLinuxLogStorage) rather than in an INI file that is
+ * rewritten on every change, unless KeyValueStoreManagerImpl::Init() is told otherwise. Existing store files are
+ * always opened with the backend that wrote them.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS
+ *
+ * How long the log backend of the key value store waits after a change before syncing it to disk, so that
+ * changes made meanwhile share the sync.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS 100
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS
+
 // ========== Platform-specific Configuration Overrides =========
 
+#ifndef CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+#define CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING 1
+#endif
+
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+#define CHIP_DEVICE_CONFIG_BG_TASK_COUNT 2
+#endif
+
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
 #define CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE 8192
 #endif // CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
@@ -0,0 +1,648 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements a log structured key value store for Linux platforms.
+ *
+ *         The store file starts with an 8 byte magic, followed by records of the form:
+ *
+ *           CRC-32 (4) | type (1) | reserved (1) | key size (2) | value size (4) | key | value
+ *
+ *         with little endian integers and the CRC-32 covering everything after itself. The value of a batch
+ *         record is the sequence of put and delete records the batch consists of.
+ */
+
+#include <platform/Linux/CHIPLinuxLogStorage.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kFileMagic[8]    = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', '1' };
+constexpr size_t kRecordHeaderSize = 12;
+
+// Small stores are never compacted, rewriting them would cost more than the space it saves.
+constexpr size_t kMinCompactionSize = 64 * 1024;
+
+uint32_t Crc32(const uint8_t * data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, data, size);
+        if (written < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadAll(int fd, uint8_t * data, size_t size, size_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t bytesRead = pread(fd, data, size, static_cast<off_t>(offset));
+        if (bytesRead < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+        VerifyOrReturnError(bytesRead > 0, CHIP_ERROR_READ_FAILED);
+        data += bytesRead;
+        offset += static_cast<size_t>(bytesRead);
+        size -= static_cast<size_t>(bytesRead);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Make a rename within the directory of path durable.
+CHIP_ERROR SyncDirectory(const std::string & path)
+{
+    std::string pathCopy = path;
+    int fd               = open(dirname(&pathCopy[0]), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+    CHIP_ERROR err = (fsync(fd) == 0) ? CHIP_NO_ERROR : CHIP_ERROR_POSIX(errno);
+    close(fd);
+    return err;
+}
+
+} // namespace
+
+ChipLinuxLogStorage::~ChipLinuxLogStorage()
+{
+    Shutdown();
+}
+
+bool ChipLinuxLogStorage::IsLogFile(const char * file)
+{
+    uint8_t magic[sizeof(kFileMagic)];
+
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    VerifyOrReturnValue(fd >= 0, false);
+    bool isLogFile = ReadAll(fd, magic, sizeof(magic), 0) == CHIP_NO_ERROR && memcmp(magic, kFileMagic, sizeof(magic)) == 0;
+    close(fd);
+    return isLogFile;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Init(const char * file)
+{
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd < 0, CHIP_ERROR_INCORRECT_STATE);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxLogStorage::Init: Using KVS log file: %s", file);
+
+    mPath = file;
+    mFd   = open(file, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    CHIP_ERROR err = Load();
+    if (err != CHIP_NO_ERROR)
+    {
+        close(mFd);
+        mFd = -1;
+        mValues.clear();
+        return err;
+    }
+
+    mStopping         = false;
+    mBackgroundThread = std::thread(&ChipLinuxLogStorage::RunBackgroundTasks, this);
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxLogStorage::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mStopping = true;
+    }
+    mWakeup.notify_all();
+    if (mBackgroundThread.joinable())
+    {
+        mBackgroundThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturn(mFd >= 0);
+    if (mSyncPending && fdatasync(mFd) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to sync KVS log file %s: %s", mPath.c_str(), strerror(errno));
+    }
+    close(mFd);
+    mFd          = -1;
+    mSyncPending = false;
+    mValues.clear();
+
+    // A batch that is still open is discarded.
+    mBatchDepth  = 0;
+    mBatchFailed = false;
+    mBatchUndo.clear();
+    mBatchRecords.clear();
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Load()
+{
+    struct stat fileStat;
+    VerifyOrReturnError(fstat(mFd, &fileStat) == 0, CHIP_ERROR_POSIX(errno));
+
+    std::vector<uint8_t> contents(static_cast<size_t>(fileStat.st_size));
+    ReturnErrorOnFailure(ReadAll(mFd, contents.data(), contents.size(), 0));
+
+    mValues.clear();
+    if (contents.empty())
+    {
+        ReturnErrorOnFailure(WriteAll(mFd, kFileMagic, sizeof(kFileMagic)));
+        contents.assign(kFileMagic, kFileMagic + sizeof(kFileMagic));
+    }
+    else if (contents.size() < sizeof(kFileMagic) || memcmp(contents.data(), kFileMagic, sizeof(kFileMagic)) != 0)
+    {
+        ChipLogError(DeviceLayer, "%s is not a KVS log file", mPath.c_str());
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+
+    size_t offset = sizeof(kFileMagic);
+    offset += ApplyRecords(contents.data() + offset, contents.size() - offset, false);
+
+    if (offset != contents.size())
+    {
+        // What follows the last valid record is a write that did not complete, most likely because of a crash.
+        ChipLogError(DeviceLayer, "Dropping %u bytes of incomplete records from KVS log file %s",
+                     static_cast<unsigned>(contents.size() - offset), mPath.c_str());
+        VerifyOrReturnError(ftruncate(mFd, static_cast<off_t>(offset)) == 0, CHIP_ERROR_POSIX(errno));
+    }
+
+    mFileSize = offset;
+    mLiveSize = sizeof(kFileMagic);
+    for (const auto & entry : mValues)
+    {
+        mLiveSize += RecordSize(entry.first.size(), entry.second.size());
+    }
+    mCompactionThreshold = kMinCompactionSize;
+    mSyncPending         = false;
+
+    return CHIP_NO_ERROR;
+}
+
+size_t ChipLinuxLogStorage::ApplyRecords(const uint8_t * records, size_t size, bool inBatch)
+{
+    size_t offset = 0;
+    while (size - offset >= kRecordHeaderSize)
+    {
+        const uint8_t * record = records + offset;
+        uint32_t crc           = Encoding::LittleEndian::Get32(record);
+        auto type              = static_cast<RecordType>(record[4]);
+        size_t keySize         = Encoding::LittleEndian::Get16(record + 6);
+        size_t valueSize       = Encoding::LittleEndian::Get32(record + 8);
+        size_t recordSize      = RecordSize(keySize, valueSize);
+        if (recordSize > size - offset || Crc32(record + 4, recordSize - 4) != crc)
+        {
+            break;
+        }
+
+        std::string key(reinterpret_cast<const char *>(record + kRecordHeaderSize), keySize);
+        const uint8_t * value = record + kRecordHeaderSize + keySize;
+        if (type == RecordType::kPut)
+        {
+            mValues[key].assign(value, value + valueSize);
+        }
+        else if (type == RecordType::kDelete)
+        {
+            mValues.erase(key);
+        }
+        else if (type == RecordType::kBatch && !inBatch)
+        {
+            // The checksum of the batch record covers the records inside it, they are all intact.
+            ApplyRecords(value, valueSize, true);
+        }
+        else
+        {
+            break;
+        }
+        offset += recordSize;
+    }
+    return offset;
+}
+
+size_t ChipLinuxLogStorage::RecordSize(size_t keySize, size_t valueSize)
+{
+    return kRecordHeaderSize + keySize + valueSize;
+}
+
+void ChipLinuxLogStorage::EncodeRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const void * value,
+                                       size_t valueSize)
+{
+    size_t start = out.size();
+    out.resize(start + RecordSize(key.size(), valueSize));
+
+    uint8_t * record = &out[start];
+    uint8_t * p      = record + 4;
+    Encoding::Write8(p, static_cast<uint8_t>(type));
+    Encoding::Write8(p, 0);
+    Encoding::LittleEndian::Write16(p, static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Write32(p, static_cast<uint32_t>(valueSize));
+    memcpy(p, key.data(), key.size());
+    if (valueSize > 0)
+    {
+        memcpy(p + key.size(), value, valueSize);
+    }
+
+    Encoding::LittleEndian::Put32(record, Crc32(record + 4, out.size() - start - 4));
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Append(const std::vector<uint8_t> & record)
+{
+    CHIP_ERROR err = WriteAll(mFd, record.data(), record.size());
+    if (err != CHIP_NO_ERROR)
+    {
+        // Drop a partially written record, records appended later must not follow it.
+        if (ftruncate(mFd, static_cast<off_t>(mFileSize)) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to truncate KVS log file %s: %s", mPath.c_str(), strerror(errno));
+        }
+        return err;
+    }
+
+    mFileSize += record.size();
+    mSyncPending = true;
+    mWakeup.notify_one();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Record(RecordType type, const std::string & key, const void * value, size_t valueSize)
+{
+    if (mBatchDepth > 0)
+    {
+        RememberForBatch(key);
+        EncodeRecord(mBatchRecords, type, key, value, valueSize);
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<uint8_t> record;
+    EncodeRecord(record, type, key, value, valueSize);
+    return Append(record);
+}
+
+void ChipLinuxLogStorage::RememberForBatch(const std::string & key)
+{
+    VerifyOrReturn(mBatchUndo.find(key) == mBatchUndo.end());
+
+    auto it                = mValues.find(key);
+    BatchUndoEntry & entry = mBatchUndo[key];
+    entry.mExisted         = (it != mValues.end());
+    if (entry.mExisted)
+    {
+        entry.mValue = it->second;
+    }
+}
+
+void ChipLinuxLogStorage::RollBackBatch()
+{
+    for (auto & undo : mBatchUndo)
+    {
+        auto it = mValues.find(undo.first);
+        if (it != mValues.end())
+        {
+            mLiveSize -= RecordSize(undo.first.size(), it->second.size());
+            mValues.erase(it);
+        }
+        if (undo.second.mExisted)
+        {
+            mLiveSize += RecordSize(undo.first.size(), undo.second.mValue.size());
+            mValues.emplace(undo.first, std::move(undo.second.mValue));
+        }
+    }
+    mBatchUndo.clear();
+    mBatchRecords.clear();
+}
+
+CHIP_ERROR ChipLinuxLogStorage::ReadValue(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mValues.find(key);
+    VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const std::vector<uint8_t> & stored = it->second;
+    VerifyOrReturnError(offset <= stored.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t remainingSize = stored.size() - offset;
+    size_t copySize      = std::min(valueSize, remainingSize);
+    if (copySize > 0)
+    {
+        memcpy(value, stored.data() + offset, copySize);
+    }
+    if (readBytesSize != nullptr)
+    {
+        *readBytesSize = copySize;
+    }
+
+    return (valueSize < remainingSize) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::WriteValue(const char * key, const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value != nullptr || valueSize == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(valueSize <= UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::string keyString(key);
+    VerifyOrReturnError(keyString.size() <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mValues.find(keyString);
+    if (it != mValues.end() && it->second.size() == valueSize &&
+        (valueSize == 0 || memcmp(it->second.data(), value, valueSize) == 0))
+    {
+        // Writing the value the key already has changes nothing.
+        return CHIP_NO_ERROR;
+    }
+
+    ReturnErrorOnFailure(Record(RecordType::kPut, keyString, value, valueSize));
+
+    const uint8_t * bytes = static_cast<const uint8_t *>(value);
+    if (it != mValues.end())
+    {
+        mLiveSize -= RecordSize(keyString.size(), it->second.size());
+        it->second.assign(bytes, bytes + valueSize);
+    }
+    else
+    {
+        mValues.emplace(keyString, std::vector<uint8_t>(bytes, bytes + valueSize));
+    }
+    mLiveSize += RecordSize(keyString.size(), valueSize);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::ClearValue(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mValues.find(key);
+    VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    ReturnErrorOnFailure(Record(RecordType::kDelete, it->first, nullptr, 0));
+
+    mLiveSize -= RecordSize(it->first.size(), it->second.size());
+    mValues.erase(it);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Sync()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+    mSyncPending = false;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::BeginBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    mBatchDepth++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::CommitBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+
+    mBatchDepth--;
+    VerifyOrReturnError(mBatchDepth == 0, CHIP_NO_ERROR);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (mBatchFailed)
+    {
+        // A nested batch was aborted, which aborts the whole batch.
+        err = CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    else if (!CanCastTo<uint32_t>(mBatchRecords.size()))
+    {
+        err = CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    else if (!mBatchRecords.empty())
+    {
+        std::vector<uint8_t> record;
+        EncodeRecord(record, RecordType::kBatch, std::string(), mBatchRecords.data(), mBatchRecords.size());
+        err = Append(record);
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        RollBackBatch();
+    }
+    mBatchFailed = false;
+    mBatchUndo.clear();
+    mBatchRecords.clear();
+
+    // Compaction waits for batches to end.
+    mWakeup.notify_one();
+    return err;
+}
+
+void ChipLinuxLogStorage::AbortBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturn(mBatchDepth > 0);
+
+    mBatchDepth--;
+    if (mBatchDepth > 0)
+    {
+        // The changes stay visible until the outermost batch ends, which then discards them.
+        mBatchFailed = true;
+        return;
+    }
+
+    RollBackBatch();
+    mBatchFailed = false;
+    mWakeup.notify_one();
+}
+
+bool ChipLinuxLogStorage::NeedsCompaction() const
+{
+    // The values of an open batch must not end up in the compacted file before the batch is committed.
+    return mBatchDepth == 0 && mFileSize >= mCompactionThreshold && mFileSize > 2 * mLiveSize;
+}
+
+void ChipLinuxLogStorage::Compact(std::unique_lock<std::mutex> & lock)
+{
+    std::vector<uint8_t> snapshot(kFileMagic, kFileMagic + sizeof(kFileMagic));
+    snapshot.reserve(mLiveSize);
+    for (const auto & entry : mValues)
+    {
+        EncodeRecord(snapshot, RecordType::kPut, entry.first, entry.second.data(), entry.second.size());
+    }
+    const size_t snapshotEnd   = mFileSize;
+    const std::string tempPath = mPath + ".compact";
+
+    // Writing out the snapshot does not block changes to the store.
+    lock.unlock();
+
+    int fd         = open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    CHIP_ERROR err = (fd >= 0) ? CHIP_NO_ERROR : CHIP_ERROR_POSIX(errno);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = WriteAll(fd, snapshot.data(), snapshot.size());
+    }
+    if (err == CHIP_NO_ERROR && fdatasync(fd) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+
+    lock.lock();
+
+    // Records appended meanwhile are carried over as they are, they apply on top of the snapshot.
+    const size_t tailSize = mFileSize - snapshotEnd;
+    if (err == CHIP_NO_ERROR && tailSize > 0)
+    {
+        std::vector<uint8_t> tail(tailSize);
+        err = ReadAll(mFd, tail.data(), tail.size(), snapshotEnd);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = WriteAll(fd, tail.data(), tail.size());
+        }
+        // They may have been synced to the old file already.
+        if (err == CHIP_NO_ERROR && fdatasync(fd) != 0)
+        {
+            err = CHIP_ERROR_POSIX(errno);
+        }
+    }
+    if (err == CHIP_NO_ERROR && rename(tempPath.c_str(), mPath.c_str()) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to compact KVS log file %s: %" CHIP_ERROR_FORMAT, mPath.c_str(), err.Format());
+        if (fd >= 0)
+        {
+            close(fd);
+            unlink(tempPath.c_str());
+        }
+        // Try again once the file has doubled.
+        mCompactionThreshold = 2 * mFileSize;
+        return;
+    }
+
+    // Appends that get synced to the new file must not be lost to the old directory entry.
+    err = SyncDirectory(mPath);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to sync directory of KVS log file %s: %" CHIP_ERROR_FORMAT, mPath.c_str(), err.Format());
+    }
+
+    close(mFd);
+    mFd                  = fd;
+    mFileSize            = snapshot.size() + tailSize;
+    mSyncPending         = false;
+    mCompactionThreshold = kMinCompactionSize;
+}
+
+void ChipLinuxLogStorage::RunBackgroundTasks()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while (!mStopping)
+    {
+        if (NeedsCompaction())
+        {
+            Compact(lock);
+            continue;
+        }
+        if (!mSyncPending)
+        {
+            mWakeup.wait(lock);
+            continue;
+        }
+
+        // Let changes made shortly after each other share a single sync.
+        mWakeup.wait_for(lock, std::chrono::milliseconds(CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS),
+                         [this] { return mStopping; });
+        if (mStopping || !mSyncPending)
+        {
+            continue;
+        }
+
+        // Only this thread replaces the file descriptor, so it stays valid while the lock is released.
+        int fd       = mFd;
+        mSyncPending = false;
+        lock.unlock();
+        int syncError = (fdatasync(fd) == 0) ? 0 : errno;
+        lock.lock();
+        if (syncError != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to sync KVS log file %s: %s", mPath.c_str(), strerror(syncError));
+            mSyncPending = true;
+        }
+    }
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,144 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a log structured key value store for Linux platforms.
+ *
+ *         Every change is appended to the store file as a checksummed record, so a put or delete costs
+ *         I/O proportional to its own size instead of the size of the store. All values are also held in
+ *         memory, which serves reads.
+ *
+ *         A background thread syncs appended records to disk, at most once per
+ *         CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_SYNC_INTERVAL_MS, and compacts the file once overwritten and
+ *         deleted records take up more than half of it. Compaction writes the live records to a
+ *         temporary file that then replaces the store file, so the file is valid at any point in time.
+ *         When loading, a record that is torn or fails its checksum ends the log; it and anything after
+ *         it are dropped. The changes of a batch are appended as a single record, so they are loaded
+ *         either all or not at all.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <lib/core/CHIPError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxLogStorage
+{
+public:
+    ChipLinuxLogStorage() = default;
+    ~ChipLinuxLogStorage();
+
+    /**
+     * Returns whether the given file is a store file of this class.
+     */
+    static bool IsLogFile(const char * file);
+
+    /**
+     * Load the store from the given file, creating it if it does not exist, and start the background thread.
+     */
+    CHIP_ERROR Init(const char * file);
+
+    /**
+     * Stop the background thread, sync the file and close it.
+     */
+    void Shutdown();
+
+    /**
+     * Read the value of a key with the same semantics as KeyValueStoreManager::Get().
+     */
+    CHIP_ERROR ReadValue(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset);
+    CHIP_ERROR WriteValue(const char * key, const void * value, size_t valueSize);
+    CHIP_ERROR ClearValue(const char * key);
+
+    /**
+     * Sync all changes made so far to disk, without waiting for the background thread.
+     */
+    CHIP_ERROR Sync();
+
+    /**
+     * Start a batch, see KeyValueStoreManager::BeginBatch(). Changes made while a batch is open are visible
+     * to reads right away but only appended to the file when the outermost batch is committed. Aborting a
+     * nested batch makes committing the outermost one discard the changes and fail.
+     */
+    CHIP_ERROR BeginBatch();
+    CHIP_ERROR CommitBatch();
+    void AbortBatch();
+
+private:
+    enum class RecordType : uint8_t
+    {
+        kPut    = 1,
+        kDelete = 2,
+        kBatch  = 3, // The value holds the put and delete records of a batch
+    };
+
+    // The value a key had before the open batch first changed it.
+    struct BatchUndoEntry
+    {
+        bool mExisted;
+        std::vector<uint8_t> mValue;
+    };
+
+    CHIP_ERROR Load();
+    size_t ApplyRecords(const uint8_t * records, size_t size, bool inBatch);
+    CHIP_ERROR Record(RecordType type, const std::string & key, const void * value, size_t valueSize);
+    void RememberForBatch(const std::string & key);
+    void RollBackBatch();
+    CHIP_ERROR Append(const std::vector<uint8_t> & record);
+    bool NeedsCompaction() const;
+    void Compact(std::unique_lock<std::mutex> & lock);
+    void RunBackgroundTasks();
+
+    static size_t RecordSize(size_t keySize, size_t valueSize);
+    static void EncodeRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const void * value,
+                             size_t valueSize);
+
+    std::mutex mLock;
+    std::condition_variable mWakeup;
+    std::thread mBackgroundThread;
+    std::string mPath;
+    std::unordered_map<std::string, std::vector<uint8_t>> mValues;
+    std::unordered_map<std::string, BatchUndoEntry> mBatchUndo;
+    std::vector<uint8_t> mBatchRecords;
+    int mFd = -1;
+
+    size_t mFileSize            = 0; // Bytes in the store file, including overwritten records
+    size_t mLiveSize            = 0; // Bytes the file would take if it was compacted
+    size_t mCompactionThreshold = 0; // Do not compact before the file reaches this size
+    unsigned mBatchDepth        = 0;
+    bool mBatchFailed           = false; // A nested batch was aborted
+    bool mSyncPending           = false;
+    bool mStopping              = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -348,6 +348,27 @@ CHIP_ERROR ChipLinuxStorage::Commit()
     return retval;
 }
 
+// Discard the changes made since the last commit by reloading the config file.
+CHIP_ERROR ChipLinuxStorage::Revert()
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    if (!mConfigPath.empty())
+    {
+        mLock.lock();
+
+        retval = ChipLinuxStorageIni::Init();
+        if (retval == CHIP_NO_ERROR)
+        {
+            retval = ChipLinuxStorageIni::AddConfig(mConfigPath);
+        }
+
+        mLock.unlock();
+    }
+
+    return retval;
+}
+
 } // namespace Internal
 } // namespace DeviceLayer
 } // namespace chip
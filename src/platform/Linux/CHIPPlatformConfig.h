@@ -56,6 +56,14 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 8
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+#ifndef CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+#define CHIP_CONFIG_SECURE_SESSION_ID_BITMAP 1
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
+#ifndef CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+#define CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS 1024
+#endif // CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+
 #ifndef CHIP_LOG_FILTERING
 #define CHIP_LOG_FILTERING 0
 #endif // CHIP_LOG_FILTERING
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <string.h>
+#include <sys/stat.h>
 
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -36,6 +37,29 @@ namespace PersistedStorage {
 
 KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 
+CHIP_ERROR KeyValueStoreManagerImpl::Init(const char * file)
+{
+    Backend backend = CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE ? Backend::kLog : Backend::kIni;
+
+    struct stat fileStat;
+    if (file != nullptr && stat(file, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        backend = DeviceLayer::Internal::ChipLinuxLogStorage::IsLogFile(file) ? Backend::kLog : Backend::kIni;
+    }
+
+    return Init(file, backend);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::Init(const char * file, Backend backend)
+{
+    mBackend = backend;
+    if (backend == Backend::kLog)
+    {
+        return mLogStorage.Init(file);
+    }
+    return mStorage.Init(file);
+}
+
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
@@ -44,6 +68,11 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t
     // Copy data into value buffer
     VerifyOrReturnError(value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
+    if (mBackend == Backend::kLog)
+    {
+        return mLogStorage.ReadValue(key, value, value_size, read_bytes_size, offset_bytes);
+    }
+
     // On linux read first without a buffer which returns the size, and then
     // use a local buffer to read the entire object, which allows partial and
     // offset reads.
@@ -80,9 +109,20 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
+    if (mBackend == Backend::kLog)
+    {
+        return mLogStorage.WriteValue(key, value, value_size);
+    }
+
     err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
     SuccessOrExit(err);
 
+    if (mBatchDepth > 0)
+    {
+        mBatchDirty = true;
+        ExitNow();
+    }
+
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
@@ -94,7 +134,13 @@ exit:
 CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
-    err            = mStorage.ClearValue(key);
+
+    if (mBackend == Backend::kLog)
+    {
+        return mLogStorage.ClearValue(key);
+    }
+
+    err = mStorage.ClearValue(key);
 
     if (err == CHIP_ERROR_KEY_NOT_FOUND)
     {
@@ -102,6 +148,12 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
     }
     SuccessOrExit(err);
 
+    if (mBatchDepth > 0)
+    {
+        mBatchDirty = true;
+        ExitNow();
+    }
+
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
@@ -110,6 +162,79 @@ exit:
     return err;
 }
 
+CHIP_ERROR KeyValueStoreManagerImpl::_BeginBatch()
+{
+    if (mBackend == Backend::kLog)
+    {
+        return mLogStorage.BeginBatch();
+    }
+
+    mBatchDepth++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_CommitBatch()
+{
+    if (mBackend == Backend::kLog)
+    {
+        return mLogStorage.CommitBatch();
+    }
+
+    VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+    mBatchDepth--;
+    VerifyOrReturnError(mBatchDepth == 0, CHIP_NO_ERROR);
+
+    if (mBatchFailed)
+    {
+        // A nested batch was aborted, which aborts the whole batch.
+        RevertBatch();
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    VerifyOrReturnError(mBatchDirty, CHIP_NO_ERROR);
+
+    mBatchDirty    = false;
+    CHIP_ERROR err = mStorage.Commit();
+    if (err != CHIP_NO_ERROR)
+    {
+        // Do not let a later commit write the changes of the failed batch.
+        mStorage.Revert();
+    }
+    return err;
+}
+
+void KeyValueStoreManagerImpl::_AbortBatch()
+{
+    if (mBackend == Backend::kLog)
+    {
+        mLogStorage.AbortBatch();
+        return;
+    }
+
+    VerifyOrReturn(mBatchDepth > 0);
+    mBatchDepth--;
+    if (mBatchDepth > 0)
+    {
+        // The changes stay visible until the outermost batch ends, which then discards them.
+        mBatchFailed = true;
+        return;
+    }
+
+    RevertBatch();
+}
+
+void KeyValueStoreManagerImpl::RevertBatch()
+{
+    mBatchFailed = false;
+    VerifyOrReturn(mBatchDirty);
+
+    mBatchDirty    = false;
+    CHIP_ERROR err = mStorage.Revert();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to discard KVS changes: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxLogStorage.h>
 #include <platform/Linux/CHIPLinuxStorage.h>
 
 namespace chip {
@@ -32,18 +34,46 @@ namespace PersistedStorage {
 class KeyValueStoreManagerImpl : public KeyValueStoreManager
 {
 public:
+    enum class Backend : uint8_t
+    {
+        kIni, ///< An INI file, rewritten on every change.
+        kLog, ///< An append-only log, see ChipLinuxLogStorage.
+    };
+
     /**
      * @brief
      * Initalize the KVS, must be called before using.
+     *
+     * An existing store file is opened with the backend that wrote it, a new one is created with the
+     * backend selected by CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE.
+     */
+    CHIP_ERROR Init(const char * file);
+
+    /**
+     * @brief
+     * Initalize the KVS with the given backend, must be called before using.
      */
-    CHIP_ERROR Init(const char * file) { return mStorage.Init(file); }
+    CHIP_ERROR Init(const char * file, Backend backend);
 
     CHIP_ERROR _Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size = nullptr, size_t offset = 0);
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
+    CHIP_ERROR _BeginBatch();
+    CHIP_ERROR _CommitBatch();
+    void _AbortBatch();
 
 private:
+    void RevertBatch();
+
+    Backend mBackend = Backend::kIni;
+
+    // The INI file is only rewritten once the outermost batch is committed.
+    unsigned mBatchDepth = 0;
+    bool mBatchDirty     = false;
+    bool mBatchFailed    = false; // A nested batch was aborted
+
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
+    DeviceLayer::Internal::ChipLinuxLogStorage mLogStorage;
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
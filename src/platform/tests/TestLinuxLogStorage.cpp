@@ -0,0 +1,319 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the log structured key value store
+ *      of Linux platforms.
+ *
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/UnitTestUtils.h>
+#include <nlunit-test.h>
+
+#include <platform/Linux/CHIPLinuxLogStorage.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+std::string MakeTempPath()
+{
+    char path[] = "/tmp/chip_test_kvs_log-XXXXXX";
+    int fd      = mkstemp(path);
+    if (fd >= 0)
+    {
+        close(fd);
+        unlink(path);
+    }
+    return path;
+}
+
+size_t FileSize(const std::string & path)
+{
+    struct stat fileStat;
+    return (stat(path.c_str(), &fileStat) == 0) ? static_cast<size_t>(fileStat.st_size) : 0;
+}
+
+void TestLogStorage_ReadWrite(nlTestSuite * inSuite, void * inContext)
+{
+    const std::string path = MakeTempPath();
+    ChipLinuxLogStorage storage;
+    uint8_t buffer[16];
+    size_t readSize = 0;
+
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ChipLinuxLogStorage::IsLogFile(path.c_str()));
+
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("a", "0123456789", 10) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("b", "xyz", 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("empty", nullptr, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("b", "uvw", 3) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 10 && memcmp(buffer, "0123456789", 10) == 0);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, 4, &readSize, 4) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, readSize == 4 && memcmp(buffer, "4567", 4) == 0);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 11) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("b", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 3 && memcmp(buffer, "uvw", 3) == 0);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("empty", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 0);
+
+    NL_TEST_ASSERT(inSuite, storage.ClearValue("a") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ClearValue("a") == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // Everything survives reloading the file.
+    storage.Shutdown();
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("b", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 3 && memcmp(buffer, "uvw", 3) == 0);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("empty", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.Sync() == CHIP_NO_ERROR);
+
+    storage.Shutdown();
+    unlink(path.c_str());
+}
+
+void TestLogStorage_TornRecord(nlTestSuite * inSuite, void * inContext)
+{
+    const std::string path = MakeTempPath();
+    ChipLinuxLogStorage storage;
+    uint8_t buffer[16];
+    size_t readSize = 0;
+
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("kept", "1", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("torn", "2", 1) == CHIP_NO_ERROR);
+    storage.Shutdown();
+
+    // Cut the last record short, as a crash in the middle of writing it would.
+    NL_TEST_ASSERT(inSuite, truncate(path.c_str(), static_cast<off_t>(FileSize(path) - 2)) == 0);
+
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("kept", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("torn", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // Records appended after the dropped one are found again.
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("after", "3", 1) == CHIP_NO_ERROR);
+    storage.Shutdown();
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("kept", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("after", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+
+    storage.Shutdown();
+    unlink(path.c_str());
+}
+
+void TestLogStorage_Compaction(nlTestSuite * inSuite, void * inContext)
+{
+    const std::string path = MakeTempPath();
+    ChipLinuxLogStorage storage;
+    uint8_t value[1024];
+    uint8_t buffer[sizeof(value)];
+    size_t readSize = 0;
+
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("other", "x", 1) == CHIP_NO_ERROR);
+
+    // Overwrite a value until most of the file is garbage, the background thread then compacts it.
+    for (int i = 0; i < 256; i++)
+    {
+        memset(value, i, sizeof(value));
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("big", value, sizeof(value)) == CHIP_NO_ERROR);
+    }
+    for (size_t t = 0; FileSize(path) > 4 * sizeof(value) && t < 5000; t++)
+    {
+        chip::test_utils::SleepMillis(1);
+    }
+    NL_TEST_ASSERT(inSuite, FileSize(path) <= 4 * sizeof(value));
+
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("big", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(value) && memcmp(buffer, value, sizeof(value)) == 0);
+
+    // The compacted file holds the same values.
+    storage.Shutdown();
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("big", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(value) && memcmp(buffer, value, sizeof(value)) == 0);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("other", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+
+    storage.Shutdown();
+    unlink(path.c_str());
+}
+
+void TestLogStorage_Batch(nlTestSuite * inSuite, void * inContext)
+{
+    const std::string path = MakeTempPath();
+    ChipLinuxLogStorage storage;
+    uint8_t buffer[16];
+    size_t readSize = 0;
+
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("a", "1", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("b", "2", 1) == CHIP_NO_ERROR);
+    const size_t sizeBeforeBatch = FileSize(path);
+
+    // Changes of a batch are visible right away, but only appended once the outermost batch commits.
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("a", "3", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ClearValue("b") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("c", "4", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 1 && buffer[0] == '3');
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("b", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, FileSize(path) == sizeBeforeBatch);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, FileSize(path) > sizeBeforeBatch);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+
+    // Aborting restores the values from before the batch.
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("a", "5", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ClearValue("c") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("d", "6", 1) == CHIP_NO_ERROR);
+    storage.AbortBatch();
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 1 && buffer[0] == '3');
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("c", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("d", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // Aborting a nested batch fails the outermost one, which then rolls back everything on commit.
+    const size_t sizeBeforeFailedBatch = FileSize(path);
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("a", "5", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("d", "6", 1) == CHIP_NO_ERROR);
+    storage.AbortBatch();
+    NL_TEST_ASSERT(inSuite, storage.ClearValue("c") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, FileSize(path) == sizeBeforeFailedBatch);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 1 && buffer[0] == '3');
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("c", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("d", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // The failure does not carry over to the next batch.
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    storage.AbortBatch();
+    storage.AbortBatch();
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("c", "9", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, FileSize(path) > sizeBeforeFailedBatch);
+
+    storage.Shutdown();
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 1 && buffer[0] == '3');
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("b", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("c", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("d", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // A torn batch is dropped as a whole.
+    NL_TEST_ASSERT(inSuite, storage.BeginBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("a", "7", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValue("e", "8", 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.CommitBatch() == CHIP_NO_ERROR);
+    storage.Shutdown();
+    NL_TEST_ASSERT(inSuite, truncate(path.c_str(), static_cast<off_t>(FileSize(path) - 2)) == 0);
+
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("a", buffer, sizeof(buffer), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 1 && buffer[0] == '3');
+    NL_TEST_ASSERT(inSuite, storage.ReadValue("e", buffer, sizeof(buffer), &readSize, 0) ==
+                       CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    storage.Shutdown();
+    unlink(path.c_str());
+}
+
+void TestLogStorage_NotALogFile(nlTestSuite * inSuite, void * inContext)
+{
+    const std::string path = MakeTempPath();
+    ChipLinuxLogStorage storage;
+
+    FILE * file = fopen(path.c_str(), "w");
+    NL_TEST_ASSERT(inSuite, file != nullptr);
+    VerifyOrReturn(file != nullptr);
+    fputs("[DEFAULT]\nkey=dmFsdWU=\n", file);
+    fclose(file);
+
+    NL_TEST_ASSERT(inSuite, !ChipLinuxLogStorage::IsLogFile(path.c_str()));
+    NL_TEST_ASSERT(inSuite, storage.Init(path.c_str()) != CHIP_NO_ERROR);
+
+    unlink(path.c_str());
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test ChipLinuxLogStorage read and write", TestLogStorage_ReadWrite),
+    NL_TEST_DEF("Test ChipLinuxLogStorage torn record", TestLogStorage_TornRecord),
+    NL_TEST_DEF("Test ChipLinuxLogStorage compaction", TestLogStorage_Compaction),
+    NL_TEST_DEF("Test ChipLinuxLogStorage batches", TestLogStorage_Batch),
+    NL_TEST_DEF("Test ChipLinuxLogStorage with other file", TestLogStorage_NotALogFile),
+    NL_TEST_SENTINEL(),
+};
+
+int TestLinuxLogStorage_Setup(void * inContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestLinuxLogStorage_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestLinuxLogStorage()
+{
+    nlTestSuite theSuite = { "Linux KVS log storage tests", &sTests[0], TestLinuxLogStorage_Setup, TestLinuxLogStorage_Teardown };
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLinuxLogStorage);
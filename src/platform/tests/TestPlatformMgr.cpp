@@ -39,6 +39,10 @@
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/TestOnlyCommissionableDataProvider.h>
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif
+
 using namespace chip;
 using namespace chip::Logging;
 using namespace chip::Inet;
@@ -114,6 +118,212 @@ static void TestPlatformMgr_BasicEventLoopTask(nlTestSuite * inSuite, void * inC
     PlatformMgr().Shutdown();
 }
 
+static std::atomic<int> sBackgroundWorkRan{ 0 };
+
+static void CountBackgroundWork(intptr_t)
+{
+    sBackgroundWorkRan++;
+}
+
+static void TestPlatformMgr_ScheduleBackgroundWork(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kWorkCount = 16;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = PlatformMgr().StartEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Background work runs on the background task(s) if the platform has them,
+    // or on the event loop task otherwise. Either way, all of it has to run.
+    sBackgroundWorkRan = 0;
+    for (int i = 0; i < kWorkCount; i++)
+    {
+        err = PlatformMgr().ScheduleBackgroundWork(CountBackgroundWork);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    for (size_t t = 0; sBackgroundWorkRan != kWorkCount && t < 1000; t++)
+        chip::test_utils::SleepMillis(1);
+
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRan == kWorkCount);
+
+    err = PlatformMgr().StopEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    PlatformMgr().Shutdown();
+}
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+static std::atomic<int> sBackgroundWorkRunning{ 0 };
+static std::atomic<int> sBackgroundWorkSawAllTasks{ 0 };
+static std::atomic<int> sBackgroundWorkOnCallerThread{ 0 };
+static pthread_t sCallerThread;
+
+static void WaitForAllBackgroundTasks(intptr_t)
+{
+    if (pthread_equal(pthread_self(), sCallerThread))
+    {
+        sBackgroundWorkOnCallerThread++;
+    }
+
+    // Only returns early if every background task is running an item at once.
+    sBackgroundWorkRunning++;
+    for (size_t t = 0; sBackgroundWorkRunning < CHIP_DEVICE_CONFIG_BG_TASK_COUNT && t < 1000; t++)
+        chip::test_utils::SleepMillis(1);
+    if (sBackgroundWorkRunning >= CHIP_DEVICE_CONFIG_BG_TASK_COUNT)
+    {
+        sBackgroundWorkSawAllTasks++;
+    }
+    sBackgroundWorkRan++;
+}
+
+static void SlowBackgroundWork(intptr_t)
+{
+    chip::test_utils::SleepMillis(1);
+    sBackgroundWorkRan++;
+}
+
+static void TestPlatformMgr_BackgroundTasks(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kWorkCount = 16;
+
+    sCallerThread                 = pthread_self();
+    sBackgroundWorkRan            = 0;
+    sBackgroundWorkRunning        = 0;
+    sBackgroundWorkSawAllTasks    = 0;
+    sBackgroundWorkOnCallerThread = 0;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The event loop is not running, so the work can only run on the background tasks, all at once.
+    for (int i = 0; i < CHIP_DEVICE_CONFIG_BG_TASK_COUNT; i++)
+    {
+        err = PlatformMgr().ScheduleBackgroundWork(WaitForAllBackgroundTasks);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    for (size_t t = 0; sBackgroundWorkRan != CHIP_DEVICE_CONFIG_BG_TASK_COUNT && t < 2000; t++)
+        chip::test_utils::SleepMillis(1);
+
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRan == CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkSawAllTasks == CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkOnCallerThread == 0);
+
+    // Work still queued at shutdown runs before the background tasks exit.
+    sBackgroundWorkRan = 0;
+    for (int i = 0; i < kWorkCount; i++)
+    {
+        err = PlatformMgr().ScheduleBackgroundWork(SlowBackgroundWork);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    PlatformMgr().Shutdown();
+
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRan == kWorkCount);
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+constexpr int kPostingThreadCount = 4;
+constexpr int kWorkPerThread      = 1000;
+
+static std::atomic<int> sWorkRan{ 0 };
+static int sLastWorkSeen[kPostingThreadCount]; // Only accessed from the event loop task while it runs
+static bool sWorkOutOfOrder;
+static std::atomic<int> sPostFailed{ 0 };
+static std::atomic<bool> sPostingDone{ false };
+
+static void CheckWorkOrder(intptr_t arg)
+{
+    int thread = static_cast<int>(arg / kWorkPerThread);
+    int work   = static_cast<int>(arg % kWorkPerThread);
+    if (work != sLastWorkSeen[thread] + 1)
+    {
+        sWorkOutOfOrder = true;
+    }
+    sLastWorkSeen[thread] = work;
+    sWorkRan++;
+}
+
+static void WaitForPostingDone(intptr_t)
+{
+    for (size_t t = 0; !sPostingDone && t < 5000; t++)
+        chip::test_utils::SleepMillis(1);
+}
+
+static void * PostWork(void * arg)
+{
+    intptr_t thread = reinterpret_cast<intptr_t>(arg);
+    for (int i = 0; i < kWorkPerThread; i++)
+    {
+        if (PlatformMgr().ScheduleWork(CheckWorkOrder, thread * kWorkPerThread + i) != CHIP_NO_ERROR)
+        {
+            sPostFailed++;
+        }
+    }
+    return nullptr;
+}
+
+static void TestPlatformMgr_ScheduleWorkFromManyThreads(nlTestSuite * inSuite, void * inContext)
+{
+    pthread_t threads[kPostingThreadCount];
+
+    static_assert(kPostingThreadCount * kWorkPerThread > CHIP_DEVICE_CONFIG_POSIX_EVENT_QUEUE_SIZE,
+                  "The work must not fit in the event queue ring");
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = PlatformMgr().StartEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // First with the event loop held up until all work is posted, so that the event queue overflows, then
+    // with the event loop draining the queue while work is posted.
+    for (bool holdEventLoop : { true, false })
+    {
+        sWorkRan        = 0;
+        sWorkOutOfOrder = false;
+        sPostFailed     = 0;
+        sPostingDone    = false;
+        for (int & last : sLastWorkSeen)
+        {
+            last = -1;
+        }
+
+        if (holdEventLoop)
+        {
+            NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleWork(WaitForPostingDone) == CHIP_NO_ERROR);
+        }
+
+        for (intptr_t i = 0; i < kPostingThreadCount; i++)
+        {
+            NL_TEST_ASSERT(inSuite, pthread_create(&threads[i], nullptr, PostWork, reinterpret_cast<void *>(i)) == 0);
+        }
+        for (pthread_t & thread : threads)
+        {
+            pthread_join(thread, nullptr);
+        }
+        sPostingDone = true;
+
+        // Posting never fails, each item must run exactly once and in the order its thread posted it.
+        for (size_t t = 0; sWorkRan != kPostingThreadCount * kWorkPerThread && t < 5000; t++)
+            chip::test_utils::SleepMillis(1);
+
+        NL_TEST_ASSERT(inSuite, sPostFailed == 0);
+        NL_TEST_ASSERT(inSuite, sWorkRan == kPostingThreadCount * kWorkPerThread);
+        NL_TEST_ASSERT(inSuite, !sWorkOutOfOrder);
+    }
+
+    err = PlatformMgr().StopEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    PlatformMgr().Shutdown();
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 static bool stopRan;
 
 static void StopTheLoop(intptr_t)
@@ -260,6 +470,13 @@ static const nlTest sTests[] = {
 
     NL_TEST_DEF("Test PlatformMgr::Init/Shutdown", TestPlatformMgr_InitShutdown),
     NL_TEST_DEF("Test basic PlatformMgr::StartEventLoopTask", TestPlatformMgr_BasicEventLoopTask),
+    NL_TEST_DEF("Test PlatformMgr::ScheduleBackgroundWork", TestPlatformMgr_ScheduleBackgroundWork),
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("Test PlatformMgr background tasks", TestPlatformMgr_BackgroundTasks),
+#endif
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("Test PlatformMgr::ScheduleWork from many threads", TestPlatformMgr_ScheduleWorkFromManyThreads),
+#endif
     NL_TEST_DEF("Test basic PlatformMgr::RunEventLoop", TestPlatformMgr_BasicRunEventLoop),
     NL_TEST_DEF("Test PlatformMgr::RunEventLoop with two tasks", TestPlatformMgr_RunEventLoopTwoTasks),
     NL_TEST_DEF("Test PlatformMgr::RunEventLoop with stop before sleep", TestPlatformMgr_RunEventLoopStopBeforeSleep),
@@ -0,0 +1,220 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Microbenchmark measuring how many events per second increasing numbers of producer threads
+ *      can post to a consumer thread woken through an eventfd, the way application threads post to
+ *      the CHIP task on POSIX platforms. Compares the mutex protected DeviceSafeQueue, signalled for
+ *      every event, with the DeviceEventRingQueue, signalled once per drain.
+ *
+ *      Usage: chip-platform-event-queue-benchmark [producer-count ...]
+ */
+
+#include <platform/DeviceEventRingQueue.h>
+#include <platform/DeviceSafeQueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <memory>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip::DeviceLayer;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr size_t kEventCount = 1 << 20;
+
+void Check(bool ok, const char * what)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "%s failed: %s\n", what, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+double EventsPerSecond(std::chrono::steady_clock::time_point start, size_t count)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(count) / elapsed.count();
+}
+
+class WakeEvent
+{
+public:
+    WakeEvent() : mFd(eventfd(0, EFD_NONBLOCK)) { Check(mFd >= 0, "eventfd"); }
+    ~WakeEvent() { close(mFd); }
+
+    void Notify()
+    {
+        uint64_t value = 1;
+        Check(write(mFd, &value, sizeof(value)) == sizeof(value) || errno == EAGAIN, "write");
+    }
+
+    void Wait()
+    {
+        struct pollfd pfd = { mFd, POLLIN, 0 };
+        Check(poll(&pfd, 1, -1) >= 0 || errno == EINTR, "poll");
+
+        uint64_t value;
+        Check(read(mFd, &value, sizeof(value)) == sizeof(value) || errno == EAGAIN, "read");
+    }
+
+private:
+    int mFd;
+};
+
+// The event loop as it was: every post takes the queue lock and signals the consumer.
+class MutexQueue
+{
+public:
+    void Post(const ChipDeviceEvent & event)
+    {
+        mQueue.Push(event);
+        mWakeEvent.Notify();
+    }
+
+    size_t Drain()
+    {
+        mWakeEvent.Wait();
+
+        size_t count = 0;
+        while (!mQueue.Empty())
+        {
+            const ChipDeviceEvent event = mQueue.PopFront();
+            count += (event.Type == DeviceEventType::kCallWorkFunct);
+        }
+        return count;
+    }
+
+private:
+    DeviceSafeQueue mQueue;
+    WakeEvent mWakeEvent;
+};
+
+// The event loop as it is: posts go to the ring, and only the first one after a drain started signals the consumer.
+class RingQueue
+{
+public:
+    void Post(const ChipDeviceEvent & event)
+    {
+        mQueue.Push(event);
+        if (!mWakePending.exchange(true, std::memory_order_acq_rel))
+        {
+            mWakeEvent.Notify();
+        }
+    }
+
+    size_t Drain()
+    {
+        mWakeEvent.Wait();
+
+        size_t count = 0;
+        ChipDeviceEvent event;
+        while (mWakePending.exchange(false, std::memory_order_acq_rel))
+        {
+            while (mQueue.Pop(event))
+            {
+                count += (event.Type == DeviceEventType::kCallWorkFunct);
+            }
+        }
+        return count;
+    }
+
+private:
+    DeviceEventRingQueue<CHIP_DEVICE_CONFIG_POSIX_EVENT_QUEUE_SIZE> mQueue;
+    std::atomic<bool> mWakePending{ false };
+    WakeEvent mWakeEvent;
+};
+
+template <typename Queue>
+double Run(size_t producerCount)
+{
+    std::unique_ptr<Queue> queue(new Queue());
+    const size_t eventsPerProducer = kEventCount / producerCount;
+    const size_t total             = eventsPerProducer * producerCount;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&queue, eventsPerProducer, p]() {
+            ChipDeviceEvent event;
+            event.Type = DeviceEventType::kCallWorkFunct;
+            for (size_t i = 0; i < eventsPerProducer; i++)
+            {
+                event.CallWorkFunct.Arg = static_cast<intptr_t>(p * eventsPerProducer + i);
+                queue->Post(event);
+            }
+        });
+    }
+
+    size_t received = 0;
+    while (received < total)
+    {
+        received += queue->Drain();
+    }
+    double result = EventsPerSecond(start, total);
+
+    for (std::thread & producer : producers)
+    {
+        producer.join();
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 0)));
+    }
+    if (counts.empty())
+    {
+        counts = { 1, 2, 4, 8, 16, 32 };
+    }
+
+    printf("%9s  %14s  %14s\n", "producers", "mutex events/s", "ring events/s");
+    for (size_t count : counts)
+    {
+        if (count == 0 || count > kEventCount)
+        {
+            fprintf(stderr, "producer count must be between 1 and %zu\n", kEventCount);
+            return EXIT_FAILURE;
+        }
+
+        double mutex = Run<MutexQueue>(count);
+        double ring  = Run<RingQueue>(count);
+        printf("%9zu  %14.0f  %14.0f\n", count, mutex, ring);
+    }
+
+    return EXIT_SUCCESS;
+}
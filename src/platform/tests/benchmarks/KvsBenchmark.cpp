@@ -0,0 +1,179 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Microbenchmark measuring how many puts per second the Linux key value store backends sustain
+ *      for stores of increasing numbers of keys. Compares the INI file backend, which rewrites the
+ *      whole file on every put, with the append-only log backend.
+ *
+ *      Usage: chip-platform-kvs-benchmark [key-count ...]
+ */
+
+#include <platform/Linux/CHIPLinuxLogStorage.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr size_t kPutCount  = 2000;
+constexpr size_t kValueSize = 64;
+
+void Check(bool ok, const char * what)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "%s failed\n", what);
+        exit(EXIT_FAILURE);
+    }
+}
+
+std::string MakeTempPath()
+{
+    char path[] = "/tmp/chip-kvs-benchmark-XXXXXX";
+    int fd      = mkstemp(path);
+    Check(fd >= 0, "mkstemp");
+    close(fd);
+    unlink(path);
+    return path;
+}
+
+std::string KeyName(size_t index)
+{
+    char key[16];
+    snprintf(key, sizeof(key), "k/%zx", index);
+    return key;
+}
+
+class IniBackend
+{
+public:
+    explicit IniBackend(const std::string & path)
+    {
+        Check(mStorage.Init(path.c_str()) == CHIP_NO_ERROR, "ChipLinuxStorage::Init");
+    }
+
+    void Put(const std::string & key, const uint8_t * value, size_t valueSize)
+    {
+        // KeyValueStoreManagerImpl commits after every put.
+        Check(mStorage.WriteValueBin(key.c_str(), value, valueSize) == CHIP_NO_ERROR, "ChipLinuxStorage::WriteValueBin");
+        Check(mStorage.Commit() == CHIP_NO_ERROR, "ChipLinuxStorage::Commit");
+    }
+
+private:
+    ChipLinuxStorage mStorage;
+};
+
+class LogBackend
+{
+public:
+    explicit LogBackend(const std::string & path)
+    {
+        Check(mStorage.Init(path.c_str()) == CHIP_NO_ERROR, "ChipLinuxLogStorage::Init");
+    }
+    ~LogBackend() { mStorage.Shutdown(); }
+
+    void Put(const std::string & key, const uint8_t * value, size_t valueSize)
+    {
+        Check(mStorage.WriteValue(key.c_str(), value, valueSize) == CHIP_NO_ERROR, "ChipLinuxLogStorage::WriteValue");
+    }
+
+private:
+    ChipLinuxLogStorage mStorage;
+};
+
+template <typename Backend>
+double Run(size_t keyCount)
+{
+    const std::string path = MakeTempPath();
+    uint8_t value[kValueSize];
+    double result;
+
+    {
+        Backend backend(path);
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < keyCount; i++)
+        {
+            keys.push_back(KeyName(i));
+            memset(value, 0, sizeof(value));
+            backend.Put(keys.back(), value, sizeof(value));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < kPutCount; i++)
+        {
+            // Change the value every time so that no backend can skip the write.
+            memset(value, static_cast<int>(i + 1), sizeof(value));
+            backend.Put(keys[i % keyCount], value, sizeof(value));
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        result                                = static_cast<double>(kPutCount) / elapsed.count();
+    }
+
+    unlink(path.c_str());
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 0)));
+    }
+    if (counts.empty())
+    {
+        counts = { 16, 128, 1024 };
+    }
+
+    Check(Platform::MemoryInit() == CHIP_NO_ERROR, "MemoryInit");
+
+    // The INI backend logs every commit, keep that out of the measurement.
+    Logging::SetLogFilter(Logging::kLogCategory_Error);
+
+    printf("%6s  %12s  %12s\n", "keys", "ini puts/s", "log puts/s");
+    for (size_t count : counts)
+    {
+        if (count == 0)
+        {
+            fprintf(stderr, "key count must be at least 1\n");
+            return EXIT_FAILURE;
+        }
+
+        double ini = Run<IniBackend>(count);
+        double log = Run<LogBackend>(count);
+        printf("%6zu  %12.0f  %12.0f\n", count, ini, log);
+    }
+
+    Platform::MemoryShutdown();
+    return EXIT_SUCCESS;
+}
@@ -16,11 +16,13 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include <credentials/FabricTable.h>
 #include <credentials/GroupDataProvider.h>
 #include <lib/core/CHIPError.h>
 #include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
 #include <lib/support/Span.h>
 
 #include "CASEDestinationId.h"
@@ -62,4 +64,154 @@ CHIP_ERROR GenerateCaseDestinationId(const ByteSpan & ipk, const ByteSpan & init
     return err;
 }
 
+CHIP_ERROR CASEDestinationIdTable::EncodeStaticMessage(const FabricInfo & fabricInfo, uint8_t (&outMessage)[kStaticMessageLength])
+{
+    P256PublicKey rootPubKey;
+    ReturnErrorOnFailure(fabricInfo.FetchRootPubkey(rootPubKey));
+
+    Encoding::LittleEndian::BufferWriter bbuf(outMessage, sizeof(outMessage));
+    bbuf.Put(rootPubKey.ConstBytes(), rootPubKey.Length());
+    bbuf.Put64(fabricInfo.GetFabricId());
+    bbuf.Put64(fabricInfo.GetNodeId());
+
+    size_t written = 0;
+    VerifyOrReturnError(bbuf.Fit(written) && written == kStaticMessageLength, CHIP_ERROR_INTERNAL);
+    return CHIP_NO_ERROR;
+}
+
+bool CASEDestinationIdTable::IsCurrent(const FabricTable & fabricTable,
+                                       const Credentials::GroupDataProvider & groupDataProvider) const
+{
+    // Without a key set generation to check, key sets may have changed since they were loaded.
+    if (!mLoaded || !groupDataProvider.SupportsKeySetGeneration() || mKeySetGeneration != groupDataProvider.GetKeySetGeneration())
+    {
+        return false;
+    }
+
+    size_t index = 0;
+    for (const FabricInfo & fabricInfo : fabricTable)
+    {
+        uint8_t staticMessage[kStaticMessageLength];
+        if (index >= mEntryCount || mEntries[index].fabricIndex != fabricInfo.GetFabricIndex() ||
+            EncodeStaticMessage(fabricInfo, staticMessage) != CHIP_NO_ERROR ||
+            memcmp(staticMessage, mEntries[index].staticMessage, kStaticMessageLength) != 0)
+        {
+            return false;
+        }
+        index++;
+    }
+    return index == mEntryCount;
+}
+
+CHIP_ERROR CASEDestinationIdTable::Load(const FabricTable & fabricTable, Credentials::GroupDataProvider & groupDataProvider)
+{
+    Clear();
+
+    for (const FabricInfo & fabricInfo : fabricTable)
+    {
+        VerifyOrReturnError(mEntryCount < ArraySize(mEntries), CHIP_ERROR_NO_MEMORY);
+        Entry & entry     = mEntries[mEntryCount];
+        entry.fabricIndex = fabricInfo.GetFabricIndex();
+        entry.nodeId      = fabricInfo.GetNodeId();
+        entry.ipkCount    = 0;
+        ReturnErrorOnFailure(EncodeStaticMessage(fabricInfo, entry.staticMessage));
+        mEntryCount++;
+
+        // A fabric without a usable IPK cannot match, but it still has an entry so that IsCurrent can tell the table apart
+        // from the fabric table.
+        Credentials::GroupDataProvider::KeySet ipkKeySet;
+        CHIP_ERROR err = groupDataProvider.GetIpkKeySet(fabricInfo.GetFabricIndex(), ipkKeySet);
+        if ((err != CHIP_NO_ERROR) ||
+            ((ipkKeySet.num_keys_used == 0) || (ipkKeySet.num_keys_used > Credentials::GroupDataProvider::KeySet::kEpochKeysMax)))
+        {
+            continue;
+        }
+
+        for (size_t keyIdx = 0; keyIdx < ipkKeySet.num_keys_used; ++keyIdx)
+        {
+            memcpy(entry.ipks[keyIdx], ipkKeySet.epoch_keys[keyIdx].key, kIPKSize);
+        }
+        entry.ipkCount = ipkKeySet.num_keys_used;
+        mIpkCount += ipkKeySet.num_keys_used;
+        ClearSecretData(reinterpret_cast<uint8_t *>(&ipkKeySet), sizeof(ipkKeySet));
+    }
+
+    mKeySetGeneration = groupDataProvider.GetKeySetGeneration();
+    mLoaded           = true;
+    return CHIP_NO_ERROR;
+}
+
+bool CASEDestinationIdTable::Matches(const Entry & entry, const ByteSpan & destinationId, const ByteSpan & initiatorRandom,
+                                     size_t & outIpkIndex) const
+{
+    uint8_t destinationMessage[kSigmaParamRandomNumberSize + kStaticMessageLength];
+    memcpy(destinationMessage, initiatorRandom.data(), kSigmaParamRandomNumberSize);
+    memcpy(destinationMessage + kSigmaParamRandomNumberSize, entry.staticMessage, kStaticMessageLength);
+
+    for (size_t keyIdx = 0; keyIdx < entry.ipkCount; ++keyIdx)
+    {
+        uint8_t candidateDestinationId[kSHA256_Hash_Length];
+        HMAC_sha hmac;
+        CHIP_ERROR err = hmac.HMAC_SHA256(entry.ipks[keyIdx], kIPKSize, destinationMessage, sizeof(destinationMessage),
+                                          candidateDestinationId, sizeof(candidateDestinationId));
+        if ((err == CHIP_NO_ERROR) && destinationId.data_equal(ByteSpan(candidateDestinationId)))
+        {
+            outIpkIndex = keyIdx;
+            return true;
+        }
+    }
+    return false;
+}
+
+CHIP_ERROR CASEDestinationIdTable::FindLocalNode(const FabricTable & fabricTable,
+                                                 Credentials::GroupDataProvider & groupDataProvider, const ByteSpan & destinationId,
+                                                 const ByteSpan & initiatorRandom, FabricIndex & outFabricIndex, NodeId & outNodeId,
+                                                 MutableByteSpan & outIpk)
+{
+    VerifyOrReturnError(initiatorRandom.size() == kSigmaParamRandomNumberSize, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(outIpk.size() >= kIPKSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    if (!IsCurrent(fabricTable, groupDataProvider))
+    {
+        CHIP_ERROR err = Load(fabricTable, groupDataProvider);
+        if (err != CHIP_NO_ERROR)
+        {
+            Clear();
+            return err;
+        }
+    }
+
+    // Nothing can match, whatever the peer sent: don't spend any HMAC on it.
+    VerifyOrReturnError(mIpkCount > 0, CHIP_ERROR_KEY_NOT_FOUND);
+    VerifyOrReturnError(destinationId.size() == kSHA256_Hash_Length, CHIP_ERROR_KEY_NOT_FOUND);
+
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        // Start from the fabric that matched last, since peers tend to come back to the same fabric.
+        size_t index        = (mLastMatch + i) % mEntryCount;
+        const Entry & entry = mEntries[index];
+        size_t ipkIndex     = 0;
+        if (Matches(entry, destinationId, initiatorRandom, ipkIndex))
+        {
+            mLastMatch     = index;
+            outFabricIndex = entry.fabricIndex;
+            outNodeId      = entry.nodeId;
+            memcpy(outIpk.data(), entry.ipks[ipkIndex], kIPKSize);
+            outIpk.reduce_size(kIPKSize);
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    return CHIP_ERROR_KEY_NOT_FOUND;
+}
+
+void CASEDestinationIdTable::Clear()
+{
+    ClearSecretData(reinterpret_cast<uint8_t *>(mEntries), sizeof(mEntries));
+    mEntryCount = 0;
+    mIpkCount   = 0;
+    mLastMatch  = 0;
+    mLoaded     = false;
+}
+
 } // namespace chip
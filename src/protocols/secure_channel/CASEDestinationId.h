@@ -22,6 +22,7 @@
 #include <credentials/GroupDataProvider.h>
 #include <crypto/CHIPCryptoPAL.h>
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <lib/core/DataModelTypes.h>
 #include <lib/support/Span.h>
@@ -34,4 +35,65 @@ inline constexpr uint16_t kIPKSize                    = Crypto::CHIP_CRYPTO_SYMM
 CHIP_ERROR GenerateCaseDestinationId(const ByteSpan & ipk, const ByteSpan & initiatorRandom, const ByteSpan & rootPubKey,
                                      FabricId fabricId, NodeId nodeId, MutableByteSpan & outDestinationId);
 
+/**
+ * Cache of the destination identifier inputs of the local fabrics, used by a CASE responder to match the destination
+ * identifier of incoming Sigma1 messages without fetching the root public key and reading the IPK key set of every fabric
+ * for each message.
+ *
+ * For each fabric, the cache holds the IPK epoch keys and the destination message with the root public key, fabric ID and
+ * node ID already encoded, so that each candidate costs a single HMAC. The fabric that matched last is tried first, and a
+ * lookup fails without computing any HMAC when no fabric has an IPK.
+ *
+ * On each lookup, the cache is checked against the fabric table and the key set generation of the group data provider, and
+ * reloaded if either changed. With a group data provider that does not support key set generations, it is reloaded on
+ * every lookup.
+ */
+class CASEDestinationIdTable
+{
+public:
+    ~CASEDestinationIdTable() { Clear(); }
+
+    /**
+     * Find the local node whose destination identifier for the given initiator random is destinationId.
+     *
+     * @param[out] outIpk  Receives the IPK that produced the match; must be at least kIPKSize bytes long.
+     *
+     * @return CHIP_ERROR_KEY_NOT_FOUND if no local node matches, or another error if the fabric data could not be loaded.
+     */
+    CHIP_ERROR FindLocalNode(const FabricTable & fabricTable, Credentials::GroupDataProvider & groupDataProvider,
+                             const ByteSpan & destinationId, const ByteSpan & initiatorRandom, FabricIndex & outFabricIndex,
+                             NodeId & outNodeId, MutableByteSpan & outIpk);
+
+    /**
+     * Drop the cached data, wiping the IPKs.
+     */
+    void Clear();
+
+private:
+    // Destination message without the leading initiator random: root public key, fabric ID and node ID.
+    static constexpr size_t kStaticMessageLength = Crypto::kP256_PublicKey_Length + sizeof(FabricId) + sizeof(NodeId);
+
+    struct Entry
+    {
+        FabricIndex fabricIndex;
+        NodeId nodeId;
+        uint8_t staticMessage[kStaticMessageLength];
+        uint8_t ipkCount;
+        uint8_t ipks[Credentials::GroupDataProvider::KeySet::kEpochKeysMax][kIPKSize];
+    };
+
+    static CHIP_ERROR EncodeStaticMessage(const FabricInfo & fabricInfo, uint8_t (&outMessage)[kStaticMessageLength]);
+
+    bool IsCurrent(const FabricTable & fabricTable, const Credentials::GroupDataProvider & groupDataProvider) const;
+    CHIP_ERROR Load(const FabricTable & fabricTable, Credentials::GroupDataProvider & groupDataProvider);
+    bool Matches(const Entry & entry, const ByteSpan & destinationId, const ByteSpan & initiatorRandom, size_t & outIpkIndex) const;
+
+    Entry mEntries[CHIP_CONFIG_MAX_FABRICS];
+    size_t mEntryCount         = 0;
+    size_t mIpkCount           = 0;
+    size_t mLastMatch          = 0;
+    uint32_t mKeySetGeneration = 0;
+    bool mLoaded               = false;
+};
+
 } // namespace chip
@@ -45,8 +45,9 @@ CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager
     mExchangeManager           = exchangeManager;
     mGroupDataProvider         = responderGroupDataProvider;
 
-    // Set up the group state provider that persists across all handshakes.
+    // Set up the group state provider and destination identifier table that persist across all handshakes.
     GetSession().SetGroupDataProvider(mGroupDataProvider);
+    GetSession().SetDestinationIdTable(&mDestinationIdTable);
 
     ChipLogProgress(Inet, "CASE Server enabling CASE session setups");
     mExchangeManager->RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1, this);
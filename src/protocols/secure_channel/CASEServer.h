@@ -50,6 +50,7 @@ public:
 
         GetSession().Clear();
         mPinnedSecureSession.ClearValue();
+        mDestinationIdTable.Clear();
     }
 
     CHIP_ERROR ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, SessionManager * sessionManager,
@@ -93,6 +94,9 @@ private:
     CASESession mPairingSession;
     SessionManager * mSessionManager = nullptr;
 
+    // Shared by all the handshakes of mPairingSession, so that the fabric data it caches survives between them.
+    CASEDestinationIdTable mDestinationIdTable;
+
     FabricTable * mFabrics                              = nullptr;
     Credentials::GroupDataProvider * mGroupDataProvider = nullptr;
 
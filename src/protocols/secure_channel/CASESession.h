@@ -117,6 +117,16 @@ public:
      */
     void SetGroupDataProvider(Credentials::GroupDataProvider * groupDataProvider) { mGroupDataProvider = groupDataProvider; }
 
+    /**
+     * @brief Set the table used by a responder to match the destination identifier of incoming Sigma1 messages
+     *
+     * The table is owned by the caller and must outlive the session. If none is set, every fabric and IPK is
+     * tried against the destination identifier of each Sigma1.
+     *
+     * @param destinationIdTable - Pointer to the destination identifier table, or nullptr
+     */
+    void SetDestinationIdTable(CASEDestinationIdTable * destinationIdTable) { mDestinationIdTable = destinationIdTable; }
+
     /**
      * Parse a sigma1 message.  This function will return success only if the
      * message passes schema checks.  Specifically:
@@ -203,6 +213,8 @@ public:
         kFinishedViaResume   = 7,
         kSendSigma3Pending   = 8,
         kHandleSigma3Pending = 9,
+        kSendSigma2Pending   = 10,
+        kHandleSigma2Pending = 11,
     };
 
     State GetState() { return mState; }
@@ -237,9 +249,21 @@ private:
     CHIP_ERROR HandleSigma1(System::PacketBufferHandle && msg);
     CHIP_ERROR TryResumeSession(SessionResumptionStorage::ConstResumptionIdView resumptionId, ByteSpan resume1MIC,
                                 ByteSpan initiatorRandom);
-    CHIP_ERROR SendSigma2();
+
+    struct SendSigma2Data;
+    CHIP_ERROR SendSigma2a();
+    static CHIP_ERROR SendSigma2b(SendSigma2Data & data, bool & cancel);
+    CHIP_ERROR SendSigma2c(SendSigma2Data & data, CHIP_ERROR status);
+
     CHIP_ERROR HandleSigma2_and_SendSigma3(System::PacketBufferHandle && msg);
-    CHIP_ERROR HandleSigma2(System::PacketBufferHandle && msg);
+
+    struct HandleSigma2Data;
+    struct VerifySigma2Data;
+    CHIP_ERROR HandleSigma2a(System::PacketBufferHandle && msg);
+    static CHIP_ERROR HandleSigma2b(HandleSigma2Data & data, bool & cancel);
+    CHIP_ERROR HandleSigma2c(HandleSigma2Data & data, CHIP_ERROR status);
+    static CHIP_ERROR HandleSigma2d(VerifySigma2Data & data, bool & cancel);
+    CHIP_ERROR HandleSigma2e(VerifySigma2Data & data, CHIP_ERROR status);
     CHIP_ERROR HandleSigma2Resume(System::PacketBufferHandle && msg);
 
     struct SendSigma3Data;
@@ -293,6 +317,7 @@ private:
     Crypto::P256ECDHDerivedSecret mSharedSecret;
     Credentials::ValidationContext mValidContext;
     Credentials::GroupDataProvider * mGroupDataProvider = nullptr;
+    CASEDestinationIdTable * mDestinationIdTable        = nullptr;
 
     uint8_t mMessageDigest[Crypto::kSHA256_Hash_Length];
     uint8_t mIPK[kIPKSize];
@@ -312,6 +337,9 @@ private:
 
     template <class DATA>
     class WorkHelper;
+    Platform::SharedPtr<WorkHelper<SendSigma2Data>> mSendSigma2Helper;
+    Platform::SharedPtr<WorkHelper<HandleSigma2Data>> mHandleSigma2Helper;
+    Platform::SharedPtr<WorkHelper<VerifySigma2Data>> mVerifySigma2Helper;
     Platform::SharedPtr<WorkHelper<SendSigma3Data>> mSendSigma3Helper;
     Platform::SharedPtr<WorkHelper<HandleSigma3Data>> mHandleSigma3Helper;
 
@@ -42,6 +42,11 @@
 #include <protocols/secure_channel/CASESession.h>
 #include <stdarg.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "credentials/tests/CHIPCert_test_vectors.h"
 
 using namespace chip;
@@ -65,16 +70,74 @@ public:
     void TearDownTestSuite() override;
 };
 
+void StopEventLoop(intptr_t)
+{
+    chip::DeviceLayer::PlatformMgr().StopEventLoopTask();
+}
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+// Stops the event loop once the background work scheduled so far has finished. One barrier item is queued per background
+// task, and none of them returns before all of them have been picked up, so the work queued ahead of them is done by then
+// and whatever it scheduled on the event loop is queued ahead of the stop.
+class BackgroundWorkBarrier
+{
+public:
+    static void StopEventLoopAfterBackgroundWork()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sMutex);
+            sArrived  = 0;
+            sDeparted = 0;
+        }
+        for (int i = 0; i < CHIP_DEVICE_CONFIG_BG_TASK_COUNT; i++)
+        {
+            chip::DeviceLayer::PlatformMgr().ScheduleBackgroundWork(Wait);
+        }
+    }
+
+private:
+    static void Wait(intptr_t)
+    {
+        std::unique_lock<std::mutex> lock(sMutex);
+        sArrived++;
+        sCond.notify_all();
+        sCond.wait(lock, [] { return sArrived == CHIP_DEVICE_CONFIG_BG_TASK_COUNT; });
+        if (++sDeparted == CHIP_DEVICE_CONFIG_BG_TASK_COUNT)
+        {
+            chip::DeviceLayer::PlatformMgr().ScheduleWork(StopEventLoop);
+        }
+    }
+
+    static std::mutex sMutex;
+    static std::condition_variable sCond;
+    static int sArrived;
+    static int sDeparted;
+};
+
+std::mutex BackgroundWorkBarrier::sMutex;
+std::condition_variable BackgroundWorkBarrier::sCond;
+int BackgroundWorkBarrier::sArrived;
+int BackgroundWorkBarrier::sDeparted;
+
+// Each step of a handshake that runs in the background takes a round of its own.
+constexpr int kServiceEventsRounds = 12;
+#else
+constexpr int kServiceEventsRounds = 3;
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 void ServiceEvents(TestContext & ctx)
 {
     // Takes a few rounds of this because handling IO messages may schedule work,
     // and scheduled work may queue messages for sending...
-    for (int i = 0; i < 3; ++i)
+    for (int i = 0; i < kServiceEventsRounds; ++i)
     {
         ctx.DrainAndServiceIO();
 
-        chip::DeviceLayer::PlatformMgr().ScheduleWork(
-            [](intptr_t) -> void { chip::DeviceLayer::PlatformMgr().StopEventLoopTask(); }, (intptr_t) nullptr);
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+        BackgroundWorkBarrier::StopEventLoopAfterBackgroundWork();
+#else
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(StopEventLoop);
+#endif
         chip::DeviceLayer::PlatformMgr().RunEventLoop();
     }
 }
@@ -229,6 +292,20 @@ Credentials::PersistentStorageOpCertStore gDeviceOpCertStore;
 
 CASEServer gPairingServer;
 
+// A group data provider that, like implementations which do not track key set changes, never changes its key set generation.
+class NoKeySetGenerationGroupDataProvider : public GroupDataProviderImpl
+{
+public:
+    CHIP_ERROR SetKeySet(FabricIndex fabric_index, const ByteSpan & compressed_fabric_id, const KeySet & keys) override
+    {
+        CHIP_ERROR err    = GroupDataProviderImpl::SetKeySet(fabric_index, compressed_fabric_id, keys);
+        mKeySetGeneration = 0;
+        return err;
+    }
+
+    bool SupportsKeySetGeneration() const override { return false; }
+};
+
 NodeId Node01_01 = 0xDEDEDEDE00010001;
 NodeId Node01_02 = 0xDEDEDEDE00010002;
 
@@ -372,11 +449,15 @@ public:
     static void ClientReceivesBusyTest(nlTestSuite * inSuite, void * inContext);
     static void Sigma1ParsingTest(nlTestSuite * inSuite, void * inContext);
     static void DestinationIdTest(nlTestSuite * inSuite, void * inContext);
+    static void DestinationIdTableTest(nlTestSuite * inSuite, void * inContext);
     static void SessionResumptionStorage(nlTestSuite * inSuite, void * inContext);
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void SimulateUpdateNOCInvalidatePendingEstablishment(nlTestSuite * inSuite, void * inContext);
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * inContext);
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    static void BackgroundWorkTest(nlTestSuite * inSuite, void * inContext);
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
 };
 
 void TestCASESession::SecurePairingWaitTest(nlTestSuite * inSuite, void * inContext)
@@ -719,6 +800,91 @@ void TestCASESession::DestinationIdTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !destinationIdSpan.data_equal(ByteSpan(kExpectedDestinationIdFromSpec)));
 }
 
+void TestCASESession::DestinationIdTableTest(nlTestSuite * inSuite, void * inContext)
+{
+    const FabricInfo * fabricInfo = gDeviceFabrics.FindFabricWithIndex(gDeviceFabricIndex);
+    NL_TEST_ASSERT(inSuite, fabricInfo != nullptr);
+    if (fabricInfo == nullptr)
+    {
+        return;
+    }
+
+    Crypto::P256PublicKey rootPubKey;
+    NL_TEST_ASSERT(inSuite, fabricInfo->FetchRootPubkey(rootPubKey) == CHIP_NO_ERROR);
+
+    const uint8_t initiatorRandom[kSigmaParamRandomNumberSize] = { 0x7e, 0x17, 0x12, 0x31 };
+
+    // Destination identifiers for the first and second IPK operational keys of the device fabric.
+    uint8_t destinationIds[2][Crypto::kSHA256_Hash_Length];
+    uint8_t ipks[2][kIPKSize];
+    NL_TEST_ASSERT(inSuite, InitTestIpk(gDeviceGroupDataProvider, *fabricInfo, /* numIpks= */ 2) == CHIP_NO_ERROR);
+    GroupDataProvider::KeySet ipkKeySet;
+    NL_TEST_ASSERT(inSuite, gDeviceGroupDataProvider.GetIpkKeySet(gDeviceFabricIndex, ipkKeySet) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ipkKeySet.num_keys_used == 2);
+    for (size_t keyIdx = 0; keyIdx < 2; keyIdx++)
+    {
+        memcpy(ipks[keyIdx], ipkKeySet.epoch_keys[keyIdx].key, kIPKSize);
+        MutableByteSpan destinationIdSpan(destinationIds[keyIdx]);
+        NL_TEST_ASSERT(inSuite,
+                       GenerateCaseDestinationId(ByteSpan(ipks[keyIdx]), ByteSpan(initiatorRandom),
+                                                 ByteSpan(rootPubKey.ConstBytes(), rootPubKey.Length()), fabricInfo->GetFabricId(),
+                                                 fabricInfo->GetNodeId(), destinationIdSpan) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, InitTestIpk(gDeviceGroupDataProvider, *fabricInfo, /* numIpks= */ 1) == CHIP_NO_ERROR);
+
+    CASEDestinationIdTable table;
+    FabricIndex fabricIndex = kUndefinedFabricIndex;
+    NodeId nodeId           = kUndefinedNodeId;
+    uint8_t ipk[kIPKSize]   = { 0 };
+    auto findLocalNode      = [&](size_t keyIdx) {
+        MutableByteSpan ipkSpan(ipk);
+        return table.FindLocalNode(gDeviceFabrics, gDeviceGroupDataProvider, ByteSpan(destinationIds[keyIdx]),
+                                   ByteSpan(initiatorRandom), fabricIndex, nodeId, ipkSpan);
+    };
+
+    // The device fabric starts with a single IPK.
+    NL_TEST_ASSERT(inSuite, findLocalNode(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, fabricIndex == gDeviceFabricIndex);
+    NL_TEST_ASSERT(inSuite, nodeId == fabricInfo->GetNodeId());
+    NL_TEST_ASSERT(inSuite, memcmp(ipk, ipks[0], kIPKSize) == 0);
+    NL_TEST_ASSERT(inSuite, findLocalNode(1) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    // Key set changes are picked up by the next lookup.
+    NL_TEST_ASSERT(inSuite, InitTestIpk(gDeviceGroupDataProvider, *fabricInfo, /* numIpks= */ 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, findLocalNode(1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, fabricIndex == gDeviceFabricIndex);
+    NL_TEST_ASSERT(inSuite, memcmp(ipk, ipks[1], kIPKSize) == 0);
+
+    NL_TEST_ASSERT(inSuite, InitTestIpk(gDeviceGroupDataProvider, *fabricInfo, /* numIpks= */ 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, findLocalNode(1) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, findLocalNode(0) == CHIP_NO_ERROR);
+
+    // Key set changes are also picked up from a group data provider without key set generation.
+    TestPersistentStorageDelegate storage;
+    NoKeySetGenerationGroupDataProvider groupDataProvider;
+    groupDataProvider.SetStorageDelegate(&storage);
+    groupDataProvider.SetSessionKeystore(&gDeviceSessionKeystore);
+    NL_TEST_ASSERT(inSuite, groupDataProvider.Init() == CHIP_NO_ERROR);
+
+    CASEDestinationIdTable uncachedTable;
+    auto findLocalNodeUncached = [&](size_t keyIdx) {
+        MutableByteSpan ipkSpan(ipk);
+        return uncachedTable.FindLocalNode(gDeviceFabrics, groupDataProvider, ByteSpan(destinationIds[keyIdx]),
+                                           ByteSpan(initiatorRandom), fabricIndex, nodeId, ipkSpan);
+    };
+
+    NL_TEST_ASSERT(inSuite, InitTestIpk(groupDataProvider, *fabricInfo, /* numIpks= */ 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, findLocalNodeUncached(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, findLocalNodeUncached(1) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    NL_TEST_ASSERT(inSuite, InitTestIpk(groupDataProvider, *fabricInfo, /* numIpks= */ 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, groupDataProvider.GetKeySetGeneration() == 0);
+    NL_TEST_ASSERT(inSuite, findLocalNodeUncached(1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(ipk, ipks[1], kIPKSize) == 0);
+
+    groupDataProvider.Finish();
+}
+
 template <typename Params>
 static CHIP_ERROR EncodeSigma1(MutableByteSpan & buf)
 {
@@ -1207,6 +1373,88 @@ void TestCASESession::Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * i
     caseSession.Clear();
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+namespace {
+// Applies the default policy, counting whether certificates are validated on the Matter thread or elsewhere.
+class ThreadCountingValidityPolicy : public CertificateValidityPolicy
+{
+public:
+    CHIP_ERROR ApplyCertificateValidityPolicy(const ChipCertificateData * cert, uint8_t depth,
+                                              CertificateValidityResult result) override
+    {
+        if (std::this_thread::get_id() == mMatterThread)
+        {
+            mCallsOnMatterThread++;
+        }
+        else
+        {
+            mCallsInBackground++;
+        }
+        return ApplyDefaultPolicy(cert, depth, result);
+    }
+
+    // The tests run the event loop on their own thread.
+    std::thread::id mMatterThread = std::this_thread::get_id();
+    std::atomic<int> mCallsOnMatterThread{ 0 };
+    std::atomic<int> mCallsInBackground{ 0 };
+};
+} // namespace
+
+void TestCASESession::BackgroundWorkTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TemporarySessionManager sessionManager(inSuite, ctx);
+
+    TestCASESecurePairingDelegate delegateCommissioner;
+    CASESession pairingCommissioner;
+    pairingCommissioner.SetGroupDataProvider(&gCommissionerGroupDataProvider);
+
+    TestCASESecurePairingDelegate delegateAccessory;
+    CASESession pairingAccessory;
+    pairingAccessory.SetGroupDataProvider(&gDeviceGroupDataProvider);
+
+    ThreadCountingValidityPolicy policy;
+
+    auto & loopback            = ctx.GetLoopback();
+    loopback.mSentMessageCount = 0;
+
+    NL_TEST_ASSERT(inSuite,
+                   ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1,
+                                                                                     &pairingAccessory) == CHIP_NO_ERROR);
+
+    ExchangeContext * contextCommissioner = ctx.NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.PrepareForSessionEstablishment(sessionManager, &gDeviceFabrics, nullptr, &policy,
+                                                                   &delegateAccessory, ScopedNodeId(),
+                                                                   Optional<ReliableMessageProtocolConfig>::Missing()) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner.EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                        ScopedNodeId{ Node01_01, gCommissionerFabricIndex }, contextCommissioner,
+                                                        nullptr, &policy, &delegateCommissioner,
+                                                        Optional<ReliableMessageProtocolConfig>::Missing()) == CHIP_NO_ERROR);
+
+    // Delivering Sigma1 leaves the accessory waiting for the key agreement of Sigma2, even though its operational keystore
+    // cannot sign in the background.
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, !gDeviceOperationalKeystore.SupportsSignWithOpKeypairInBackground());
+    NL_TEST_ASSERT(inSuite, pairingAccessory.mState == CASESession::State::kSendSigma2Pending);
+
+    ServiceEvents(ctx);
+
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == sTestCaseMessageCount);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingErrors == 0);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingErrors == 0);
+
+    // Both certificate chains were validated, and only off the Matter thread.
+    NL_TEST_ASSERT(inSuite, policy.mCallsInBackground > 0);
+    NL_TEST_ASSERT(inSuite, policy.mCallsOnMatterThread == 0);
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 } // namespace chip
 
 // Test Suite
@@ -1224,6 +1472,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("ClientReceivesBusy", chip::TestCASESession::ClientReceivesBusyTest),
     NL_TEST_DEF("Sigma1Parsing", chip::TestCASESession::Sigma1ParsingTest),
     NL_TEST_DEF("DestinationId", chip::TestCASESession::DestinationIdTest),
+    NL_TEST_DEF("DestinationIdTable", chip::TestCASESession::DestinationIdTableTest),
     NL_TEST_DEF("SessionResumptionStorage", chip::TestCASESession::SessionResumptionStorage),
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     // This is compiled for host tests which is enough test coverage to ensure updating NOC invalidates
@@ -1231,6 +1480,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("InvalidatePendingSessionEstablishment", chip::TestCASESession::SimulateUpdateNOCInvalidatePendingEstablishment),
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     NL_TEST_DEF("Sigma1BadDestinationId", chip::TestCASESession::Sigma1BadDestinationIdTest),
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    NL_TEST_DEF("BackgroundWork", chip::TestCASESession::BackgroundWorkTest),
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
 
     NL_TEST_SENTINEL()
 };
@@ -0,0 +1,282 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Microbenchmark measuring how many Sigma1 destination identifiers per second a CASE responder
+ *      can match against its fabrics, each with three IPK epoch keys, when scanning the fabric table
+ *      and key sets for every message and when using a CASEDestinationIdTable. Destination
+ *      identifiers that match the last candidate and ones that match nothing are measured separately.
+ *
+ *      Usage: chip-case-destination-id-benchmark [fabric-count ...]
+ */
+
+#include <credentials/FabricTable.h>
+#include <credentials/GroupDataProviderImpl.h>
+#include <credentials/PersistentStorageOpCertStore.h>
+#include <credentials/TestOnlyLocalCertificateAuthority.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <crypto/PersistentStorageOperationalKeystore.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <protocols/secure_channel/CASEDestinationId.h>
+
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Credentials;
+
+namespace {
+
+constexpr size_t kMessageCount = 2000;
+constexpr uint8_t kIpkCount    = GroupDataProvider::KeySet::kEpochKeysMax;
+
+struct Sigma1
+{
+    uint8_t initiatorRandom[kSigmaParamRandomNumberSize];
+    uint8_t destinationId[Crypto::kSHA256_Hash_Length];
+};
+
+void Check(CHIP_ERROR err, const char * what)
+{
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "%s failed: %" CHIP_ERROR_FORMAT "\n", what, err.Format());
+        exit(EXIT_FAILURE);
+    }
+}
+
+double MessagesPerSecond(std::chrono::steady_clock::time_point start, size_t count)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(count) / elapsed.count();
+}
+
+class Responder
+{
+public:
+    Responder(size_t fabricCount)
+    {
+        Check(mOpKeystore.Init(&mStorage), "PersistentStorageOperationalKeystore::Init");
+        Check(mOpCertStore.Init(&mStorage), "PersistentStorageOpCertStore::Init");
+        FabricTable::InitParams initParams;
+        initParams.storage             = &mStorage;
+        initParams.operationalKeystore = &mOpKeystore;
+        initParams.opCertStore         = &mOpCertStore;
+        Check(mFabricTable.Init(initParams), "FabricTable::Init");
+
+        mGroupDataProvider.SetStorageDelegate(&mStorage);
+        mGroupDataProvider.SetSessionKeystore(&mSessionKeystore);
+        Check(mGroupDataProvider.Init(), "GroupDataProviderImpl::Init");
+
+        for (size_t i = 0; i < fabricCount; i++)
+        {
+            AddFabric(static_cast<FabricId>(i + 1), static_cast<NodeId>(0x100 + i));
+        }
+    }
+
+    ~Responder()
+    {
+        mGroupDataProvider.Finish();
+        mFabricTable.Shutdown();
+        mOpCertStore.Finish();
+        mOpKeystore.Finish();
+    }
+
+    // The destination identifier the initiator would send for the given fabric and IPK.
+    void MakeSigma1(const FabricInfo & fabricInfo, size_t keyIdx, Sigma1 & outSigma1)
+    {
+        Check(Crypto::DRBG_get_bytes(outSigma1.initiatorRandom, sizeof(outSigma1.initiatorRandom)), "DRBG_get_bytes");
+
+        Crypto::P256PublicKey rootPubKey;
+        Check(fabricInfo.FetchRootPubkey(rootPubKey), "FetchRootPubkey");
+        GroupDataProvider::KeySet ipkKeySet;
+        Check(mGroupDataProvider.GetIpkKeySet(fabricInfo.GetFabricIndex(), ipkKeySet), "GetIpkKeySet");
+
+        MutableByteSpan destinationIdSpan(outSigma1.destinationId);
+        Check(GenerateCaseDestinationId(ByteSpan(ipkKeySet.epoch_keys[keyIdx].key), ByteSpan(outSigma1.initiatorRandom),
+                                        ByteSpan(rootPubKey.ConstBytes(), rootPubKey.Length()), fabricInfo.GetFabricId(),
+                                        fabricInfo.GetNodeId(), destinationIdSpan),
+              "GenerateCaseDestinationId");
+    }
+
+    // What CASESession does without a destination identifier table.
+    CHIP_ERROR Scan(const Sigma1 & sigma1, FabricIndex & outFabricIndex)
+    {
+        for (const FabricInfo & fabricInfo : mFabricTable)
+        {
+            Crypto::P256PublicKey rootPubKey;
+            ReturnErrorOnFailure(mFabricTable.FetchRootPubkey(fabricInfo.GetFabricIndex(), rootPubKey));
+
+            GroupDataProvider::KeySet ipkKeySet;
+            if (mGroupDataProvider.GetIpkKeySet(fabricInfo.GetFabricIndex(), ipkKeySet) != CHIP_NO_ERROR)
+            {
+                continue;
+            }
+
+            for (size_t keyIdx = 0; keyIdx < ipkKeySet.num_keys_used; ++keyIdx)
+            {
+                uint8_t candidateDestinationId[Crypto::kSHA256_Hash_Length];
+                MutableByteSpan candidateDestinationIdSpan(candidateDestinationId);
+                CHIP_ERROR err = GenerateCaseDestinationId(
+                    ByteSpan(ipkKeySet.epoch_keys[keyIdx].key), ByteSpan(sigma1.initiatorRandom),
+                    ByteSpan(rootPubKey.ConstBytes(), rootPubKey.Length()), fabricInfo.GetFabricId(), fabricInfo.GetNodeId(),
+                    candidateDestinationIdSpan);
+                if ((err == CHIP_NO_ERROR) && candidateDestinationIdSpan.data_equal(ByteSpan(sigma1.destinationId)))
+                {
+                    outFabricIndex = fabricInfo.GetFabricIndex();
+                    return CHIP_NO_ERROR;
+                }
+            }
+        }
+        return CHIP_ERROR_KEY_NOT_FOUND;
+    }
+
+    CHIP_ERROR Lookup(const Sigma1 & sigma1, FabricIndex & outFabricIndex)
+    {
+        NodeId nodeId;
+        uint8_t ipk[kIPKSize];
+        MutableByteSpan ipkSpan(ipk);
+        return mTable.FindLocalNode(mFabricTable, mGroupDataProvider, ByteSpan(sigma1.destinationId),
+                                    ByteSpan(sigma1.initiatorRandom), outFabricIndex, nodeId, ipkSpan);
+    }
+
+    const FabricTable & GetFabricTable() const { return mFabricTable; }
+
+private:
+    void AddFabric(FabricId fabricId, NodeId nodeId)
+    {
+        TestOnlyLocalCertificateAuthority certAuthority;
+        Check(certAuthority.Init().GetStatus(), "TestOnlyLocalCertificateAuthority::Init");
+
+        std::unique_ptr<Crypto::P256Keypair> opKey(new Crypto::P256Keypair());
+        Check(opKey->Initialize(Crypto::ECPKeyTarget::ECDSA), "P256Keypair::Initialize");
+        Check(certAuthority.SetIncludeIcac(false).GenerateNocChain(fabricId, nodeId, opKey->Pubkey()).GetStatus(),
+              "GenerateNocChain");
+
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        Check(mFabricTable.AddNewPendingTrustedRootCert(certAuthority.GetRcac()), "AddNewPendingTrustedRootCert");
+        Check(mFabricTable.AddNewPendingFabricWithProvidedOpKey(certAuthority.GetNoc(), ByteSpan{}, VendorId::TestVendor1,
+                                                                 opKey.get(), /* isExistingOpKeyExternallyOwned = */ true,
+                                                                 &fabricIndex),
+              "AddNewPendingFabricWithProvidedOpKey");
+        Check(mFabricTable.CommitPendingFabricData(), "CommitPendingFabricData");
+        mOpKeys.push_back(std::move(opKey));
+
+        const FabricInfo * fabricInfo = mFabricTable.FindFabricWithIndex(fabricIndex);
+        uint8_t compressedId[sizeof(uint64_t)];
+        MutableByteSpan compressedIdSpan(compressedId);
+        Check(fabricInfo->GetCompressedFabricIdBytes(compressedIdSpan), "GetCompressedFabricIdBytes");
+
+        GroupDataProvider::KeySet ipkKeySet(GroupDataProvider::kIdentityProtectionKeySetId,
+                                            GroupDataProvider::SecurityPolicy::kTrustFirst, kIpkCount);
+        for (uint8_t keyIdx = 0; keyIdx < kIpkCount; keyIdx++)
+        {
+            ipkKeySet.epoch_keys[keyIdx].start_time = keyIdx * 1000u;
+            Check(Crypto::DRBG_get_bytes(ipkKeySet.epoch_keys[keyIdx].key, sizeof(ipkKeySet.epoch_keys[keyIdx].key)),
+                  "DRBG_get_bytes");
+        }
+        Check(mGroupDataProvider.SetKeySet(fabricIndex, compressedIdSpan, ipkKeySet), "SetKeySet");
+    }
+
+    TestPersistentStorageDelegate mStorage;
+    PersistentStorageOperationalKeystore mOpKeystore;
+    PersistentStorageOpCertStore mOpCertStore;
+    FabricTable mFabricTable;
+    Crypto::DefaultSessionKeystore mSessionKeystore;
+    GroupDataProviderImpl mGroupDataProvider;
+    std::vector<std::unique_ptr<Crypto::P256Keypair>> mOpKeys;
+    CASEDestinationIdTable mTable;
+};
+
+template <typename Match>
+double Run(const std::vector<Sigma1> & messages, CHIP_ERROR expected, Match && match)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (const Sigma1 & sigma1 : messages)
+    {
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        if (match(sigma1, fabricIndex) != expected)
+        {
+            fprintf(stderr, "unexpected destination identifier match result\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return MessagesPerSecond(start, messages.size());
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 0)));
+    }
+    if (counts.empty())
+    {
+        counts = { 1, 5, CHIP_CONFIG_MAX_FABRICS };
+    }
+
+    Check(Platform::MemoryInit(), "MemoryInit");
+
+    printf("%8s  %-6s  %14s  %14s\n", "fabrics", "lookup", "match msg/s", "no match msg/s");
+    for (size_t count : counts)
+    {
+        if (count == 0 || count > CHIP_CONFIG_MAX_FABRICS)
+        {
+            fprintf(stderr, "fabric count must be between 1 and %d\n", CHIP_CONFIG_MAX_FABRICS);
+            return EXIT_FAILURE;
+        }
+
+        Responder responder(count);
+
+        // Matching messages are for the last IPK of the last fabric, the worst case of a scan.
+        const FabricInfo * lastFabric = nullptr;
+        for (const FabricInfo & fabricInfo : responder.GetFabricTable())
+        {
+            lastFabric = &fabricInfo;
+        }
+        std::vector<Sigma1> matching(kMessageCount);
+        std::vector<Sigma1> unknown(kMessageCount);
+        for (size_t i = 0; i < kMessageCount; i++)
+        {
+            responder.MakeSigma1(*lastFabric, kIpkCount - 1, matching[i]);
+            Check(Crypto::DRBG_get_bytes(reinterpret_cast<uint8_t *>(&unknown[i]), sizeof(unknown[i])), "DRBG_get_bytes");
+        }
+
+        auto scan  = [&](const Sigma1 & sigma1, FabricIndex & fabricIndex) { return responder.Scan(sigma1, fabricIndex); };
+        auto table = [&](const Sigma1 & sigma1, FabricIndex & fabricIndex) { return responder.Lookup(sigma1, fabricIndex); };
+
+        double scanMatch    = Run(matching, CHIP_NO_ERROR, scan);
+        double scanUnknown  = Run(unknown, CHIP_ERROR_KEY_NOT_FOUND, scan);
+        double tableMatch   = Run(matching, CHIP_NO_ERROR, table);
+        double tableUnknown = Run(unknown, CHIP_ERROR_KEY_NOT_FOUND, table);
+        printf("%8zu  %-6s  %14.0f  %14.0f\n", count, "scan", scanMatch, scanUnknown);
+        printf("%8zu  %-6s  %14.0f  %14.0f\n", count, "table", tableMatch, tableUnknown);
+    }
+
+    Platform::MemoryShutdown();
+    return EXIT_SUCCESS;
+}
@@ -495,6 +495,24 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      Use a hierarchical timing wheel (chip::System::TimerWheel) rather than a sorted list (chip::System::TimerList)
+ *      to hold pending timers in the sockets-based System::Layer implementations. Adding and cancelling a timer then
+ *      take constant time rather than time proportional to the number of pending timers, at the cost of a few
+ *      kilobytes of fixed memory per layer. Not supported together with CHIP_SYSTEM_CONFIG_USE_DISPATCH or
+ *      CHIP_SYSTEM_CONFIG_USE_LIBEV, which use their own timer sources.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif /* CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL */
+
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL && (CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV)
+#error "CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL cannot be used together with CHIP_SYSTEM_CONFIG_USE_DISPATCH or CHIP_SYSTEM_CONFIG_USE_LIBEV"
+#endif
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
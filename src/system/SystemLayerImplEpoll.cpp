@@ -0,0 +1,548 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using epoll(7) and timerfd.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+    for (auto & w : mSocketWatchPool)
+    {
+        w.Clear();
+        w.mGeneration = 0;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    mEpollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrReturnError(mEpollFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    mTimerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrReturnError(mTimerFd >= 0, CHIP_ERROR_POSIX(errno));
+    mTimerFdArmed = false;
+
+    // The timerfd is the only registration whose data is zero; socket watches use EpollDataFor().
+    epoll_event event = {};
+    event.events      = EPOLLIN;
+    event.data.u64    = 0;
+    VerifyOrReturnError(::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the epoll loop.
+    ReturnErrorOnFailure(mWakeEvent.Open(*this));
+
+    VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    if (mTimerFd >= 0)
+    {
+        VerifyOrDie(::close(mTimerFd) == 0);
+        mTimerFd = -1;
+    }
+    if (mEpollFd >= 0)
+    {
+        VerifyOrDie(::close(mEpollFd) == 0);
+        mEpollFd = -1;
+    }
+    mTimerFdArmed = false;
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread by notifying the wake event.
+     *
+     * If this is being called from within an I/O event callback, then the notification can be skipped,
+     * since the I/O thread is already awake.
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleEventsThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        for (TimerList::Node * timer = mExpiredTimers.Earliest(); timer != nullptr; timer = timer->mNextTimer)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState)
+            {
+                return true;
+            }
+        }
+    }
+
+    return timerIsActive;
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerQueue::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer was not in our "will fire in the future" list, but it might
+        // be in the "we're about to fire these" chunk we already grabbed from
+        // that list.  Check for it there too, and if found there we still want
+        // to cancel it.
+        // Everything in that chunk came from mTimerList, so it is a TimerQueue::Node.
+        timer = static_cast<TimerQueue::Node *>(mExpiredTimers.Remove(onComplete, appState));
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(timer);
+    Signal();
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // As in LayerImplSelect, use an expires-ASAP timer as a closure capturing `this`, onComplete and appState,
+    // and do not cancel existing timers with the same callback so ScheduleWork invocations don't stomp on each other.
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    // Find a free slot.
+    SocketWatch * watch = nullptr;
+    for (auto & w : mSocketWatchPool)
+    {
+        if (w.mFD == fd)
+        {
+            // Duplicate registration is an error.
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        if ((w.mFD == kInvalidFd) && (watch == nullptr))
+        {
+            watch = &w;
+        }
+    }
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+
+    // The descriptor is added to the epoll set lazily, once a callback on read or write is requested.
+    watch->mFD = fd;
+    watch->mGeneration++;
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kRead);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kWrite);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kRead);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kWrite);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (watch->mRegisteredEvents != 0)
+    {
+        // The descriptor may already have been closed, in which case the kernel has dropped it from the
+        // epoll set on its own; failure here is therefore not an error.
+        (void) ::epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watch->mFD, nullptr);
+    }
+    watch->Clear();
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ *  Bring the kernel's interest list for the watched descriptor in line with its pending I/O flags.
+ *
+ *  The descriptor is removed from the epoll set when no events are requested, rather than registered
+ *  with an empty mask, because epoll always reports EPOLLERR and EPOLLHUP and the loop would otherwise
+ *  spin on a descriptor nobody is interested in.
+ */
+CHIP_ERROR LayerImplEpoll::UpdateEpollRegistration(SocketWatch & watch)
+{
+    VerifyOrReturnError(watch.mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    uint32_t events = 0;
+    if (watch.mPendingIO.Has(SocketEventFlags::kRead))
+    {
+        events |= EPOLLIN;
+    }
+    if (watch.mPendingIO.Has(SocketEventFlags::kWrite))
+    {
+        events |= EPOLLOUT;
+    }
+
+    VerifyOrReturnError(events != watch.mRegisteredEvents, CHIP_NO_ERROR);
+
+    int op;
+    if (events == 0)
+    {
+        op = EPOLL_CTL_DEL;
+    }
+    else if (watch.mRegisteredEvents == 0)
+    {
+        op = EPOLL_CTL_ADD;
+    }
+    else
+    {
+        op = EPOLL_CTL_MOD;
+    }
+
+    epoll_event event = {};
+    event.events      = events;
+    event.data.u64    = EpollDataFor(watch);
+    VerifyOrReturnError(::epoll_ctl(mEpollFd, op, watch.mFD, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    watch.mRegisteredEvents = events;
+    return CHIP_NO_ERROR;
+}
+
+uint64_t LayerImplEpoll::EpollDataFor(const SocketWatch & watch) const
+{
+    const uint64_t slot = static_cast<uint64_t>(&watch - mSocketWatchPool) + 1;
+    return (slot << 32) | watch.mGeneration;
+}
+
+/**
+ *  Find the socket watch an epoll event was registered for, or nullptr for the timerfd or if the watch has
+ *  since been stopped, and possibly its slot reused for another descriptor, e.g. by a timer callback or
+ *  a socket callback run earlier in the same pass.
+ */
+LayerImplEpoll::SocketWatch * LayerImplEpoll::WatchFromEpollData(uint64_t data)
+{
+    const uint64_t slot = data >> 32;
+    VerifyOrReturnValue(slot != 0 && slot <= static_cast<uint64_t>(kSocketWatchMax), nullptr);
+
+    SocketWatch & watch = mSocketWatchPool[slot - 1];
+    VerifyOrReturnValue(watch.mFD != kInvalidFd && watch.mGeneration == static_cast<uint32_t>(data), nullptr);
+    return &watch;
+}
+
+/**
+ *  Translate epoll events for a watched descriptor into the socket event flags its callback expects.
+ *
+ *  Error and hang-up conditions are reported as readiness for whichever of read or write is requested,
+ *  mirroring select(), which marks such descriptors readable and writable so the owner observes the
+ *  error on its next I/O call.
+ */
+SocketEvents LayerImplEpoll::SocketEventsFromEpoll(const SocketWatch & watch, uint32_t events)
+{
+    SocketEvents res;
+    const bool failed = (events & (EPOLLERR | EPOLLHUP)) != 0;
+
+    if (watch.mPendingIO.Has(SocketEventFlags::kRead) && (failed || (events & EPOLLIN)))
+    {
+        res.Set(SocketEventFlags::kRead);
+    }
+    if (watch.mPendingIO.Has(SocketEventFlags::kWrite) && (failed || (events & EPOLLOUT)))
+    {
+        res.Set(SocketEventFlags::kWrite);
+    }
+
+    return res;
+}
+
+void LayerImplEpoll::ArmTimerFd(Clock::Timestamp awakenTime, Clock::Timestamp currentTime)
+{
+    // The timerfd is armed with a relative value computed from SystemClock(), so that the layer keeps
+    // working when the system clock is replaced (e.g. by a mock clock in tests).
+    Clock::Microseconds64 delay(0);
+    if (awakenTime > currentTime)
+    {
+        delay = awakenTime - currentTime;
+    }
+
+    itimerspec spec = {};
+    // An all-zero it_value disarms the timer, so an overdue timer is armed to fire after a single nanosecond.
+    spec.it_value.tv_sec  = static_cast<time_t>(delay.count() / 1000000);
+    spec.it_value.tv_nsec = static_cast<long>((delay.count() % 1000000) * 1000);
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+    {
+        spec.it_value.tv_nsec = 1;
+    }
+
+    if (::timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        mTimerFdArmed = false;
+        return;
+    }
+
+    mTimerFdAwakenTime = awakenTime;
+    mTimerFdArmed      = true;
+}
+
+void LayerImplEpoll::DisarmTimerFd()
+{
+    itimerspec spec = {};
+    (void) ::timerfd_settime(mTimerFd, 0, &spec, nullptr);
+    mTimerFdArmed = false;
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    // Socket interest is maintained incrementally by the watch methods, so only the timer needs attention here,
+    // and only when the earliest deadline differs from the one the timerfd is already armed for.
+    TimerQueue::Node * timer = mTimerList.Earliest();
+    if (timer == nullptr)
+    {
+        if (mTimerFdArmed)
+        {
+            DisarmTimerFd();
+        }
+        return;
+    }
+
+    if (!mTimerFdArmed || timer->AwakenTime() != mTimerFdAwakenTime)
+    {
+        ArmTimerFd(timer->AwakenTime(), SystemClock().GetMonotonicTimestamp());
+    }
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    mEpollResult = ::epoll_wait(mEpollFd, mEpollEvents, kEpollEventsMax, -1);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsSelectResultValid())
+    {
+        // EINTR is expected when a signal is delivered to the event loop thread.
+        if (errno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        }
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    const Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+
+    // Once the deadline the timerfd was armed for has passed it has fired (or is about to), so it must be
+    // re-armed by the next PrepareEvents() even if the earliest timer happens to have the same awaken time.
+    if (mTimerFdArmed && mTimerFdAwakenTime <= currentTime)
+    {
+        mTimerFdArmed = false;
+    }
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + currentTime);
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(static_cast<TimerQueue::Node *>(timer));
+    }
+
+    for (int i = 0; i < mEpollResult; i++)
+    {
+        if (mEpollEvents[i].data.u64 == 0)
+        {
+            // timerfd: consume the expiration count so the descriptor stops reporting readable.
+            uint64_t expirations;
+            (void) ::read(mTimerFd, &expirations, sizeof(expirations));
+            continue;
+        }
+
+        // The timers run above, or a callback run earlier in this pass, may have stopped watching this socket, and even
+        // reused its watch for another one, or changed its interest.
+        SocketWatch * watch = WatchFromEpollData(mEpollEvents[i].data.u64);
+        if (watch == nullptr || watch->mCallback == nullptr)
+        {
+            continue;
+        }
+
+        SocketEvents events = SocketEventsFromEpoll(*watch, mEpollEvents[i].events);
+        if (events.HasAny())
+        {
+            watch->mCallback(events, watch->mCallbackData);
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+void LayerImplEpoll::SocketWatch::Clear()
+{
+    mFD = kInvalidFd;
+    mPendingIO.ClearAll();
+    mRegisteredEvents = 0;
+    mCallback         = nullptr;
+    mCallbackData     = 0;
+}
+
+} // namespace System
+} // namespace chip
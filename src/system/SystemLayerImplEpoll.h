@@ -0,0 +1,150 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an implementation of System::Layer using Linux epoll(7) and timerfd.
+ *
+ *      Unlike LayerImplSelect, socket watches are registered with the kernel once and only
+ *      re-registered when the requested events change, so the cost of each loop iteration
+ *      depends on the number of ready descriptors rather than the number of watched ones,
+ *      and descriptors are not limited by FD_SETSIZE.
+ */
+
+#pragma once
+
+#include "system/SystemConfig.h"
+
+#if CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV
+#error "LayerImplEpoll cannot be used together with CHIP_SYSTEM_CONFIG_USE_DISPATCH or CHIP_SYSTEM_CONFIG_USE_LIBEV"
+#endif
+
+#include <sys/epoll.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <lib/support/ObjectLifeCycle.h>
+#include <system/SystemLayer.h>
+#include <system/SystemTimer.h>
+#include <system/WakeEvent.h>
+
+namespace chip {
+namespace System {
+
+class LayerImplEpoll : public LayerSocketsLoop
+{
+public:
+    LayerImplEpoll() = default;
+    ~LayerImplEpoll() override { VerifyOrDie(mLayerState.Destroy()); }
+
+    // Layer overrides.
+    CHIP_ERROR Init() override;
+    void Shutdown() override;
+    bool IsInitialized() const override { return mLayerState.IsInitialized(); }
+    CHIP_ERROR StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    bool IsTimerActive(TimerCompleteCallback onComplete, void * appState) override;
+    void CancelTimer(TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ScheduleWork(TimerCompleteCallback onComplete, void * appState) override;
+
+    // LayerSocket overrides.
+    CHIP_ERROR StartWatchingSocket(int fd, SocketWatchToken * tokenOut) override;
+    CHIP_ERROR SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data) override;
+    CHIP_ERROR RequestCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR RequestCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR StopWatchingSocket(SocketWatchToken * tokenInOut) override;
+    SocketWatchToken InvalidSocketWatchToken() override { return reinterpret_cast<SocketWatchToken>(nullptr); }
+
+    // LayerSocketLoop overrides.
+    void Signal() override;
+    void EventLoopBegins() override {}
+    void PrepareEvents() override;
+    void WaitForEvents() override;
+    void HandleEvents() override;
+    void EventLoopEnds() override {}
+
+    // Expose the result of WaitForEvents() for non-blocking socket implementations.
+    // Named after the LayerImplSelect equivalent so the two implementations are interchangeable.
+    bool IsSelectResultValid() const { return mEpollResult >= 0; }
+
+protected:
+    static constexpr int kSocketWatchMax = (INET_CONFIG_ENABLE_TCP_ENDPOINT ? INET_CONFIG_NUM_TCP_ENDPOINTS : 0) +
+        (INET_CONFIG_ENABLE_UDP_ENDPOINT ? INET_CONFIG_NUM_UDP_ENDPOINTS : 0);
+
+    // One slot per socket watch, plus the timerfd.
+    static constexpr int kEpollEventsMax = kSocketWatchMax + 1;
+
+    struct SocketWatch
+    {
+        void Clear();
+        int mFD;
+        SocketEvents mPendingIO;
+        // Events currently registered with the kernel for mFD; zero means mFD is not in the epoll set.
+        uint32_t mRegisteredEvents;
+        SocketWatchCallback mCallback;
+        intptr_t mCallbackData;
+        // Incremented each time the slot starts watching a descriptor and kept across Clear(), so that events
+        // reported for an earlier use of the slot can be told apart.
+        uint32_t mGeneration;
+    };
+    SocketWatch mSocketWatchPool[kSocketWatchMax];
+
+    CHIP_ERROR UpdateEpollRegistration(SocketWatch & watch);
+    // epoll_event.data of a socket watch: its slot index plus one in the upper half, so that zero identifies the
+    // timerfd, and its generation in the lower half.
+    uint64_t EpollDataFor(const SocketWatch & watch) const;
+    SocketWatch * WatchFromEpollData(uint64_t data);
+    static SocketEvents SocketEventsFromEpoll(const SocketWatch & watch, uint32_t events);
+
+    void ArmTimerFd(Clock::Timestamp awakenTime, Clock::Timestamp currentTime);
+    void DisarmTimerFd();
+
+    TimerPool<TimerQueue::Node> mTimerPool;
+    TimerQueue mTimerList;
+    // List of expired timers being processed right now.  Stored in a member so
+    // we can cancel them.
+    TimerList mExpiredTimers;
+
+    int mEpollFd = -1;
+    int mTimerFd = -1;
+
+    // Awaken time the timerfd is currently armed for; only meaningful if mTimerFdArmed is true.
+    Clock::Timestamp mTimerFdAwakenTime;
+    bool mTimerFdArmed = false;
+
+    epoll_event mEpollEvents[kEpollEventsMax];
+
+    // Return value from epoll_wait(), carried between WaitForEvents() and HandleEvents().
+    int mEpollResult;
+
+    ObjectLifeCycle mLayerState;
+    WakeEvent mWakeEvent;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    std::atomic<pthread_t> mHandleEventsThread;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+};
+
+using LayerImpl = LayerImplEpoll;
+
+} // namespace System
+} // namespace chip
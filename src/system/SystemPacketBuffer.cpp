@@ -162,6 +162,7 @@ void PacketBufferHandle::InternalRightSize()
     newBuffer->ref           = 1;
     newBuffer->alloc_size    = static_cast<uint16_t>(usedSize);
     memcpy(newStart, start, usedSize);
+    SYSTEM_STATS_PACKET_BUFFER_ALLOCATED(blockSize);
 
     PacketBuffer::Free(mBuffer);
     mBuffer = newBuffer;
@@ -546,6 +547,9 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     lPacket->ref                    = 1;
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
     lPacket->alloc_size = static_cast<uint16_t>(lAllocSize);
+    SYSTEM_STATS_PACKET_BUFFER_ALLOCATED(lBlockSize);
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
+    SYSTEM_STATS_PACKET_BUFFER_ALLOCATED(PacketBuffer::kBlockSize);
 #endif
 
     return PacketBufferHandle(lPacket);
@@ -605,7 +609,10 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
         {
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+            SYSTEM_STATS_PACKET_BUFFER_FREED(aPacket->alloc_size + kStructureSize);
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+#else
+            SYSTEM_STATS_PACKET_BUFFER_FREED(kBlockSize);
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
@@ -705,6 +712,7 @@ PacketBufferHandle PacketBufferHandle::CloneData() const
         }
         clone.mBuffer->tot_len = clone.mBuffer->len = original->len;
         memcpy(clone->ReserveStart(), original->ReserveStart(), originalDataSize + originalReservedSize);
+        SYSTEM_STATS_PACKET_BUFFER_CLONED(originalDataSize + originalReservedSize);
 
         if (cloneHead.IsNull())
         {
@@ -44,6 +44,7 @@
 #include <lwip/stats.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace chip {
@@ -97,6 +98,21 @@ void UpdateLwipPbufCounts(void);
 typedef const char * Label;
 const Label * GetStrings();
 
+/**
+ * Packet buffer memory usage. Unlike the number of packet buffers, this accounts for buffers allocated from the CHIP heap
+ * differing in size. Clones are the copies made by PacketBufferHandle::CloneData(), which sharing a buffer through
+ * PacketBufferHandle::Retain() avoids. With LwIP, which frees packet buffers itself, only clones are counted.
+ */
+struct PacketBufferUsage
+{
+    size_t mBytesInUse;
+    size_t mBytesHighWatermark;
+    size_t mClones;
+    size_t mClonedBytes;
+};
+
+PacketBufferUsage & GetPacketBufferUsage();
+
 } // namespace Stats
 } // namespace System
 } // namespace chip
@@ -141,6 +157,30 @@ const Label * GetStrings();
         chip::System::Stats::GetResourcesInUse()[entry] = 0;                                                                       \
     } while (0)
 
+#define SYSTEM_STATS_PACKET_BUFFER_ALLOCATED(bytes)                                                                                \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        chip::System::Stats::PacketBufferUsage & usage = chip::System::Stats::GetPacketBufferUsage();                              \
+        usage.mBytesInUse += (bytes);                                                                                              \
+        if (usage.mBytesHighWatermark < usage.mBytesInUse)                                                                         \
+        {                                                                                                                          \
+            usage.mBytesHighWatermark = usage.mBytesInUse;                                                                         \
+        }                                                                                                                          \
+    } while (0)
+
+#define SYSTEM_STATS_PACKET_BUFFER_FREED(bytes)                                                                                    \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        chip::System::Stats::GetPacketBufferUsage().mBytesInUse -= (bytes);                                                        \
+    } while (0)
+
+#define SYSTEM_STATS_PACKET_BUFFER_CLONED(bytes)                                                                                   \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        chip::System::Stats::GetPacketBufferUsage().mClones++;                                                                     \
+        chip::System::Stats::GetPacketBufferUsage().mClonedBytes += (bytes);                                                       \
+    } while (0)
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()                                                                                     \
     do                                                                                                                             \
@@ -172,6 +212,12 @@ const Label * GetStrings();
 
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
 
+#define SYSTEM_STATS_PACKET_BUFFER_ALLOCATED(bytes)
+
+#define SYSTEM_STATS_PACKET_BUFFER_FREED(bytes)
+
+#define SYSTEM_STATS_PACKET_BUFFER_CLONED(bytes)
+
 #define SYSTEM_STATS_TEST_IN_USE(entry, expected) (true)
 #define SYSTEM_STATS_TEST_HIGH_WATER_MARK(entry, expected) (true)
 #define SYSTEM_STATS_RESET_HIGH_WATER_MARK_FOR_TESTING(entry)
@@ -27,6 +27,7 @@
 #include <system/SystemTimer.h>
 
 // Include local headers
+#include <algorithm>
 #include <string.h>
 
 #include <system/SystemError.h>
@@ -178,5 +179,299 @@ Clock::Timeout TimerList::GetRemainingTime(TimerCompleteCallback aOnComplete, vo
     return Clock::kZero;
 }
 
+namespace {
+
+unsigned LowestSetBit(uint64_t bits)
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+    unsigned index = 0;
+    while ((bits & 1) == 0)
+    {
+        bits >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+} // namespace
+
+size_t TimerWheel::IndexBucket(TimerCompleteCallback onComplete, void * appState)
+{
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(onComplete)) * 0x9E3779B97F4A7C15ull;
+    hash ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(appState));
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 32;
+    return static_cast<size_t>(hash) & (kIndexBuckets - 1);
+}
+
+void TimerWheel::Link(Node * timer)
+{
+    // Timers that are already due are filed at the base time, which keeps every key at or after mBase.
+    const uint64_t key = std::max<uint64_t>(timer->AwakenTime().count(), mBase);
+
+    uint8_t level = 0;
+    for (uint64_t diff = key ^ mBase; diff >= kSlots; diff >>= kSlotBits)
+    {
+        level++;
+    }
+    const uint8_t slot = static_cast<uint8_t>((key >> (level * kSlotBits)) & (kSlots - 1));
+
+    Node *& head      = mSlots[level][slot];
+    timer->mNextTimer = nullptr;
+    if (head == nullptr)
+    {
+        head               = timer;
+        timer->mPrevInSlot = timer;
+        mOccupied[level] |= (1ull << slot);
+    }
+    else
+    {
+        Node * tail        = head->mPrevInSlot;
+        tail->mNextTimer   = timer;
+        timer->mPrevInSlot = tail;
+        head->mPrevInSlot  = timer;
+    }
+    timer->mLevel = level;
+    timer->mSlot  = slot;
+}
+
+void TimerWheel::Unlink(Node * timer)
+{
+    Node *& head = mSlots[timer->mLevel][timer->mSlot];
+    Node * next  = static_cast<Node *>(timer->mNextTimer);
+
+    if (timer == head)
+    {
+        head = next;
+        if (next != nullptr)
+        {
+            next->mPrevInSlot = timer->mPrevInSlot;
+        }
+        else
+        {
+            mOccupied[timer->mLevel] &= ~(1ull << timer->mSlot);
+        }
+    }
+    else
+    {
+        Node * prev      = timer->mPrevInSlot;
+        prev->mNextTimer = next;
+        if (next != nullptr)
+        {
+            next->mPrevInSlot = prev;
+        }
+        else
+        {
+            head->mPrevInSlot = prev;
+        }
+    }
+
+    timer->mNextTimer  = nullptr;
+    timer->mPrevInSlot = nullptr;
+    timer->mLevel      = Node::kNotInWheel;
+}
+
+void TimerWheel::RemoveFromIndex(Node * timer)
+{
+    const TimerData::Callback & callback = timer->GetCallback();
+    for (Node ** link = &mIndex[IndexBucket(callback.GetOnComplete(), callback.GetAppState())]; *link != nullptr;
+         link         = &(*link)->mNextInIndex)
+    {
+        if (*link == timer)
+        {
+            *link               = timer->mNextInIndex;
+            timer->mNextInIndex = nullptr;
+            return;
+        }
+    }
+}
+
+TimerWheel::Node * TimerWheel::FindInIndex(TimerCompleteCallback onComplete, void * appState) const
+{
+    // Index chains are newest first, so on equal expiration times the last match found is the one added first,
+    // which is the one TimerList would find.
+    Node * found = nullptr;
+    for (Node * timer = mIndex[IndexBucket(onComplete, appState)]; timer != nullptr; timer = timer->mNextInIndex)
+    {
+        if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState &&
+            (found == nullptr || timer->AwakenTime() <= found->AwakenTime()))
+        {
+            found = timer;
+        }
+    }
+    return found;
+}
+
+TimerWheel::Node * TimerWheel::FindEarliest() const
+{
+    for (unsigned level = 0; level < kLevels; level++)
+    {
+        if (mOccupied[level] == 0)
+        {
+            continue;
+        }
+
+        // Every timer in a lower level, or a lower slot of this level, expires earlier than any timer in a higher one,
+        // so the earliest timer is in this slot. Scan it, keeping the first of equal times.
+        Node * earliest = mSlots[level][LowestSetBit(mOccupied[level])];
+        for (Node * timer = static_cast<Node *>(earliest->mNextTimer); timer != nullptr;
+             timer        = static_cast<Node *>(timer->mNextTimer))
+        {
+            if (timer->AwakenTime() < earliest->AwakenTime())
+            {
+                earliest = timer;
+            }
+        }
+        return earliest;
+    }
+    return nullptr;
+}
+
+TimerWheel::Node * TimerWheel::PopEarliestAndAdvance()
+{
+    Node * earliest = mEarliestTimer;
+    Unlink(earliest);
+    RemoveFromIndex(earliest);
+
+    const uint64_t newBase = earliest->AwakenTime().count();
+    if (newBase > mBase)
+    {
+        mBase = newBase;
+
+        // The slot the new base time falls into at each higher level now holds timers whose level relative to the
+        // base is lower; move them down, preserving their order.
+        for (unsigned level = 1; level < kLevels; level++)
+        {
+            const unsigned slot = static_cast<unsigned>((mBase >> (level * kSlotBits)) & (kSlots - 1));
+            Node * timer        = mSlots[level][slot];
+            if (timer == nullptr)
+            {
+                continue;
+            }
+            mSlots[level][slot] = nullptr;
+            mOccupied[level] &= ~(1ull << slot);
+            while (timer != nullptr)
+            {
+                Node * next = static_cast<Node *>(timer->mNextTimer);
+                Link(timer);
+                timer = next;
+            }
+        }
+    }
+
+    mEarliestTimer = FindEarliest();
+    return earliest;
+}
+
+TimerWheel::Node * TimerWheel::Add(Node * add)
+{
+    VerifyOrDie(add->mLevel == Node::kNotInWheel);
+
+    Link(add);
+
+    const TimerData::Callback & callback = add->GetCallback();
+    Node *& bucket                       = mIndex[IndexBucket(callback.GetOnComplete(), callback.GetAppState())];
+    add->mNextInIndex                    = bucket;
+    bucket                               = add;
+
+    if (mEarliestTimer == nullptr || (add->AwakenTime() < mEarliestTimer->AwakenTime()))
+    {
+        mEarliestTimer = add;
+    }
+    return mEarliestTimer;
+}
+
+TimerWheel::Node * TimerWheel::Remove(Node * remove)
+{
+    if (remove != nullptr && remove->mLevel != Node::kNotInWheel)
+    {
+        Unlink(remove);
+        RemoveFromIndex(remove);
+        if (remove == mEarliestTimer)
+        {
+            mEarliestTimer = FindEarliest();
+        }
+    }
+    return mEarliestTimer;
+}
+
+TimerWheel::Node * TimerWheel::Remove(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = FindInIndex(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Remove(timer);
+    }
+    return timer;
+}
+
+TimerWheel::Node * TimerWheel::PopEarliest()
+{
+    if (mEarliestTimer == nullptr)
+    {
+        return nullptr;
+    }
+    return PopEarliestAndAdvance();
+}
+
+TimerWheel::Node * TimerWheel::PopIfEarlier(Clock::Timestamp t)
+{
+    if ((mEarliestTimer == nullptr) || !(mEarliestTimer->AwakenTime() < t))
+    {
+        return nullptr;
+    }
+    return PopEarliestAndAdvance();
+}
+
+TimerList TimerWheel::ExtractEarlier(Clock::Timestamp t)
+{
+    TimerList out;
+    TimerList::Node * end = nullptr;
+
+    while ((mEarliestTimer != nullptr) && (mEarliestTimer->AwakenTime() < t))
+    {
+        Node * timer = PopEarliestAndAdvance();
+        if (end == nullptr)
+        {
+            out.mEarliestTimer = timer;
+        }
+        else
+        {
+            end->mNextTimer = timer;
+        }
+        end = timer;
+    }
+
+    return out;
+}
+
+void TimerWheel::Clear()
+{
+    memset(mSlots, 0, sizeof(mSlots));
+    memset(mOccupied, 0, sizeof(mOccupied));
+    memset(mIndex, 0, sizeof(mIndex));
+    mBase          = 0;
+    mEarliestTimer = nullptr;
+}
+
+Clock::Timeout TimerWheel::GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = FindInIndex(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+
+        if (currentTime < timer->AwakenTime())
+        {
+            return Clock::Timeout(timer->AwakenTime() - currentTime);
+        }
+    }
+    return Clock::kZero;
+}
+
 } // namespace System
 } // namespace chip
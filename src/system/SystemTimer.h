@@ -187,9 +187,145 @@ public:
     Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
 
 private:
+    friend class TimerWheel;
     Node * mEarliestTimer;
 };
 
+/**
+ * Hierarchical timing wheel of `Timer`s, offering the same operations as TimerList.
+ *
+ * Timers are filed by absolute expiration time into kLevels levels of kSlots slots each. A timer lives at the
+ * level of the highest kSlotBits-wide digit in which its expiration time differs from the wheel's base time,
+ * which is the expiration time of the last timer popped. As the base time advances, timers in the slot that it
+ * enters at each higher level are moved down, so the earliest timer is always in the lowest occupied slot of the
+ * lowest occupied level. Adding and cancelling are constant time regardless of the number of timers, which makes
+ * this preferable to TimerList when many timers are pending at once.
+ *
+ * Timers are also indexed by callback and application state, so that Remove() and GetRemainingTime() by those
+ * properties do not scan every pending timer.
+ */
+class TimerWheel
+{
+public:
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr unsigned kSlots    = 1u << kSlotBits;
+    static constexpr unsigned kLevels   = (64 + kSlotBits - 1) / kSlotBits;
+
+    class Node : public TimerList::Node
+    {
+    public:
+        Node(Layer & systemLayer, System::Clock::Timestamp awakenTime, TimerCompleteCallback onComplete, void * appState) :
+            TimerList::Node(systemLayer, awakenTime, onComplete, appState)
+        {}
+
+    private:
+        friend class TimerWheel;
+        static constexpr uint8_t kNotInWheel = UINT8_MAX;
+
+        // Slot chains are linked through mNextTimer; the head's mPrevInSlot points at the tail.
+        Node * mPrevInSlot  = nullptr;
+        Node * mNextInIndex = nullptr;
+        uint8_t mLevel      = kNotInWheel;
+        uint8_t mSlot       = 0;
+    };
+
+    TimerWheel() { Clear(); }
+
+    /**
+     * Add a timer to the wheel.
+     *
+     * @return  The new earliest timer in the wheel. If this is the newly added timer, that implies it is earlier
+     *          than any existing timer.
+     */
+    Node * Add(Node * timer);
+
+    /**
+     * Remove the given timer from the wheel, if present. It is not an error for the timer not to be present.
+     *
+     * @return  The new earliest timer in the wheel, or nullptr if the wheel is empty.
+     */
+    Node * Remove(Node * remove);
+
+    /**
+     * Remove the earliest timer with the given properties, if present. It is not an error for no such timer to be present.
+     *
+     * @return  The removed timer, or nullptr if the wheel contains no matching timer.
+     */
+    Node * Remove(TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Remove and return the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if the wheel is empty.
+     */
+    Node * PopEarliest();
+
+    /**
+     * Remove and return the earliest timer in the wheel, provided it expires earlier than the given time @a t.
+     *
+     * @return  The earliest timer expiring before @a t, or nullptr if there is no such timer.
+     */
+    Node * PopIfEarlier(Clock::Timestamp t);
+
+    /**
+     * Get the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if there are no timers.
+     */
+    Node * Earliest() const { return mEarliestTimer; }
+
+    /**
+     * Test whether there are any timers.
+     */
+    bool Empty() const { return mEarliestTimer == nullptr; }
+
+    /**
+     * Remove and return all timers that expire before the given time @a t, in expiration order.
+     */
+    TimerList ExtractEarlier(Clock::Timestamp t);
+
+    /**
+     * Remove all timers.
+     */
+    void Clear();
+
+    /**
+     * Find the timer with the given properties, if present, and return its remaining time
+     *
+     * @return The remaining time on this particular timer or 0 if not found.
+     */
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
+
+private:
+    // Number of buckets in the (onComplete, appState) index; must be a power of two.
+    static constexpr size_t kIndexBuckets = 256;
+    static_assert((kIndexBuckets & (kIndexBuckets - 1)) == 0, "kIndexBuckets must be a power of two");
+
+    static size_t IndexBucket(TimerCompleteCallback onComplete, void * appState);
+
+    void Link(Node * timer);
+    void Unlink(Node * timer);
+    void RemoveFromIndex(Node * timer);
+    Node * FindInIndex(TimerCompleteCallback onComplete, void * appState) const;
+    Node * FindEarliest() const;
+    Node * PopEarliestAndAdvance();
+
+    Node * mSlots[kLevels][kSlots];
+    uint64_t mOccupied[kLevels];
+    Node * mIndex[kIndexBuckets];
+    uint64_t mBase;
+    Node * mEarliestTimer;
+};
+
+/**
+ * Timer queue used by the sockets-based System::Layer implementations.
+ */
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+using TimerQueue = TimerWheel;
+#else
+using TimerQueue = TimerList;
+#endif
+
 /**
  * ObjectPool wrapper that keeps System Timer statistics.
  */
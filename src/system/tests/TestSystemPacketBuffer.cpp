@@ -40,6 +40,7 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -132,6 +133,7 @@ public:
     static void CheckHandleAdvance(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleRightSize(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
+    static void CheckPacketBufferUsage(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
 
@@ -1934,6 +1936,38 @@ void PacketBufferTest::CheckHandleCloneData(nlTestSuite * inSuite, void * inCont
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 }
 
+void PacketBufferTest::CheckPacketBufferUsage(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    chip::System::Stats::PacketBufferUsage & usage = chip::System::Stats::GetPacketBufferUsage();
+    const size_t bytesInUse                        = usage.mBytesInUse;
+    const size_t clones                            = usage.mClones;
+
+    PacketBufferHandle original = PacketBufferHandle::New(32);
+    NL_TEST_ASSERT(inSuite, !original.IsNull());
+    original->SetDataLength(10);
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+    NL_TEST_ASSERT(inSuite, usage.mBytesInUse != bytesInUse);
+    NL_TEST_ASSERT(inSuite, usage.mBytesHighWatermark >= usage.mBytesInUse);
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+
+    // Sharing the buffer does not copy it.
+    PacketBufferHandle shared = original.Retain();
+    NL_TEST_ASSERT(inSuite, usage.mClones == clones);
+
+    PacketBufferHandle clone = original.CloneData();
+    NL_TEST_ASSERT(inSuite, !clone.IsNull());
+    NL_TEST_ASSERT(inSuite, usage.mClones == clones + 1);
+
+    original = nullptr;
+    shared   = nullptr;
+    clone    = nullptr;
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+    NL_TEST_ASSERT(inSuite, usage.mBytesInUse == bytesInUse);
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+
 void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext)
 {
     struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
@@ -2002,6 +2036,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleAdvance",          PacketBufferTest::CheckHandleAdvance),
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
+    NL_TEST_DEF("PacketBuffer::PacketBufferUsage",      PacketBufferTest::CheckPacketBufferUsage),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
 
     NL_TEST_SENTINEL()
@@ -43,10 +43,15 @@
 #include <lwip/tcpip.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#include <algorithm>
 #include <errno.h>
 #include <stdint.h>
 #include <string.h>
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#include <unistd.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 using chip::ErrorStr;
 using namespace chip::System;
 
@@ -432,13 +437,14 @@ void Test(nlTestSuite * inSuite, void * aContext)
 } // namespace CancelTimerTest
 } // namespace
 
-// Test the implementation helper classes TimerPool, TimerList, and TimerData.
+// Test the implementation helper classes TimerPool, TimerList, TimerWheel, and TimerData.
 namespace chip {
 namespace System {
 class TestTimer
 {
 public:
     static void CheckTimerPool(nlTestSuite * inSuite, void * aContext);
+    static void CheckTimerWheel(nlTestSuite * inSuite, void * aContext);
 };
 } // namespace System
 } // namespace chip
@@ -580,6 +586,138 @@ void chip::System::TestTimer::CheckTimerPool(nlTestSuite * inSuite, void * aCont
     NL_TEST_ASSERT(suite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumTimers, 4));
 }
 
+void chip::System::TestTimer::CheckTimerWheel(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & testContext = *static_cast<TestContext *>(aContext);
+    Layer & systemLayer       = *testContext.mLayer;
+    nlTestSuite * const suite = testContext.mTestSuite;
+
+    using Timer = TimerWheel::Node;
+    struct TestState
+    {
+        static void A(Layer * layer, void * state) {}
+        static void B(Layer * layer, void * state) {}
+    };
+
+    using namespace Clock::Literals;
+    TimerPool<Timer> pool;
+
+    // The same sequence of operations as for TimerList in CheckTimerPool must give the same results.
+    int state  = 0;
+    Timer * t0 = pool.Create(systemLayer, 111_ms, TestState::A, &state);
+    Timer * t1 = pool.Create(systemLayer, 100_ms, TestState::A, &state);
+    Timer * t2 = pool.Create(systemLayer, 202_ms, TestState::B, &state);
+    Timer * t3 = pool.Create(systemLayer, 303_ms, TestState::A, &state);
+
+    TimerWheel wheel;
+    NL_TEST_ASSERT(suite, wheel.Remove(nullptr) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.Remove(nullptr, nullptr) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.PopEarliest() == nullptr);
+    NL_TEST_ASSERT(suite, wheel.PopIfEarlier(500_ms) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.Empty());
+
+    NL_TEST_ASSERT(suite, wheel.Add(t0) == t0);
+    NL_TEST_ASSERT(suite, wheel.PopIfEarlier(10_ms) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.Add(t1) == t1);
+    NL_TEST_ASSERT(suite, wheel.Add(t2) == t1);
+    NL_TEST_ASSERT(suite, wheel.Add(t3) == t1);
+    NL_TEST_ASSERT(suite, wheel.Remove(t1) == t0);
+    NL_TEST_ASSERT(suite, wheel.Remove(t1) == t0);
+    NL_TEST_ASSERT(suite, wheel.Remove(TestState::B, &state) == t2);
+    NL_TEST_ASSERT(suite, wheel.Remove(TestState::A, &state) == t0);
+    NL_TEST_ASSERT(suite, wheel.Earliest() == t3);
+    NL_TEST_ASSERT(suite, wheel.PopIfEarlier(10_ms) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.PopIfEarlier(500_ms) == t3);
+    NL_TEST_ASSERT(suite, wheel.Empty());
+
+    wheel.Add(t0);
+    wheel.Add(t1);
+    wheel.Add(t2);
+    wheel.Add(t3);
+    TimerList early = wheel.ExtractEarlier(200_ms);
+    NL_TEST_ASSERT(suite, early.PopEarliest() == t1);
+    NL_TEST_ASSERT(suite, early.PopEarliest() == t0);
+    NL_TEST_ASSERT(suite, early.PopEarliest() == nullptr);
+    NL_TEST_ASSERT(suite, wheel.PopEarliest() == t2);
+    NL_TEST_ASSERT(suite, wheel.PopEarliest() == t3);
+    NL_TEST_ASSERT(suite, wheel.Empty());
+    pool.ReleaseAll();
+
+    // Compare against TimerList over spreads of expiration times that exercise every level of the wheel,
+    // including equal times, which must come out in the order they were added.
+    constexpr size_t kCount = CHIP_SYSTEM_CONFIG_NUM_TIMERS / 2;
+    TimerPool<Timer> wheelPool;
+    TimerPool<TimerList::Node> listPool;
+    int appStates[kCount];
+    uint32_t random = 12345;
+    uint64_t now    = 1000;
+
+    for (uint64_t spread : { 1ull, 50ull, 5000ull, 10000000ull, 1ull << 40 })
+    {
+        for (int round = 0; round < 4; round++)
+        {
+            TimerList list;
+            for (auto & appState : appStates)
+            {
+                random                       = random * 1103515245 + 12345;
+                const Clock::Timestamp when  = Clock::Timestamp(now + (random >> 8) % spread);
+                TimerCompleteCallback onDone = ((random >> 4) & 1) ? TestState::A : TestState::B;
+                list.Add(listPool.Create(systemLayer, when, onDone, &appState));
+                wheel.Add(wheelPool.Create(systemLayer, when, onDone, &appState));
+            }
+
+            // Cancel a few by callback, as the layers do.
+            for (size_t i = 0; i < kCount; i += 5)
+            {
+                TimerList::Node * fromList = list.Remove(TestState::A, &appStates[i]);
+                Timer * fromWheel          = wheel.Remove(TestState::A, &appStates[i]);
+                NL_TEST_ASSERT(suite, (fromList == nullptr) == (fromWheel == nullptr));
+                if (fromList != nullptr && fromWheel != nullptr)
+                {
+                    NL_TEST_ASSERT(suite, fromList->AwakenTime() == fromWheel->AwakenTime());
+                    listPool.Release(fromList);
+                    wheelPool.Release(fromWheel);
+                }
+            }
+
+            // Drain half through ExtractEarlier and the rest one at a time.
+            const Clock::Timestamp middle = Clock::Timestamp(now + spread / 2);
+            TimerList listEarly           = list.ExtractEarlier(middle);
+            TimerList wheelEarly          = wheel.ExtractEarlier(middle);
+            for (;;)
+            {
+                TimerList::Node * fromList  = listEarly.PopEarliest();
+                TimerList::Node * fromWheel = wheelEarly.PopEarliest();
+                NL_TEST_ASSERT(suite, (fromList == nullptr) == (fromWheel == nullptr));
+                if (fromList == nullptr || fromWheel == nullptr)
+                {
+                    break;
+                }
+                NL_TEST_ASSERT(suite, fromList->AwakenTime() == fromWheel->AwakenTime());
+                NL_TEST_ASSERT(suite, fromList->GetCallback().GetAppState() == fromWheel->GetCallback().GetAppState());
+                listPool.Release(fromList);
+                wheelPool.Release(static_cast<Timer *>(fromWheel));
+            }
+            for (;;)
+            {
+                TimerList::Node * fromList = list.PopEarliest();
+                Timer * fromWheel          = wheel.PopEarliest();
+                NL_TEST_ASSERT(suite, (fromList == nullptr) == (fromWheel == nullptr));
+                if (fromList == nullptr || fromWheel == nullptr)
+                {
+                    break;
+                }
+                NL_TEST_ASSERT(suite, fromList->AwakenTime() == fromWheel->AwakenTime());
+                NL_TEST_ASSERT(suite, fromList->GetCallback().GetAppState() == fromWheel->GetCallback().GetAppState());
+                now = std::max<uint64_t>(now, fromWheel->AwakenTime().count());
+                listPool.Release(fromList);
+                wheelPool.Release(fromWheel);
+            }
+            NL_TEST_ASSERT(suite, wheel.Empty());
+        }
+    }
+}
+
 static void ExtendTimerToTest(nlTestSuite * inSuite, void * aContext)
 {
     if (!LayerEvents<LayerImpl>::HasServiceEvents())
@@ -710,6 +848,67 @@ static void IsTimerActiveTest(nlTestSuite * inSuite, void * aContext)
     Clock::Internal::SetSystemClockForTesting(savedClock);
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH
+static void TimerStopsSocketWatchTest(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & testContext  = *static_cast<TestContext *>(aContext);
+    LayerSockets & systemLayer = static_cast<LayerSockets &>(*testContext.mLayer);
+    nlTestSuite * const suite  = testContext.mTestSuite;
+
+    struct TestState
+    {
+        static void SocketA(SocketEvents events, intptr_t data) { reinterpret_cast<TestState *>(data)->mSocketACalled = true; }
+        static void SocketB(SocketEvents events, intptr_t data) { reinterpret_cast<TestState *>(data)->mSocketBCalled = true; }
+
+        // Stop watching socket A, which has an event pending, and start watching socket B, which has none.
+        static void Timer(Layer * layer, void * state)
+        {
+            TestState & self       = *static_cast<TestState *>(state);
+            LayerSockets & sockets = static_cast<LayerSockets &>(*layer);
+            sockets.StopWatchingSocket(&self.mTokenA);
+            sockets.StartWatchingSocket(self.mPipeB[0], &self.mTokenB);
+            sockets.SetCallback(self.mTokenB, SocketB, reinterpret_cast<intptr_t>(&self));
+            sockets.RequestCallbackOnPendingRead(self.mTokenB);
+            self.mTimerCalled = true;
+        }
+
+        int mPipeA[2];
+        int mPipeB[2];
+        SocketWatchToken mTokenA;
+        SocketWatchToken mTokenB;
+        bool mTimerCalled   = false;
+        bool mSocketACalled = false;
+        bool mSocketBCalled = false;
+    };
+    TestState testState;
+    NL_TEST_ASSERT(suite, pipe(testState.mPipeA) == 0);
+    NL_TEST_ASSERT(suite, pipe(testState.mPipeB) == 0);
+
+    NL_TEST_ASSERT(suite, systemLayer.StartWatchingSocket(testState.mPipeA[0], &testState.mTokenA) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(suite,
+                   systemLayer.SetCallback(testState.mTokenA, TestState::SocketA, reinterpret_cast<intptr_t>(&testState)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(suite, systemLayer.RequestCallbackOnPendingRead(testState.mTokenA) == CHIP_NO_ERROR);
+
+    // The timer and the event of socket A are handled in the same pass, the timer first. The event must not reach
+    // socket B, whichever watch it got.
+    const uint8_t byte = 0;
+    NL_TEST_ASSERT(suite, write(testState.mPipeA[1], &byte, sizeof(byte)) == static_cast<ssize_t>(sizeof(byte)));
+    NL_TEST_ASSERT(suite, systemLayer.StartTimer(Clock::kZero, TestState::Timer, &testState) == CHIP_NO_ERROR);
+    LayerEvents<LayerImpl>::ServiceEvents(systemLayer);
+
+    NL_TEST_ASSERT(suite, testState.mTimerCalled);
+    NL_TEST_ASSERT(suite, !testState.mSocketACalled);
+    NL_TEST_ASSERT(suite, !testState.mSocketBCalled);
+
+    systemLayer.StopWatchingSocket(&testState.mTokenB);
+    for (int fd : { testState.mPipeA[0], testState.mPipeA[1], testState.mPipeB[0], testState.mPipeB[1] })
+    {
+        close(fd);
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH
+
 // Test Suite
 
 /**
@@ -723,9 +922,13 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Timer::TestTimerOrder",           CheckOrder),
     NL_TEST_DEF("Timer::TestTimerCancellation",    CheckCancellation),
     NL_TEST_DEF("Timer::TestTimerPool",            chip::System::TestTimer::CheckTimerPool),
+    NL_TEST_DEF("Timer::TestTimerWheel",           chip::System::TestTimer::CheckTimerWheel),
     NL_TEST_DEF("Timer::TestCancelTimer",          CancelTimerTest::Test),
     NL_TEST_DEF("Timer::ExtendTimerTo",            ExtendTimerToTest),
     NL_TEST_DEF("Timer::TestIsTimerActive",        IsTimerActiveTest),
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH
+    NL_TEST_DEF("Timer::TestTimerStopsSocketWatch", TimerStopsSocketWatchTest),
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,162 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Microbenchmark comparing chip::System::TimerList and chip::System::TimerWheel
+ *      insert, cancel and expire throughput for increasing numbers of pending timers.
+ *
+ *      Usage: chip-system-timer-benchmark [timer-count ...]
+ */
+
+#include <system/SystemLayerImpl.h>
+#include <system/SystemTimer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace chip::System;
+
+namespace {
+
+// Expiration times are spread over this many milliseconds, and expired in steps of kExpireStepMs,
+// roughly like a device with many subscriptions and exchanges on the go.
+constexpr uint64_t kSpreadMs     = 60 * 1000;
+constexpr uint64_t kExpireStepMs = 10;
+constexpr uint64_t kStartMs      = 1000 * 1000;
+
+void OnTimer(Layer * layer, void * appState) {}
+
+struct Result
+{
+    double insertNs;
+    double cancelNs;
+    double expireNs;
+};
+
+double NanosecondsPer(std::chrono::steady_clock::time_point start, size_t count)
+{
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(count);
+}
+
+template <typename Queue>
+Result Run(Layer & layer, const std::vector<uint64_t> & awakenTimes, const std::vector<size_t> & cancelOrder)
+{
+    using Node         = typename Queue::Node;
+    const size_t count = awakenTimes.size();
+    std::vector<int> appStates(count);
+    std::vector<std::unique_ptr<Node>> nodes;
+    for (size_t i = 0; i < count; i++)
+    {
+        nodes.emplace_back(new Node(layer, Clock::Timestamp(awakenTimes[i]), OnTimer, &appStates[i]));
+    }
+
+    // Each phase runs on its own instance so that the nodes are in a fresh state.
+    std::unique_ptr<Queue> queue(new Queue());
+    Result result;
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto & node : nodes)
+    {
+        queue->Add(node.get());
+    }
+    result.insertNs = NanosecondsPer(start, count);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i : cancelOrder)
+    {
+        if (queue->Remove(OnTimer, &appStates[i]) == nullptr)
+        {
+            fprintf(stderr, "timer %zu missing\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    result.cancelNs = NanosecondsPer(start, count);
+
+    queue.reset(new Queue());
+    for (auto & node : nodes)
+    {
+        queue->Add(node.get());
+    }
+
+    size_t expired = 0;
+    start          = std::chrono::steady_clock::now();
+    for (uint64_t now = kStartMs; !queue->Empty(); now += kExpireStepMs)
+    {
+        TimerList due = queue->ExtractEarlier(Clock::Timestamp(now));
+        while (due.PopEarliest() != nullptr)
+        {
+            expired++;
+        }
+    }
+    result.expireNs = NanosecondsPer(start, count);
+
+    if (expired != count)
+    {
+        fprintf(stderr, "expired %zu of %zu timers\n", expired, count);
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 0)));
+    }
+    if (counts.empty())
+    {
+        counts = { 16, 128, 1024, 8192 };
+    }
+
+    // The nodes only record the layer; it is never initialized or used to run timers.
+    LayerImpl layer;
+    std::mt19937_64 random(0x7133);
+
+    printf("%8s  %-10s  %12s  %12s  %12s\n", "timers", "queue", "insert ns", "cancel ns", "expire ns");
+    for (size_t count : counts)
+    {
+        std::vector<uint64_t> awakenTimes(count);
+        for (auto & awakenTime : awakenTimes)
+        {
+            awakenTime = kStartMs + random() % kSpreadMs;
+        }
+        std::vector<size_t> cancelOrder(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            cancelOrder[i] = i;
+        }
+        std::shuffle(cancelOrder.begin(), cancelOrder.end(), random);
+
+        Result list  = Run<TimerList>(layer, awakenTimes, cancelOrder);
+        Result wheel = Run<TimerWheel>(layer, awakenTimes, cancelOrder);
+        printf("%8zu  %-10s  %12.1f  %12.1f  %12.1f\n", count, "TimerList", list.insertNs, list.cancelNs, list.expireNs);
+        printf("%8zu  %-10s  %12.1f  %12.1f  %12.1f\n", count, "TimerWheel", wheel.insertNs, wheel.cancelNs, wheel.expireNs);
+    }
+
+    return EXIT_SUCCESS;
+}
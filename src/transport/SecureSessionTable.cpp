@@ -52,8 +52,8 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
         }
     }
 
-    SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
-                                                   peerSessionId, fabricIndex, config);
+    SecureSession * result = CreateEntry(secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs, peerSessionId,
+                                         fabricIndex, config);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
@@ -73,7 +73,7 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     //
     if (mEntries.Allocated() < GetMaxSessionTableSize())
     {
-        allocated = mEntries.CreateObject(*this, secureSessionType, sessionId.Value());
+        allocated = CreateEntry(secureSessionType, sessionId.Value());
     }
     else
     {
@@ -216,7 +216,7 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         if (newCount < prevCount)
         {
             ChipLogProgress(SecureChannel, "Successfully evicted a session!");
-            auto * retSession = mEntries.CreateObject(*this, secureSessionType, localSessionId);
+            auto * retSession = CreateEntry(secureSessionType, localSessionId);
             VerifyOrDie(session != nullptr);
             return retSession;
         }
@@ -339,69 +339,121 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
 
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
 {
-    SecureSession * result = nullptr;
-    mEntries.ForEachActiveObject([&](auto session) {
-        if (session->GetLocalSessionId() == localSessionId)
-        {
-            result = session;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    SecureSession * result = FindInIndex(localSessionId);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
 Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
 {
-    uint16_t candidate_base = 0;
-    uint64_t candidate_mask = 0;
-    for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
+#if CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+    // Scan the bitmap one word at a time, starting with the word holding mNextSessionId. IDs below
+    // mNextSessionId in that word are masked off at first, and considered again once the scan wraps
+    // around to the same word.
+    size_t word   = mNextSessionId / 64;
+    uint64_t used = mSessionIdBitmap[word] | ((1ULL << (mNextSessionId % 64)) - 1);
+    for (size_t i = 0; i <= kSessionIdBitmapWords; i++)
     {
-        // candidate_base is the base session ID we are searching from.
-        // We have a 64-bit mask anchored at this ID and iterate over the
-        // whole session table, setting bits in the mask for in-use IDs.
-        // If we can iterate through the entire session table and have
-        // any bits clear in the mask, we have available session IDs.
-        candidate_base = static_cast<uint16_t>(i + mNextSessionId);
-        candidate_mask = 0;
+        if (word == kUnsecuredSessionId / 64)
         {
-            uint16_t shift = static_cast<uint16_t>(kUnsecuredSessionId - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift); // kUnsecuredSessionId is never available
-            }
+            used |= (1ULL << (kUnsecuredSessionId % 64)); // kUnsecuredSessionId is never available
         }
-        mEntries.ForEachActiveObject([&](auto session) {
-            uint16_t shift = static_cast<uint16_t>(session->GetLocalSessionId() - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift);
-            }
-            if (candidate_mask == UINT64_MAX)
+        if (used != UINT64_MAX)
+        {
+            uint16_t offset = 0;
+            while (used & 1)
             {
-                return Loop::Break; // No bits clear means this bucket is full.
+                used >>= 1;
+                ++offset;
             }
-            return Loop::Continue;
-        });
-        if (candidate_mask != UINT64_MAX)
-        {
-            break; // Any bit clear means we have an available ID in this bucket.
+            return MakeOptional<uint16_t>(static_cast<uint16_t>(word * 64 + offset));
         }
+        word = (word + 1) % kSessionIdBitmapWords;
+        used = mSessionIdBitmap[word];
     }
-    if (candidate_mask != UINT64_MAX)
+#else
+    // Every session in the table uses at most one ID, so this finds a free ID within
+    // mEntries.Allocated() + 1 probes (plus one for kUnsecuredSessionId).
+    uint16_t candidate = mNextSessionId;
+    for (uint32_t i = 0; i <= kMaxSessionID; i++)
     {
-        uint16_t offset = 0;
-        while (candidate_mask & 1)
+        if (candidate != kUnsecuredSessionId && FindInIndex(candidate) == nullptr)
         {
-            candidate_mask >>= 1;
-            ++offset;
+            return MakeOptional<uint16_t>(candidate);
         }
-        uint16_t available = static_cast<uint16_t>(candidate_base + offset);
-        return MakeOptional<uint16_t>(available);
+        candidate = static_cast<uint16_t>(candidate + 1);
     }
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
 
     return NullOptional;
 }
 
+SecureSession * SecureSessionTable::FindInIndex(uint16_t localSessionId) const
+{
+    // The index always keeps at least one empty slot, so every probe sequence terminates.
+    for (size_t slot = IndexSlot(localSessionId); mIndex[slot] != nullptr; slot = (slot + 1) & kIndexMask)
+    {
+        if (mIndex[slot]->GetLocalSessionId() == localSessionId)
+        {
+            return mIndex[slot];
+        }
+    }
+    return nullptr;
+}
+
+bool SecureSessionTable::AddToIndex(SecureSession * session)
+{
+    VerifyOrReturnValue(mIndexCount < kIndexSize - 1, false);
+
+    const uint16_t localSessionId = session->GetLocalSessionId();
+
+    size_t slot = IndexSlot(localSessionId);
+    while (mIndex[slot] != nullptr)
+    {
+        slot = (slot + 1) & kIndexMask;
+    }
+    mIndex[slot] = session;
+    mIndexCount++;
+
+#if CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+    mSessionIdBitmap[localSessionId / 64] |= (1ULL << (localSessionId % 64));
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
+    return true;
+}
+
+void SecureSessionTable::RemoveFromIndex(SecureSession * session)
+{
+    const uint16_t localSessionId = session->GetLocalSessionId();
+
+    size_t hole = IndexSlot(localSessionId);
+    while (mIndex[hole] != session)
+    {
+        VerifyOrReturn(mIndex[hole] != nullptr);
+        hole = (hole + 1) & kIndexMask;
+    }
+    mIndex[hole] = nullptr;
+    mIndexCount--;
+
+    // Backward-shift deletion: move each following entry of the cluster into the hole, unless
+    // its home slot lies cyclically after the hole, in which case it is already reachable.
+    for (size_t slot = (hole + 1) & kIndexMask; mIndex[slot] != nullptr; slot = (slot + 1) & kIndexMask)
+    {
+        const size_t home = IndexSlot(mIndex[slot]->GetLocalSessionId());
+        if (((slot - home) & kIndexMask) >= ((slot - hole) & kIndexMask))
+        {
+            mIndex[hole] = mIndex[slot];
+            mIndex[slot] = nullptr;
+            hole         = slot;
+        }
+    }
+
+#if CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+    if (FindInIndex(localSessionId) == nullptr)
+    {
+        mSessionIdBitmap[localSessionId / 64] &= ~(1ULL << (localSessionId % 64));
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+}
+
 } // namespace Transport
 } // namespace chip
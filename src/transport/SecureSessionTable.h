@@ -29,6 +29,12 @@ namespace Transport {
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 inline constexpr uint16_t kUnsecuredSessionId = 0;
 
+// Smallest power of two that is at least minSize.
+constexpr size_t SessionIndexSize(size_t minSize, size_t size = 1)
+{
+    return (size >= minSize) ? size : SessionIndexSize(minSize, size * 2);
+}
+
 /**
  * Handles a set of sessions.
  *
@@ -76,7 +82,11 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RemoveFromIndex(session);
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -87,6 +97,9 @@ public:
     /**
      * Get a secure session given its session ID.
      *
+     * This is a constant-time lookup in the local session ID index, and is performed for every
+     * inbound secure unicast message.
+     *
      * @param localSessionId the identifier of a secure unicast session context within the local node
      *
      * @return the session if found, NullOptional if not found
@@ -243,22 +256,62 @@ private:
     /**
      * Find an available session ID that is unused in the secure session table.
      *
-     * The search algorithm iterates over the session ID space in the outer loop
-     * and the session table in the inner loop to locate an available session ID
-     * from the starting mNextSessionId clue.
-     *
-     * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * The search starts from the mNextSessionId clue. With CHIP_CONFIG_SECURE_SESSION_ID_BITMAP,
+     * it scans the in-use bitmap 64 session IDs at a time; otherwise it probes the local session
+     * ID index once per candidate, which takes at most one probe per session in the table.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    /**
+     * Allocate a session out of mEntries and add it to the local session ID index.
+     *
+     * @return the allocated session, or nullptr if either the pool or the index is full.
+     */
+    template <typename... Args>
+    SecureSession * CreateEntry(Args &&... args)
+    {
+        SecureSession * session = mEntries.CreateObject(*this, std::forward<Args>(args)...);
+        if (session != nullptr && !AddToIndex(session))
+        {
+            mEntries.ReleaseObject(session);
+            session = nullptr;
+        }
+        return session;
+    }
+
+    /*
+     * Index of the sessions in mEntries by local session ID.
+     *
+     * This is an open-addressed hash table with linear probing. Local session IDs are handed out
+     * sequentially, so the low bits of the ID are used directly as the hash. The table has at least
+     * twice as many slots as there can be sessions, which keeps probe sequences short, and entries
+     * are removed with backward-shift deletion so that no tombstones accumulate.
+     *
+     * Test-only sessions may share a local session ID; lookups then return the first one inserted.
+     */
+    static constexpr size_t kIndexSize = SessionIndexSize(2 * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE + 1);
+    static constexpr size_t kIndexMask = kIndexSize - 1;
+
+    static size_t IndexSlot(uint16_t localSessionId) { return localSessionId & kIndexMask; }
+    SecureSession * FindInIndex(uint16_t localSessionId) const;
+    bool AddToIndex(SecureSession * session);
+    void RemoveFromIndex(SecureSession * session);
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
 
+    SecureSession * mIndex[kIndexSize] = {};
+    size_t mIndexCount                 = 0;
+
+#if CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+    // One bit per local session ID, set while a session in mEntries uses that ID.
+    static constexpr size_t kSessionIdBitmapWords = (static_cast<size_t>(kMaxSessionID) + 1) / 64;
+    uint64_t mSessionIdBitmap[kSessionIdBitmapWords] = {};
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
     size_t GetMaxSessionTableSize() const
     {
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
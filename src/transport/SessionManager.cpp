@@ -396,10 +396,9 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
                 {
                     ChipLogDetail(Inet, "Interface %s has a link local address", name);
 
+                    // UDP sends leave the data of a shared buffer as is, so every interface can send the same buffer.
                     interfaceFound             = true;
-                    PacketBufferHandle tempBuf = msgBuf.CloneData();
-                    VerifyOrReturnError(!tempBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-                    VerifyOrReturnError(!tempBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+                    PacketBufferHandle tempBuf = msgBuf.Retain();
 
                     destination = &(multicastAddress.SetInterface(interfaceId));
                     if (mTransportMgr != nullptr)
@@ -886,9 +885,26 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     ReturnOnFailure(mac.Decode(partialPacketHeader, &data[len - footerLen], footerLen, &taglen));
     VerifyOrReturn(taglen == footerLen);
 
+    // Without privacy the destination group is in the clear, so keys mapped to other groups need not be tried.
+    Optional<GroupId> clearGroupId;
+    if (!partialPacketHeader.HasPrivacyFlag())
+    {
+        PacketHeader clearHeader;
+        uint16_t clearHeaderSize = 0;
+        if (clearHeader.Decode(msg->Start(), msg->DataLength(), &clearHeaderSize) == CHIP_NO_ERROR)
+        {
+            clearGroupId = clearHeader.GetDestinationGroupId();
+        }
+    }
+
     bool decrypted = false;
     while (!decrypted && iter->Next(groupContext))
     {
+        if (clearGroupId.HasValue() && clearGroupId.Value() != groupContext.group_id)
+        {
+            continue;
+        }
+
         CryptoContext context(groupContext.keyContext);
         msgCopy = msg.CloneData();
         if (msgCopy.IsNull())
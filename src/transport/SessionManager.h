@@ -60,6 +60,10 @@ namespace chip {
  *
  *  EncryptedPacketBufferHandle is a kind of PacketBufferHandle class and used to hold a packet buffer
  *  object whose payload has already been encrypted.
+ *
+ *  The encrypted bytes are not modified once the message has been prepared, so several handles can
+ *  share the same reference counted buffer: the reliable messaging layer keeps one for retransmissions
+ *  while the transports send another, without copying the message.
  */
 class EncryptedPacketBufferHandle final : private System::PacketBufferHandle
 {
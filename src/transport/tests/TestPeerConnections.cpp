@@ -24,6 +24,7 @@
  */
 #include <lib/core/ErrorStr.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <transport/SecureSessionTable.h>
 
@@ -132,6 +133,58 @@ void TestFindByKeyId(nlTestSuite * inSuite, void * inContext)
     System::Clock::Internal::SetSystemClockForTesting(realClock);
 }
 
+void TestSessionIdAllocation(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSessionTable connections;
+    connections.Init();
+
+    Optional<SessionHandle> sessions[CHIP_CONFIG_SECURE_SESSION_POOL_SIZE];
+
+    // Fill up the table; every session gets a distinct, non-zero ID that finds it again.
+    for (auto & session : sessions)
+    {
+        session = connections.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, session.HasValue());
+
+        uint16_t localSessionId = session.Value()->AsSecureSession()->GetLocalSessionId();
+        NL_TEST_ASSERT(inSuite, localSessionId != kUnsecuredSessionId);
+
+        auto found = connections.FindSecureSessionByLocalKey(localSessionId);
+        NL_TEST_ASSERT(inSuite, found.HasValue() && found.Value() == session.Value());
+    }
+
+    // Release every other session; only the remaining ones can still be found.
+    for (size_t i = 0; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; i += 2)
+    {
+        uint16_t localSessionId = sessions[i].Value()->AsSecureSession()->GetLocalSessionId();
+        sessions[i].ClearValue();
+        NL_TEST_ASSERT(inSuite, !connections.FindSecureSessionByLocalKey(localSessionId).HasValue());
+    }
+    for (size_t i = 1; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; i += 2)
+    {
+        uint16_t localSessionId = sessions[i].Value()->AsSecureSession()->GetLocalSessionId();
+        auto found              = connections.FindSecureSessionByLocalKey(localSessionId);
+        NL_TEST_ASSERT(inSuite, found.HasValue() && found.Value() == sessions[i].Value());
+    }
+
+    // Refill the released slots; new IDs must not collide with sessions still in the table.
+    for (size_t i = 0; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; i += 2)
+    {
+        sessions[i] = connections.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessions[i].HasValue());
+    }
+    for (size_t i = 0; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; i++)
+    {
+        uint16_t localSessionId = sessions[i].Value()->AsSecureSession()->GetLocalSessionId();
+        for (size_t j = i + 1; j < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; j++)
+        {
+            NL_TEST_ASSERT(inSuite, localSessionId != sessions[j].Value()->AsSecureSession()->GetLocalSessionId());
+        }
+        auto found = connections.FindSecureSessionByLocalKey(localSessionId);
+        NL_TEST_ASSERT(inSuite, found.HasValue() && found.Value() == sessions[i].Value());
+    }
+}
+
 struct ExpiredCallInfo
 {
     int callCount                   = 0;
@@ -158,6 +211,7 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("BasicFunctionality", TestBasicFunctionality),
     NL_TEST_DEF("FindByKeyId", TestFindByKeyId),
+    NL_TEST_DEF("SessionIdAllocation", TestSessionIdAllocation),
     NL_TEST_SENTINEL()
 };
 // clang-format on